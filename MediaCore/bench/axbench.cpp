@@ -0,0 +1,371 @@
+// AXPlayerLib/MediaCore/bench/axbench.cpp
+// 流水线吞吐基准：用播放器同一套 AXDemuxer + AXDecoder + 队列，以不限速的消费端（“呈现”即取走）
+// 尽可能快地跑完一个文件，用于在合入前发现核心流水线的性能回退。
+//   第 1 轮 demux：只解复用、包直接丢弃 → 纯解复用 MB/s
+//   第 2 轮 decode：完整解复用 + 解码 → 每路解码帧率、分段延迟（读包 → 出帧 → 呈现）的分位数、
+//                   四条队列的占用直方图（每 1ms 采样）
+// 两轮结束各打印一次进程峰值 RSS；最后输出一行 RESULT key=value，便于 CI 抓取比对。
+// 用法：axbench <file> [--hash] [--no-audio] [--no-video]
+//       axbench --corpus <dir> [--hash]      按 <dir>/axbench_corpus.txt 逐个跑（见 make_corpus.sh）
+// --hash 时视频消费端对每帧可见区域做哈希（模拟一次整帧读取，并输出序列哈希用于正确性比对）。
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/resource.h>
+
+#include "AXDemuxer.h"
+#include "AXDecoder.h"
+#include "AXQueues.h"
+#include "AXStageStamp.h"
+#include "AXFrameDumpSink.h"
+
+using Clock = std::chrono::steady_clock;
+
+// 与 AXPlayer 的默认值一致：队列容量、包队列水位（15MB 按 1:7 拆给音/视频，10s）
+static constexpr size_t kPktQueueCap = 1024;
+static constexpr size_t kAudioFrameQueueCap = 64;
+static constexpr size_t kVideoFrameQueueCap = 32;
+static constexpr int64_t kBufMaxBytes = 15 * 1024 * 1024;
+static constexpr int64_t kBufMaxDurationUs = 10 * 1000000LL;
+static constexpr int kBufMinPackets = 25;
+
+struct Options {
+    bool hash{false};
+    bool audio{true};
+    bool video{true};
+};
+
+static long peakRssKb() {
+    rusage ru{};
+    getrusage(RUSAGE_SELF, &ru);
+    return ru.ru_maxrss;   // Linux / Android：KB
+}
+
+static double sinceSec(Clock::time_point t0) {
+    return std::chrono::duration<double>(Clock::now() - t0).count();
+}
+
+// 延迟样本（微秒）：跑完后排序取分位数
+class LatencySeries {
+public:
+    void add(int64_t us) { if (us >= 0) v_.push_back(us); }
+
+    size_t count() const { return v_.size(); }
+
+    // q ∈ [0,1]，单位毫秒；调用前须 finish()
+    double quantileMs(double q) const {
+        if (v_.empty()) return 0.0;
+        const size_t i = std::min(v_.size() - 1, (size_t) (q * (double) (v_.size() - 1) + 0.5));
+        return v_[i] / 1000.0;
+    }
+
+    void finish() { std::sort(v_.begin(), v_.end()); }
+
+    void print(const char *label) const {
+        std::printf("    %-18s n=%-7zu p50=%7.2fms p90=%7.2fms p99=%7.2fms max=%7.2fms\n", label, count(),
+                    quantileMs(0.5), quantileMs(0.9), quantileMs(0.99), quantileMs(1.0));
+    }
+
+private:
+    std::vector<int64_t> v_;
+};
+
+// 队列占用直方图：按容量百分比分 6 档
+class OccupancyHistogram {
+public:
+    explicit OccupancyHistogram(const char *name) : name_(name) {}
+
+    void sample(size_t size, size_t cap) {
+        int b;
+        if (size == 0) b = 0;
+        else if (size >= cap) b = 5;
+        else b = 1 + (int) std::min<size_t>(3, size * 4 / cap);
+        ++bins_[b];
+        ++total_;
+        peak_ = std::max(peak_, size);
+    }
+
+    void print() const {
+        static const char *kLabels[6] = {"empty", "<25%", "<50%", "<75%", "<100%", "full"};
+        std::printf("    %-8s peak=%-5zu", name_, peak_);
+        for (int i = 0; i < 6; ++i) {
+            std::printf(" %s=%5.1f%%", kLabels[i], total_ ? bins_[i] * 100.0 / total_ : 0.0);
+        }
+        std::printf("\n");
+    }
+
+private:
+    const char *name_;
+    int64_t bins_[6]{};
+    int64_t total_{0};
+    size_t peak_{0};
+};
+
+// ======================= 第 1 轮：纯解复用 =======================
+struct DemuxResultStats {
+    double sec{0};
+    int64_t bytes{0};
+    int64_t packets{0};
+};
+
+static void drainPackets(PacketQueue *q) {
+    AVPacket *pkt = nullptr;
+    while (q->pop(pkt)) {
+        const bool eof = pkt && pkt->data == nullptr && pkt->size == 0;
+        if (pkt) axPacketFree(&pkt);
+        if (eof) break;
+    }
+}
+
+// 队列须先于 demuxer/decoder 构造：它们析构时的 stop() 还会 abort 队列
+static bool runDemux(const std::string &path, DemuxResultStats &out) {
+    PacketQueue aQ(kPktQueueCap), vQ(kPktQueueCap);
+    AXDemuxer demux;
+    DemuxResult info;
+    if (!demux.open(path, {}, info)) return false;
+
+    const auto t0 = Clock::now();
+    demux.start(&aQ, &vQ);
+    std::thread ta, tv;
+    if (info.audioStream >= 0) ta = std::thread(drainPackets, &aQ);
+    if (info.videoStream >= 0) tv = std::thread(drainPackets, &vQ);
+    if (ta.joinable()) ta.join();
+    if (tv.joinable()) tv.join();
+    out.sec = sinceSec(t0);
+    out.bytes = demux.bytesRead();
+    out.packets = demux.packetsRead();
+    demux.stop();
+    return true;
+}
+
+// ======================= 第 2 轮：解复用 + 解码 =======================
+struct StreamStats {
+    std::string codec;
+    int64_t frames{0};
+    int64_t lastDecodedUs{-1};
+    int64_t lastPtsUs{-1};
+    LatencySeries readToDecoded, decodedToPresented, readToPresented;
+    uint64_t seqHash{0};
+};
+
+// 不限速消费端：有帧就“呈现”（取走），记录分段延迟
+static void consumeFrames(AXDecoder *dec, FrameQueue *q, StreamStats *st, bool hash) {
+    uint64_t seq = 1469598103934665603ULL;
+    for (;;) {
+        AVFrame *frm = nullptr;
+        if (!q->tryPop(frm, std::chrono::milliseconds(10)) || !frm) {
+            // 先看 EOF 再看空：EOF 置位前的所有帧都已入队
+            if (dec->isEof() && q->empty()) break;
+            if (q->isAborted()) break;
+            continue;
+        }
+        if (hash) {
+            const uint64_t h = AXFrameDumpSink::hashFrame(frm);
+            seq = (seq ^ h) * 1099511628211ULL;
+        }
+        const int64_t nowUs = axStampNowUs();
+        if (const AXStageStamp *s = axStampOf(frm->opaque_ref)) {
+            if (s->readUs >= 0 && s->decodedUs >= 0) st->readToDecoded.add(s->decodedUs - s->readUs);
+            if (s->decodedUs >= 0) {
+                st->decodedToPresented.add(nowUs - s->decodedUs);
+                st->lastDecodedUs = s->decodedUs;
+            }
+            if (s->readUs >= 0) st->readToPresented.add(nowUs - s->readUs);
+        }
+        if (frm->pts != AV_NOPTS_VALUE) st->lastPtsUs = av_rescale_q(frm->pts, dec->timeBase(), AVRational{1, 1000000});
+        st->frames++;
+        axFrameFree(&frm);
+    }
+    st->seqHash = hash ? seq : 0;
+}
+
+struct DecodeRunStats {
+    double sec{0};
+    int64_t startUs{0};
+    StreamStats audio, video;
+    bool hasAudio{false}, hasVideo{false};
+};
+
+static bool runDecode(const std::string &path, const Options &opt, DecodeRunStats &out,
+                      std::vector<OccupancyHistogram> &hist) {
+    PacketQueue aPktQ(kPktQueueCap), vPktQ(kPktQueueCap);
+    FrameQueue aFrmQ(kAudioFrameQueueCap), vFrmQ(kVideoFrameQueueCap);
+    AXDemuxer demux;
+    DemuxResult info;
+    if (!demux.open(path, {}, info)) return false;
+    demux.setStageStamps(true);
+
+    const int aIdx = opt.audio ? info.audioStream : -1;
+    const int vIdx = opt.video ? info.videoStream : -1;
+    aPktQ.setTimeBase(info.aTimeBase);
+    vPktQ.setTimeBase(info.vTimeBase);
+    const bool both = info.audioStream >= 0 && info.videoStream >= 0;
+    aPktQ.setLimits(both ? kBufMaxBytes / 8 : kBufMaxBytes, kBufMaxDurationUs, kBufMinPackets);
+    vPktQ.setLimits(both ? kBufMaxBytes - kBufMaxBytes / 8 : kBufMaxBytes, kBufMaxDurationUs, kBufMinPackets);
+
+    std::unique_ptr<AXDecoder> aDec, vDec;
+    if (aIdx >= 0) {
+        aDec.reset(new AXDecoder());
+        if (!aDec->open(demux.fmt()->streams[aIdx]->codecpar, info.aTimeBase, false)) return false;
+        aDec->setPacketQueue(&aPktQ);
+        aDec->setFrameQueue(&aFrmQ);
+        out.audio.codec = aDec->ctx()->codec->name;
+        out.hasAudio = true;
+    }
+    if (vIdx >= 0) {
+        vDec.reset(new AXDecoder());
+        if (!vDec->open(demux.fmt()->streams[vIdx]->codecpar, info.vTimeBase, true)) return false;
+        vDec->setPacketQueue(&vPktQ);
+        vDec->setFrameQueue(&vFrmQ);
+        out.video.codec = vDec->ctx()->codec->name;
+        out.hasVideo = true;
+    }
+
+    // 被跳过的流：包直接丢弃，别让 demuxer 卡在满队列上
+    std::thread drainA, drainV;
+    const auto t0 = Clock::now();
+    out.startUs = axStampNowUs();
+    demux.start(&aPktQ, &vPktQ);
+    if (aDec) aDec->start(); else if (info.audioStream >= 0) drainA = std::thread(drainPackets, &aPktQ);
+    if (vDec) vDec->start(); else if (info.videoStream >= 0) drainV = std::thread(drainPackets, &vPktQ);
+
+    std::thread ca, cv;
+    if (aDec) ca = std::thread(consumeFrames, aDec.get(), &aFrmQ, &out.audio, false);
+    if (vDec) cv = std::thread(consumeFrames, vDec.get(), &vFrmQ, &out.video, opt.hash);
+
+    // 占用采样：直到所有消费端结束
+    std::atomic<bool> done{false};
+    std::thread sampler([&] {
+        while (!done.load(std::memory_order_relaxed)) {
+            hist[0].sample(aPktQ.size(), aPktQ.capacity());
+            hist[1].sample(vPktQ.size(), vPktQ.capacity());
+            hist[2].sample(aFrmQ.size(), aFrmQ.capacity());
+            hist[3].sample(vFrmQ.size(), vFrmQ.capacity());
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+
+    if (ca.joinable()) ca.join();
+    if (cv.joinable()) cv.join();
+    out.sec = sinceSec(t0);
+    done.store(true);
+    sampler.join();
+
+    demux.stop();
+    if (aDec) aDec->stop();
+    if (vDec) vDec->stop();
+    if (drainA.joinable()) drainA.join();
+    if (drainV.joinable()) drainV.join();
+    return true;
+}
+
+// 解码帧率：以该路最后一帧出解码器的时刻为终点（不含消费端收尾）
+static double decodeFps(const StreamStats &s, int64_t startUs, double wallSec) {
+    const double decSec = s.lastDecodedUs > startUs ? (s.lastDecodedUs - startUs) / 1e6 : wallSec;
+    return decSec > 0 ? s.frames / decSec : 0.0;
+}
+
+static void printStream(const char *kind, const StreamStats &s, int64_t startUs, double wallSec) {
+    std::printf("  %s %-10s frames=%-7lld decoded %8.1f fps", kind, s.codec.c_str(), (long long) s.frames,
+                decodeFps(s, startUs, wallSec));
+    if (s.lastPtsUs > 0 && wallSec > 0) std::printf("  (%.1fx realtime)", s.lastPtsUs / 1e6 / wallSec);
+    if (s.seqHash) std::printf("  seqHash=%016llx", (unsigned long long) s.seqHash);
+    std::printf("\n");
+    s.readToDecoded.print("read->decoded");
+    s.decodedToPresented.print("decoded->presented");
+    s.readToPresented.print("read->presented");
+}
+
+static int benchFile(const std::string &name, const std::string &path, const Options &opt) {
+    std::printf("== %s (%s)\n", name.c_str(), path.c_str());
+
+    DemuxResultStats dm;
+    if (!runDemux(path, dm)) {
+        std::printf("  open failed\n");
+        return 1;
+    }
+    const double mbps = dm.sec > 0 ? dm.bytes / 1048576.0 / dm.sec : 0.0;
+    const long rssDemux = peakRssKb();
+    std::printf("  demux: %lld packets %.2f MB in %.3fs = %.1f MB/s  peakRSS=%ld KB\n", (long long) dm.packets,
+                dm.bytes / 1048576.0, dm.sec, mbps, rssDemux);
+
+    std::vector<OccupancyHistogram> hist{OccupancyHistogram("aPktQ"), OccupancyHistogram("vPktQ"),
+                                         OccupancyHistogram("aFrmQ"), OccupancyHistogram("vFrmQ")};
+    DecodeRunStats dr;
+    if (!runDecode(path, opt, dr, hist)) {
+        std::printf("  decoder open failed\n");
+        return 1;
+    }
+    dr.audio.readToDecoded.finish();
+    dr.audio.decodedToPresented.finish();
+    dr.audio.readToPresented.finish();
+    dr.video.readToDecoded.finish();
+    dr.video.decodedToPresented.finish();
+    dr.video.readToPresented.finish();
+    const long rssDecode = peakRssKb();
+
+    std::printf("  decode: wall=%.3fs peakRSS=%ld KB\n", dr.sec, rssDecode);
+    if (dr.hasVideo) printStream("video", dr.video, dr.startUs, dr.sec);
+    if (dr.hasAudio) printStream("audio", dr.audio, dr.startUs, dr.sec);
+    std::printf("  queue occupancy (1ms samples):\n");
+    for (const auto &h: hist) h.print();
+
+    std::printf("RESULT name=%s demux_mbps=%.1f wall_s=%.3f vcodec=%s vfps=%.1f v_r2p_p50_ms=%.2f v_r2p_p99_ms=%.2f"
+                " acodec=%s afps=%.1f rss_kb=%ld\n",
+                name.c_str(), mbps, dr.sec, dr.hasVideo ? dr.video.codec.c_str() : "-", decodeFps(dr.video, dr.startUs, dr.sec),
+                dr.video.readToPresented.quantileMs(0.5), dr.video.readToPresented.quantileMs(0.99),
+                dr.hasAudio ? dr.audio.codec.c_str() : "-", decodeFps(dr.audio, dr.startUs, dr.sec), rssDecode);
+    return 0;
+}
+
+// 语料清单：每行 “名称  文件名  说明”，# 开头为注释
+static int benchCorpus(const std::string &dir, const Options &opt) {
+    std::ifstream in(dir + "/axbench_corpus.txt");
+    if (!in) {
+        std::fprintf(stderr, "no %s/axbench_corpus.txt (run bench/make_corpus.sh first)\n", dir.c_str());
+        return 2;
+    }
+    int failures = 0;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream ls(line);
+        std::string name, file;
+        if (!(ls >> name >> file)) continue;
+        failures += benchFile(name, dir + "/" + file, opt);
+    }
+    return failures ? 1 : 0;
+}
+
+int main(int argc, char **argv) {
+    Options opt;
+    std::string file, corpus;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--hash")) opt.hash = true;
+        else if (!std::strcmp(argv[i], "--no-audio")) opt.audio = false;
+        else if (!std::strcmp(argv[i], "--no-video")) opt.video = false;
+        else if (!std::strcmp(argv[i], "--corpus") && i + 1 < argc) corpus = argv[++i];
+        else if (argv[i][0] != '-' && file.empty()) file = argv[i];
+        else {
+            file.clear();
+            corpus.clear();
+            break;
+        }
+    }
+    if (file.empty() == corpus.empty()) {
+        std::fprintf(stderr, "usage: %s <file> [--hash] [--no-audio] [--no-video]\n"
+                             "       %s --corpus <dir> [--hash]\n", argv[0], argv[0]);
+        return 2;
+    }
+    return corpus.empty() ? benchFile(file, file, opt) : benchCorpus(corpus, opt);
+}
@@ -0,0 +1,181 @@
+// AXPlayerLib/MediaCore/bench/bench_colormatrix.cpp
+// AXColorMatrix 校验（无需 GL，主机/设备上都可跑）：
+//   1) 金值：各标准的黑/白与 100% 原色样本解出的 8 位 RGB，误差 ≤ 1（全范围色度上限 255 只能到 +127，放宽到 2）；
+//   2) 往返：RGB 网格按标准公式编码成 Y'CbCr 整数样本，再经矩阵解回，8 位误差 ≤ 2、10 位误差 ≤ 1；
+//   3) 未标注 colorspace / range 的推断规则；
+// 最后给出 CPU 参考实现逐像素转换 1080p 一帧的耗时（仅供参考）。
+// 用法：bench_colormatrix
+// 任一校验失败时返回非 0。
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "AXColorMatrix.h"
+
+extern "C" {
+#include <libavutil/pixfmt.h>
+}
+
+using Clock = std::chrono::steady_clock;
+
+struct Golden {
+    const char* what;
+    int colorspace;
+    int range;
+    int depth;
+    int y, u, v;
+    int r, g, b;
+    int tol;
+};
+
+static const Golden kGoldens[] = {
+        {"601 limited black", AVCOL_SPC_SMPTE170M, AVCOL_RANGE_MPEG, 8, 16, 128, 128, 0, 0, 0, 1},
+        {"601 limited white", AVCOL_SPC_SMPTE170M, AVCOL_RANGE_MPEG, 8, 235, 128, 128, 255, 255, 255, 1},
+        {"601 limited red", AVCOL_SPC_SMPTE170M, AVCOL_RANGE_MPEG, 8, 81, 90, 240, 255, 0, 0, 1},
+        {"601 limited green", AVCOL_SPC_SMPTE170M, AVCOL_RANGE_MPEG, 8, 145, 54, 34, 0, 255, 0, 1},
+        {"601 limited blue", AVCOL_SPC_SMPTE170M, AVCOL_RANGE_MPEG, 8, 41, 240, 110, 0, 0, 255, 1},
+        {"601 full white", AVCOL_SPC_BT470BG, AVCOL_RANGE_JPEG, 8, 255, 128, 128, 255, 255, 255, 1},
+        {"601 full red", AVCOL_SPC_BT470BG, AVCOL_RANGE_JPEG, 8, 76, 85, 255, 255, 0, 0, 2},
+        {"709 limited black", AVCOL_SPC_BT709, AVCOL_RANGE_MPEG, 8, 16, 128, 128, 0, 0, 0, 1},
+        {"709 limited red", AVCOL_SPC_BT709, AVCOL_RANGE_MPEG, 8, 63, 102, 240, 255, 0, 0, 1},
+        {"709 limited green", AVCOL_SPC_BT709, AVCOL_RANGE_MPEG, 8, 173, 42, 26, 0, 255, 0, 1},
+        {"709 limited blue", AVCOL_SPC_BT709, AVCOL_RANGE_MPEG, 8, 32, 240, 118, 0, 0, 255, 1},
+        {"709 full red", AVCOL_SPC_BT709, AVCOL_RANGE_JPEG, 8, 54, 99, 255, 255, 0, 0, 2},
+        {"709 limited 10-bit white", AVCOL_SPC_BT709, AVCOL_RANGE_MPEG, 10, 940, 512, 512, 255, 255, 255, 1},
+        {"2020 limited 10-bit black", AVCOL_SPC_BT2020_NCL, AVCOL_RANGE_MPEG, 10, 64, 512, 512, 0, 0, 0, 1},
+        {"2020 limited 10-bit red", AVCOL_SPC_BT2020_NCL, AVCOL_RANGE_MPEG, 10, 294, 387, 960, 255, 0, 0, 1},
+        {"2020 limited 10-bit green", AVCOL_SPC_BT2020_NCL, AVCOL_RANGE_MPEG, 10, 658, 189, 100, 0, 255, 0, 1},
+        {"2020 limited 10-bit blue", AVCOL_SPC_BT2020_NCL, AVCOL_RANGE_MPEG, 10, 116, 960, 476, 0, 0, 255, 1},
+};
+
+static int checkGoldens() {
+    int errors = 0;
+    for (const Golden& g : kGoldens) {
+        AXColorMatrix m;
+        axColorMatrixFor(g.colorspace, g.range, g.depth, m);
+        uint8_t rgb[3];
+        m.toRgb8(g.y, g.u, g.v, rgb);
+        const int e = std::max({std::abs(rgb[0] - g.r), std::abs(rgb[1] - g.g), std::abs(rgb[2] - g.b)});
+        const bool ok = e <= g.tol;
+        if (!ok) ++errors;
+        std::printf("%-28s -> %3d %3d %3d (want %3d %3d %3d)%s\n",
+                    g.what, rgb[0], rgb[1], rgb[2], g.r, g.g, g.b, ok ? "" : "  MISMATCH");
+    }
+    return errors;
+}
+
+// 按标准公式把 8 位 RGB 编码为 depth 位 Y'CbCr 样本（四舍五入、截断到合法码值）
+static void encode(double kr, double kb, bool full, int depth, int r, int g, int b, int out[3]) {
+    const double kg = 1.0 - kr - kb;
+    const double R = r / 255.0, G = g / 255.0, B = b / 255.0;
+    const double Y = kr * R + kg * G + kb * B;
+    const double Cb = (B - Y) / (2.0 * (1.0 - kb));
+    const double Cr = (R - Y) / (2.0 * (1.0 - kr));
+    const double maxV = (double) ((1 << depth) - 1);
+    const double unit = (double) (1 << (depth - 8));
+    const double mid = (double) (1 << (depth - 1));
+    double y, u, v;
+    if (full) {
+        y = Y * maxV;
+        u = mid + Cb * maxV;
+        v = mid + Cr * maxV;
+    } else {
+        y = 16.0 * unit + Y * 219.0 * unit;
+        u = mid + Cb * 224.0 * unit;
+        v = mid + Cr * 224.0 * unit;
+    }
+    const double vals[3] = {y, u, v};
+    for (int i = 0; i < 3; ++i) out[i] = (int) std::min(maxV, std::max(0.0, std::round(vals[i])));
+}
+
+static int checkRoundTrip() {
+    struct Std {
+        const char* name;
+        int colorspace;
+        double kr, kb;
+    };
+    const Std stds[] = {
+            {"601", AVCOL_SPC_SMPTE170M, 0.299, 0.114},
+            {"709", AVCOL_SPC_BT709, 0.2126, 0.0722},
+            {"2020", AVCOL_SPC_BT2020_NCL, 0.2627, 0.0593},
+            {"240M", AVCOL_SPC_SMPTE240M, 0.212, 0.087},
+            {"FCC", AVCOL_SPC_FCC, 0.30, 0.11},
+    };
+    int errors = 0;
+    for (const Std& s : stds) {
+        for (int range : {(int) AVCOL_RANGE_MPEG, (int) AVCOL_RANGE_JPEG}) {
+            for (int depth : {8, 10}) {
+                AXColorMatrix m;
+                if (!axColorMatrixFor(s.colorspace, range, depth, m)) ++errors;
+                const int tol = depth == 8 ? 2 : 1;
+                int worst = 0;
+                for (int r = 0; r < 256; r += 15) {
+                    for (int g = 0; g < 256; g += 15) {
+                        for (int b = 0; b < 256; b += 15) {
+                            int yuv[3];
+                            encode(s.kr, s.kb, range == AVCOL_RANGE_JPEG, depth, r, g, b, yuv);
+                            uint8_t rgb[3];
+                            m.toRgb8(yuv[0], yuv[1], yuv[2], rgb);
+                            worst = std::max({worst, std::abs(rgb[0] - r), std::abs(rgb[1] - g), std::abs(rgb[2] - b)});
+                        }
+                    }
+                }
+                const bool ok = worst <= tol;
+                if (!ok) ++errors;
+                std::printf("round trip %-4s %-7s %2d-bit maxErr=%d%s\n", s.name,
+                            range == AVCOL_RANGE_JPEG ? "full" : "limited", depth, worst, ok ? "" : "  MISMATCH");
+            }
+        }
+    }
+    return errors;
+}
+
+static int checkResolve() {
+    int errors = 0;
+    auto expect = [&](const char* what, int got, int want) {
+        if (got != want) {
+            ++errors;
+            std::printf("resolve %-28s got %d want %d  MISMATCH\n", what, got, want);
+        }
+    };
+    expect("unspecified @1080", axResolveColorSpace(AVCOL_SPC_UNSPECIFIED, 1080), AVCOL_SPC_BT709);
+    expect("unspecified @720", axResolveColorSpace(AVCOL_SPC_UNSPECIFIED, 720), AVCOL_SPC_BT709);
+    expect("unspecified @576", axResolveColorSpace(AVCOL_SPC_UNSPECIFIED, 576), AVCOL_SPC_SMPTE170M);
+    expect("rgb @2160", axResolveColorSpace(AVCOL_SPC_RGB, 2160), AVCOL_SPC_BT709);
+    expect("bt2020 @480", axResolveColorSpace(AVCOL_SPC_BT2020_NCL, 480), AVCOL_SPC_BT2020_NCL);
+    expect("bt709 @480", axResolveColorSpace(AVCOL_SPC_BT709, 480), AVCOL_SPC_BT709);
+    expect("range unspecified", axResolveColorRange(AVCOL_RANGE_UNSPECIFIED, false), AVCOL_RANGE_MPEG);
+    expect("range unspecified yuvj", axResolveColorRange(AVCOL_RANGE_UNSPECIFIED, true), AVCOL_RANGE_JPEG);
+    expect("range mpeg yuvj", axResolveColorRange(AVCOL_RANGE_MPEG, true), AVCOL_RANGE_MPEG);
+    std::printf("resolve rules: %s\n", errors == 0 ? "ok" : "MISMATCH");
+    return errors;
+}
+
+static void timeReference() {
+    const int w = 1920, h = 1080;
+    AXColorMatrix m;
+    axColorMatrixFor(AVCOL_SPC_BT709, AVCOL_RANGE_MPEG, 8, m);
+    std::vector<uint8_t> out((size_t) w * h * 3);
+    const auto t0 = Clock::now();
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            m.toRgb8(16 + (x + y) % 220, 16 + x % 225, 16 + y % 225, &out[((size_t) y * w + x) * 3]);
+        }
+    }
+    const double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    std::printf("cpu reference 1080p: %.2f ms/frame (checksum %u)\n", ms, (unsigned) out[out.size() / 2]);
+}
+
+int main() {
+    int errors = 0;
+    errors += checkGoldens();
+    errors += checkRoundTrip();
+    errors += checkResolve();
+    timeReference();
+    std::printf("%s\n", errors == 0 ? "PASS" : "FAIL");
+    return errors == 0 ? 0 : 1;
+}
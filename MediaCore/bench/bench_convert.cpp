@@ -0,0 +1,180 @@
+// AXPlayerLib/MediaCore/bench/bench_convert.cpp
+// AXFrameConverter 基准/校验：BGRA、YUYV422 → I420，1080p 与 4K，
+// 逐个后端（纯 C 标量参考 / libyuv / swscale）测每帧耗时，并与标量参考比对最大逐样本差。
+// 标量参考为 BT.601 有限范围、2x2 平均色度；各后端的舍入与色度滤波略有不同，差值 ≤ kMaxDiff 视为一致
+// （通道顺序、步长或平面错位会产生远大于此的差值）。
+// 用法：bench_convert [iters=30]
+// 任一校验失败时返回非 0。
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "AXFrameConverter.h"
+
+extern "C" {
+#include <libavutil/frame.h>
+#include <libavutil/pixdesc.h>
+}
+
+using Clock = std::chrono::steady_clock;
+
+static constexpr int kMaxDiff = 8;
+
+static inline uint8_t clamp8(int v) { return (uint8_t) std::min(255, std::max(0, v)); }
+
+static inline uint8_t rgbToY(int r, int g, int b) { return clamp8(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16); }
+
+static inline uint8_t rgbToU(int r, int g, int b) { return clamp8(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128); }
+
+static inline uint8_t rgbToV(int r, int g, int b) { return clamp8(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128); }
+
+// 标量参考：BGRA（内存字节序 B,G,R,A）→ I420，色度取 2x2 平均（奇数边复制边缘）
+static void scalarBgraToI420(const AVFrame* s, AVFrame* d) {
+    const int w = s->width, h = s->height;
+    for (int y = 0; y < h; ++y) {
+        const uint8_t* p = s->data[0] + (ptrdiff_t) y * s->linesize[0];
+        uint8_t* dy = d->data[0] + (ptrdiff_t) y * d->linesize[0];
+        for (int x = 0; x < w; ++x, p += 4) dy[x] = rgbToY(p[2], p[1], p[0]);
+    }
+    for (int y = 0; y < h; y += 2) {
+        const uint8_t* r0 = s->data[0] + (ptrdiff_t) y * s->linesize[0];
+        const uint8_t* r1 = s->data[0] + (ptrdiff_t) std::min(y + 1, h - 1) * s->linesize[0];
+        uint8_t* du = d->data[1] + (ptrdiff_t) (y / 2) * d->linesize[1];
+        uint8_t* dv = d->data[2] + (ptrdiff_t) (y / 2) * d->linesize[2];
+        for (int x = 0; x < w; x += 2) {
+            const int x1 = std::min(x + 1, w - 1);
+            const int b = (r0[x * 4 + 0] + r0[x1 * 4 + 0] + r1[x * 4 + 0] + r1[x1 * 4 + 0] + 2) >> 2;
+            const int g = (r0[x * 4 + 1] + r0[x1 * 4 + 1] + r1[x * 4 + 1] + r1[x1 * 4 + 1] + 2) >> 2;
+            const int r = (r0[x * 4 + 2] + r0[x1 * 4 + 2] + r1[x * 4 + 2] + r1[x1 * 4 + 2] + 2) >> 2;
+            du[x / 2] = rgbToU(r, g, b);
+            dv[x / 2] = rgbToV(r, g, b);
+        }
+    }
+}
+
+// 标量参考：YUYV422（Y0 U Y1 V）→ I420，色度取上下两行平均
+static void scalarYuyvToI420(const AVFrame* s, AVFrame* d) {
+    const int w = s->width, h = s->height;
+    for (int y = 0; y < h; ++y) {
+        const uint8_t* p = s->data[0] + (ptrdiff_t) y * s->linesize[0];
+        uint8_t* dy = d->data[0] + (ptrdiff_t) y * d->linesize[0];
+        for (int x = 0; x < w; ++x) dy[x] = p[x * 2];
+    }
+    for (int y = 0; y < h; y += 2) {
+        const uint8_t* r0 = s->data[0] + (ptrdiff_t) y * s->linesize[0];
+        const uint8_t* r1 = s->data[0] + (ptrdiff_t) std::min(y + 1, h - 1) * s->linesize[0];
+        uint8_t* du = d->data[1] + (ptrdiff_t) (y / 2) * d->linesize[1];
+        uint8_t* dv = d->data[2] + (ptrdiff_t) (y / 2) * d->linesize[2];
+        for (int x = 0; x < (w + 1) / 2; ++x) {
+            du[x] = (uint8_t) ((r0[x * 4 + 1] + r1[x * 4 + 1] + 1) >> 1);
+            dv[x] = (uint8_t) ((r0[x * 4 + 3] + r1[x * 4 + 3] + 1) >> 1);
+        }
+    }
+}
+
+// 平滑渐变 + 少量伪随机扰动：既有色度又不会让不同的色度滤波拉开太大差距
+static void fillSource(AVFrame* f) {
+    uint32_t seed = 12345;
+    const int bpp = f->format == AV_PIX_FMT_BGRA ? 4 : 2;
+    for (int y = 0; y < f->height; ++y) {
+        uint8_t* p = f->data[0] + (ptrdiff_t) y * f->linesize[0];
+        for (int x = 0; x < f->width * bpp; ++x) {
+            seed = seed * 1664525u + 1013904223u;
+            const int base = (x / bpp * 255 / f->width + y * 255 / f->height + (x % bpp) * 60) & 0xff;
+            p[x] = (uint8_t) std::min(235, std::max(16, base + (int) (seed >> 29) - 4));
+        }
+    }
+}
+
+static int maxPlaneDiff(const AVFrame* a, const AVFrame* b) {
+    int worst = 0;
+    for (int p = 0; p < 3; ++p) {
+        const int pw = p == 0 ? a->width : (a->width + 1) / 2;
+        const int ph = p == 0 ? a->height : (a->height + 1) / 2;
+        for (int y = 0; y < ph; ++y) {
+            const uint8_t* ra = a->data[p] + (ptrdiff_t) y * a->linesize[p];
+            const uint8_t* rb = b->data[p] + (ptrdiff_t) y * b->linesize[p];
+            for (int x = 0; x < pw; ++x) worst = std::max(worst, std::abs(ra[x] - rb[x]));
+        }
+    }
+    return worst;
+}
+
+static AVFrame* newFrame(int w, int h, AVPixelFormat fmt) {
+    AVFrame* f = av_frame_alloc();
+    if (!f) return nullptr;
+    f->width = w;
+    f->height = h;
+    f->format = fmt;
+    if (av_frame_get_buffer(f, 0) < 0) av_frame_free(&f);
+    return f;
+}
+
+// 返回校验错误数
+static int runCase(int w, int h, AVPixelFormat fmt, int iters) {
+    AVFrame* src = newFrame(w, h, fmt);
+    AVFrame* ref = newFrame(w, h, AV_PIX_FMT_YUV420P);
+    AVFrame* dst = av_frame_alloc();
+    if (!src || !ref || !dst) {
+        std::fprintf(stderr, "alloc %dx%d failed\n", w, h);
+        return 1;
+    }
+    fillSource(src);
+    const char* fmtName = av_get_pix_fmt_name(fmt);
+
+    auto t0 = Clock::now();
+    for (int i = 0; i < iters; ++i) {
+        if (fmt == AV_PIX_FMT_BGRA) scalarBgraToI420(src, ref);
+        else                        scalarYuyvToI420(src, ref);
+    }
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count() / iters;
+    std::printf("%-8s %4dx%-4d %-8s %8.3f ms/frame\n", fmtName, w, h, "scalar", ms);
+
+    int errors = 0;
+    AXFrameConverter conv;
+    const AXFrameConverter::Backend backends[] = {AXFrameConverter::Backend::LibYuv,
+                                                  AXFrameConverter::Backend::Swscale};
+    for (AXFrameConverter::Backend b : backends) {
+        const char* name = AXFrameConverter::backendName(b);
+        // 预热一次：建池 / 建 sws 上下文，同时做校验
+        if (conv.convertWith(b, src, dst) != b) {
+            std::printf("%-8s %4dx%-4d %-8s unavailable\n", fmtName, w, h, name);
+            continue;
+        }
+        const int diff = maxPlaneDiff(ref, dst);
+        av_frame_unref(dst);
+
+        t0 = Clock::now();
+        for (int i = 0; i < iters; ++i) {
+            conv.convertWith(b, src, dst);
+            av_frame_unref(dst);   // 缓冲回池，下一轮复用
+        }
+        ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count() / iters;
+        const bool ok = diff <= kMaxDiff;
+        if (!ok) ++errors;
+        std::printf("%-8s %4dx%-4d %-8s %8.3f ms/frame  maxDiff=%d%s\n",
+                    fmtName, w, h, name, ms, diff, ok ? "" : "  MISMATCH");
+    }
+
+    av_frame_free(&dst);
+    av_frame_free(&ref);
+    av_frame_free(&src);
+    return errors;
+}
+
+int main(int argc, char** argv) {
+    const int iters = argc > 1 ? std::max(1, std::atoi(argv[1])) : 30;
+    std::printf("iters=%d libyuv=%s\n", iters, AXFrameConverter::hasLibYuv() ? "yes" : "no");
+
+    const int sizes[][2] = {{1920, 1080}, {3840, 2160}};
+    const AVPixelFormat fmts[] = {AV_PIX_FMT_BGRA, AV_PIX_FMT_YUYV422};
+    int errors = 0;
+    for (const auto& s : sizes) {
+        for (AVPixelFormat f : fmts) errors += runCase(s[0], s[1], f, iters);
+    }
+    std::printf("%s\n", errors == 0 ? "PASS" : "FAIL");
+    return errors == 0 ? 0 : 1;
+}
@@ -0,0 +1,129 @@
+// AXPlayerLib/MediaCore/bench/bench_gain.cpp
+// AXAudioGain 内核基准/校验：2、6、8 声道 × F32/S16，逐个 SIMD 实现与标量参考比对并测吞吐。
+// 校验：F32 与标量逐样本相对误差 ≤ 1e-6，S16 逐位一致（Q15 定义相同）；
+// 另验证过渡（ramp）无跳变：恒定输入下相邻帧增益差不超过一个过渡步长。
+// 用法：bench_gain [frames=4096] [iters=20000]
+// 任一校验失败时返回非 0。
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "AXAudioGain.h"
+
+using Clock = std::chrono::steady_clock;
+
+static const float kGains[AXAudioGain::kMaxChannels] = {0.5f, 0.8f, 0.8f, 0.3f, 0.65f, 0.65f, 0.9f, 0.9f};
+
+static void fillPatterns(int ch, std::vector<float>& pf, std::vector<int16_t>& pq) {
+    pf.assign((size_t) ch * 8, 0.f);
+    pq.assign((size_t) ch * 16, 0);
+    for (int i = 0; i < ch * 8; ++i) pf[i] = kGains[i % ch];
+    for (int i = 0; i < ch * 16; ++i) pq[i] = axgain::toQ15(kGains[i % ch]);
+}
+
+// 返回校验错误数；frames 故意取非块长整数倍以覆盖尾部
+static int verify(const axgain::Kernels& k, int ch, int frames) {
+    std::vector<float> pf;
+    std::vector<int16_t> pq;
+    fillPatterns(ch, pf, pq);
+    const axgain::Kernels& ref = *axgain::kernelsFor(axgain::Isa::Scalar);
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> uf(-1.f, 1.f);
+    std::uniform_int_distribution<int> ui(-32768, 32767);
+    const size_t n = (size_t) frames * ch;
+    std::vector<float> a(n), b(n);
+    std::vector<int16_t> c(n), d(n);
+    for (size_t i = 0; i < n; ++i) {
+        a[i] = b[i] = uf(rng);
+        c[i] = d[i] = (int16_t) ui(rng);
+    }
+    ref.f32(a.data(), (int64_t) n, ch, pf.data());
+    k.f32(b.data(), (int64_t) n, ch, pf.data());
+    ref.s16(c.data(), (int64_t) n, ch, pq.data());
+    k.s16(d.data(), (int64_t) n, ch, pq.data());
+
+    int errors = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (std::fabs(a[i] - b[i]) > 1e-6f * std::max(1.f, std::fabs(a[i]))) ++errors;
+        if (c[i] != d[i]) ++errors;
+    }
+    return errors;
+}
+
+static double throughput(const axgain::Kernels& k, bool f32, int ch, int frames, int iters) {
+    std::vector<float> pf;
+    std::vector<int16_t> pq;
+    fillPatterns(ch, pf, pq);
+    const size_t n = (size_t) frames * ch;
+    std::vector<float> a(n, 0.25f);
+    std::vector<int16_t> c(n, 1234);
+
+    const auto t0 = Clock::now();
+    for (int it = 0; it < iters; ++it) {
+        if (f32) k.f32(a.data(), (int64_t) n, ch, pf.data());
+        else     k.s16(c.data(), (int64_t) n, ch, pq.data());
+        // 定期重置数据，避免反复相乘趋零后落入非规格化数（会拖慢 F32）
+        if (f32 && (it & 63) == 63) std::fill(a.begin(), a.end(), 0.25f);
+    }
+    const double sec = std::chrono::duration<double>(Clock::now() - t0).count();
+    return (double) frames * iters / sec / 1e6;   // Mframes/s
+}
+
+// 过渡：恒定 1.0 输入，目标从 1 → 0.2，检查相邻帧差异与终值
+static int verifyRamp(int ch) {
+    const int rate = 48000;
+    AXAudioGain g;
+    g.configure(AXAudioGain::Format::F32, ch, rate);
+    g.setStereoVolume(0.2f, 0.2f);
+
+    const int frames = rate * AXAudioGain::kRampMs / 1000 * 2;
+    std::vector<float> buf((size_t) frames * ch, 1.f);
+    // 分小块送入，覆盖过渡跨块
+    for (int off = 0; off < frames; off += 37) {
+        const int n = std::min(37, frames - off);
+        g.process(buf.data() + (size_t) off * ch, n);
+    }
+    const float maxStep = 0.8f / (rate * AXAudioGain::kRampMs / 1000.f) * 1.01f;
+    int errors = 0;
+    float prev = 1.f;
+    for (int i = 0; i < frames; ++i) {
+        const float v = buf[(size_t) i * ch];
+        if (prev - v > maxStep || v > prev + 1e-6f) ++errors;
+        prev = v;
+    }
+    if (std::fabs(buf.back() - 0.2f) > 1e-6f) ++errors;
+    return errors;
+}
+
+int main(int argc, char** argv) {
+    const int frames = argc > 1 ? std::atoi(argv[1]) : 4096;
+    const int iters  = argc > 2 ? std::atoi(argv[2]) : 20000;
+    std::printf("frames=%d iters=%d best=%s\n", frames, iters, AXAudioGain::isaName());
+
+    const axgain::Isa isas[] = {axgain::Isa::Scalar, axgain::Isa::Neon, axgain::Isa::Sse, axgain::Isa::Avx2};
+    const int chans[] = {2, 6, 8};
+    int errors = 0;
+
+    for (int ch : chans) {
+        const int re = verifyRamp(ch);
+        errors += re;
+        for (axgain::Isa isa : isas) {
+            const axgain::Kernels* k = axgain::kernelsFor(isa);
+            if (!k) continue;
+            const int e = verify(*k, ch, 1001) + verify(*k, ch, 7);
+            errors += e;
+            const double f = throughput(*k, true, ch, frames, iters);
+            const double s = throughput(*k, false, ch, frames, iters);
+            std::printf("ch=%d %-6s f32 %8.1f Mframes/s  s16 %8.1f Mframes/s  mismatches=%d rampErr=%d\n",
+                        ch, k->name, f, s, e, re);
+        }
+    }
+    std::printf("%s\n", errors == 0 ? "PASS" : "FAIL");
+    return errors == 0 ? 0 : 1;
+}
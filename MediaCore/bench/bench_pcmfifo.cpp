@@ -0,0 +1,172 @@
+// AXPlayerLib/MediaCore/bench/bench_pcmfifo.cpp
+// AXPcmFifo 压力/校验程序：生产者按解码帧粒度写入、消费者按音频回调 burst 读出，
+// 每个样本写入自身的绝对帧号，读侧逐帧校验连续性与 PTS（不允许任何错帧、错 PTS）。
+// 场景：
+//   burst    —— 双方全速（最大化交错与回绕）
+//   realtime —— 消费者按 burst/rate 的节奏读，生产者保持 80~160ms 水位（模拟播放）
+//   clear    —— 在 burst 的基础上由第三线程随机 clear()（模拟 pause/seek）
+//   inflight —— 同 clear，但生产者在 beginWrite 与 commitWrite 之间停留（模拟转换/增益耗时），
+//               让 clear 频繁落在写入中途
+// clear 类场景另校验：clear 返回之后开始的读，绝不能读到 clear 之前已预留的帧（staleReads）。
+// 用法：bench_pcmfifo [seconds=3] [rate=48000] [burst=192] [channels=2]
+// 任一场景出现校验错误时返回非 0。
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "AXPcmFifo.h"
+
+using Clock = std::chrono::steady_clock;
+
+struct Result {
+    int64_t framesRead{0};
+    int64_t reads{0};
+    int64_t underruns{0};       // 读不满一个 burst（realtime 场景下即“爆音”）
+    int64_t dataErrors{0};      // 帧号不连续 / 帧内通道不一致
+    int64_t ptsErrors{0};       // firstPts 与首帧帧号换算值相差超过 1us（取整）
+    int64_t ptsMissing{0};      // 读到数据却没拿到 PTS
+    int64_t staleReads{0};      // 读到了 clear 之前已预留的帧
+    int64_t clears{0};
+};
+
+static inline int64_t ptsOf(int64_t frameNo, int rate) { return frameNo * 1000000LL / rate; }
+
+static Result run(const char* name, int seconds, int rate, int burst, int ch, bool realtime, bool withClear,
+                  bool slowCommit = false) {
+    AXPcmFifo fifo;
+    const int bpf = ch * (int) sizeof(int32_t);
+    fifo.configure(rate, bpf, rate);
+
+    std::atomic<bool> stop{false};
+    Result res;
+    std::atomic<int64_t> reservedEnd{0};   // 生产者已预留（beginWrite 已返回）的帧号上界
+    std::atomic<int64_t> staleFloor{0};    // 某次 clear 返回时，此前已预留的帧号上界
+
+    // 生产者：每次写 256~2048 帧（解码帧大小不一），PTS = 首帧帧号换算；每帧各通道都写帧号
+    std::thread prod([&] {
+        std::mt19937 rng(1234);
+        std::uniform_int_distribution<int> sz(256, 2048);
+        std::vector<int32_t> chunk(2048 * ch);
+        int64_t next = 0;
+        while (!stop.load(std::memory_order_relaxed)) {
+            if (realtime && fifo.durationUs() >= 160000) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                continue;
+            }
+            const int n = sz(rng);
+            for (int i = 0; i < n; ++i)
+                for (int c = 0; c < ch; ++c) chunk[(size_t) i * ch + c] = (int32_t) (next + i);
+            // 一半走拷贝接口，一半走 begin/commit 直写接口
+            int32_t w = 0;
+            if ((next & 1) && !slowCommit) {
+                w = fifo.write(chunk.data(), n, ptsOf(next, rate));
+                reservedEnd.store(next + w, std::memory_order_seq_cst);
+            } else {
+                AXPcmFifo::Region r;
+                w = fifo.beginWrite(r, n);
+                if (w > 0) {
+                    reservedEnd.store(next + w, std::memory_order_seq_cst);
+                    if (slowCommit) {
+                        const auto until = Clock::now() + std::chrono::microseconds(20);
+                        while (Clock::now() < until) {}
+                    }
+                    std::memcpy(r.ptr[0], chunk.data(), (size_t) r.frames[0] * bpf);
+                    if (r.frames[1] > 0)
+                        std::memcpy(r.ptr[1], chunk.data() + (size_t) r.frames[0] * ch, (size_t) r.frames[1] * bpf);
+                    fifo.commitWrite(w, ptsOf(next, rate));
+                }
+            }
+            next += w;
+            if (w < n) std::this_thread::yield();   // 满：稍后重试剩余帧号
+        }
+    });
+
+    std::thread clearer;
+    if (withClear) {
+        clearer = std::thread([&] {
+            std::mt19937 rng(99);
+            std::uniform_int_distribution<int> us(200, 3000);
+            while (!stop.load(std::memory_order_relaxed)) {
+                std::this_thread::sleep_for(std::chrono::microseconds(slowCommit ? us(rng) / 10 : us(rng)));
+                const int64_t b = reservedEnd.load(std::memory_order_seq_cst);
+                fifo.clear();
+                staleFloor.store(b, std::memory_order_release);
+                ++res.clears;
+            }
+        });
+    }
+
+    // 消费者（模拟 Oboe 回调）
+    std::vector<int32_t> out((size_t) burst * ch);
+    const auto period = std::chrono::microseconds((int64_t) burst * 1000000 / rate);
+    const auto t0 = Clock::now();
+    auto nextTick = t0;
+    int64_t expect = -1;          // 期望的下一帧号（clear 后重新同步）
+    bool started = false;
+    while (Clock::now() - t0 < std::chrono::seconds(seconds)) {
+        if (realtime) {
+            nextTick += period;
+            std::this_thread::sleep_until(nextTick);
+        }
+        int64_t pts = -1;
+        const int64_t floor = staleFloor.load(std::memory_order_acquire);
+        const int32_t got = fifo.read(out.data(), burst, pts);
+        ++res.reads;
+        if (got < burst && started) ++res.underruns;
+        if (got <= 0) continue;
+        started = true;
+        res.framesRead += got;
+
+        const int64_t first = out[0];
+        if (first < floor) ++res.staleReads;
+        if (!withClear && expect >= 0 && first != expect) ++res.dataErrors;
+        for (int i = 0; i < got; ++i) {
+            for (int c = 0; c < ch; ++c) {
+                if (out[(size_t) i * ch + c] != (int32_t) (first + i)) { ++res.dataErrors; i = got; break; }
+            }
+        }
+        for (size_t k = (size_t) got * ch; k < out.size(); ++k) {
+            if (out[k] != 0) { ++res.dataErrors; break; }   // 不足部分必须是静音
+        }
+        if (pts < 0) ++res.ptsMissing;
+        else if (std::llabs(pts - ptsOf(first, rate)) > 1) ++res.ptsErrors;   // 仅允许微秒取整误差
+        expect = first + got;
+    }
+    stop.store(true);
+    prod.join();
+    if (clearer.joinable()) clearer.join();
+
+    const double sec = std::chrono::duration<double>(Clock::now() - t0).count();
+    std::printf("%-8s frames=%-10lld %8.1f Mframes/s reads=%-8lld underruns=%-6lld dataErr=%lld ptsErr=%lld ptsMissing=%lld stale=%lld clears=%lld droppedWrites=%lld droppedMarkers=%lld\n",
+                name, (long long) res.framesRead, res.framesRead / sec / 1e6, (long long) res.reads,
+                (long long) res.underruns, (long long) res.dataErrors, (long long) res.ptsErrors,
+                (long long) res.ptsMissing, (long long) res.staleReads, (long long) res.clears,
+                (long long) fifo.droppedWrites(), (long long) fifo.droppedMarkers());
+    return res;
+}
+
+int main(int argc, char** argv) {
+    const int seconds = argc > 1 ? std::atoi(argv[1]) : 3;
+    const int rate    = argc > 2 ? std::atoi(argv[2]) : 48000;
+    const int burst   = argc > 3 ? std::atoi(argv[3]) : 192;
+    const int ch      = argc > 4 ? std::atoi(argv[4]) : 2;
+
+    std::printf("seconds=%d rate=%d burst=%d ch=%d\n", seconds, rate, burst, ch);
+    const Result b = run("burst",    seconds, rate, burst, ch, false, false);
+    const Result r = run("realtime", seconds, rate, burst, ch, true,  false);
+    const Result c = run("clear",    seconds, rate, burst, ch, false, true);
+    const Result f = run("inflight", seconds, rate, burst, ch, false, true, true);
+
+    const bool ok = b.dataErrors == 0 && b.ptsErrors == 0 && b.ptsMissing == 0 &&
+                    r.dataErrors == 0 && r.ptsErrors == 0 && r.ptsMissing == 0 && r.underruns == 0 &&
+                    c.dataErrors == 0 && c.ptsErrors == 0 && c.staleReads == 0 &&
+                    f.dataErrors == 0 && f.ptsErrors == 0 && f.staleReads == 0 && f.clears > 0;
+    std::printf("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,188 @@
+// AXPlayerLib/MediaCore/bench/bench_playloop.cpp
+// 播放线程调度基准：旧版 1ms/10ms 轮询 vs 截止时间 + 事件唤醒（AXPlayer::playThreadLoop 的两种写法）
+// 模拟：解码线程按需往 SpscQueue 推带 PTS 的“帧”，播放线程按主时钟（墙钟 × 倍速）在窗口内显示/丢弃。
+// 每种调度先播放 play 秒、再暂停 pause 秒，统计播放线程的 CPU 时间、每秒唤醒次数与显示误差。
+// 用法：bench_playloop [fps=30] [play=5] [pause=2]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <sys/resource.h>
+
+#include "AXQueues.h"
+#include "AXEventCount.h"
+
+using Clock = std::chrono::steady_clock;
+
+static double threadCpuSeconds() {
+    rusage ru{};
+#if defined(RUSAGE_THREAD)
+    getrusage(RUSAGE_THREAD, &ru);
+#else
+    getrusage(RUSAGE_SELF, &ru);
+#endif
+    return ru.ru_utime.tv_sec + ru.ru_stime.tv_sec + (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) / 1e6;
+}
+
+struct PhaseStat {
+    double  seconds{0};
+    double  cpuSeconds{0};
+    int64_t wakeups{0};
+    int64_t shown{0};
+    int64_t dropped{0};
+    double  sumLateUs{0};   // 显示时刻 - 帧 PTS（绝对值累计）
+    int64_t maxLateUs{0};
+};
+
+// 简化的“播放器”：帧队列 + 主时钟 + 暂停/事件
+struct Sim {
+    explicit Sim(int fps) : frameUs(1000000 / fps), q(32) {}
+
+    const int64_t frameUs;
+    SpscQueue<int64_t> q;           // 元素 = 帧 PTS（微秒）
+    std::atomic<bool> playing{true};
+    std::atomic<bool> abort{false};
+    AXEventCount ev;
+    Clock::time_point t0 = Clock::now();
+
+    int64_t masterUs() const {
+        return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - t0).count();
+    }
+
+    // 与 AXVideoRenderer::drawLoopOnce 相同的窗口：提前 >20ms 等待，落后 >120ms 丢弃
+    // 返回与 drawLoopOnce 一致：>=0 还需等待的微秒，-1 无帧
+    int64_t drawOnce(int64_t& pending, PhaseStat& st) {
+        for (;;) {
+            if (pending < 0 && !q.tryPop(pending, std::chrono::milliseconds(0))) {
+                pending = -1;
+                return -1;
+            }
+            const int64_t m = masterUs();
+            const int64_t diff = pending - m;
+            if (diff > 20000) return diff - 20000;
+            if (diff < -120000) { ++st.dropped; pending = -1; continue; }
+            const int64_t late = diff < 0 ? -diff : diff;
+            st.sumLateUs += (double) late;
+            st.maxLateUs = std::max(st.maxLateUs, late);
+            ++st.shown;
+            pending = -1;
+            return 0;
+        }
+    }
+};
+
+static void producer(Sim* s) {
+    int64_t pts = 0;
+    while (!s->abort.load()) {
+        if (!s->q.push(pts)) break;
+        pts += s->frameUs;
+    }
+}
+
+// 旧版：播放中每 1ms、暂停中每 10ms 醒一次
+static void legacyLoop(Sim* s, PhaseStat& st, const std::atomic<bool>& stop) {
+    int64_t pending = -1;
+    while (!stop.load()) {
+        ++st.wakeups;
+        if (!s->playing.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            continue;
+        }
+        s->drawOnce(pending, st);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+// 新版：睡到下一帧截止时间；无帧时武装队列就绪通知；暂停时无限期等事件
+static void eventLoop(Sim* s, PhaseStat& st, const std::atomic<bool>& stop) {
+    s->q.setReadyNotifier(&s->ev);
+    int64_t pending = -1;
+    while (!stop.load()) {
+        ++st.wakeups;
+        const uint32_t key = s->ev.prepareWait();
+        if (!s->playing.load()) {
+            if (stop.load() || s->playing.load()) { s->ev.cancelWait(); continue; }
+            s->ev.wait(key);
+            continue;
+        }
+        int64_t waitUs = 100000;
+        const int64_t due = s->drawOnce(pending, st);
+        if (due < 0) {
+            s->q.armReadyNotify();
+            if (!s->q.empty()) waitUs = 0;
+        } else {
+            waitUs = std::min(waitUs, due);
+        }
+        if (waitUs <= 0 || stop.load()) { s->ev.cancelWait(); continue; }
+        s->ev.waitUntil(key, Clock::now() + std::chrono::microseconds(waitUs));
+    }
+    s->q.setReadyNotifier(nullptr);
+}
+
+template <typename Loop>
+static void run(const char* name, Loop loop, int fps, int playSec, int pauseSec) {
+    Sim sim(fps);
+    std::thread prod(producer, &sim);
+
+    PhaseStat phase[2];
+    std::atomic<bool> stop{false};
+    int cur = 0;
+    double cpuMark = 0;
+    Clock::time_point tMark;
+
+    std::atomic<int> switchTo{-1};
+    std::thread player([&] {
+        cpuMark = threadCpuSeconds();
+        tMark = Clock::now();
+        // 分两段跑：play 段结束后由主线程把 playing 置 false 并 stop 当前段
+        for (cur = 0; cur < 2; ++cur) {
+            stop.store(false);
+            loop(&sim, phase[cur], stop);
+            const double c = threadCpuSeconds();
+            const auto t = Clock::now();
+            phase[cur].cpuSeconds = c - cpuMark;
+            phase[cur].seconds = std::chrono::duration<double>(t - tMark).count();
+            cpuMark = c;
+            tMark = t;
+            switchTo.store(cur);
+        }
+    });
+
+    std::this_thread::sleep_for(std::chrono::seconds(playSec));
+    sim.playing.store(false);
+    stop.store(true);
+    sim.ev.notifyAll();
+    while (switchTo.load() < 0) std::this_thread::yield();
+
+    std::this_thread::sleep_for(std::chrono::seconds(pauseSec));
+    stop.store(true);
+    sim.ev.notifyAll();
+    player.join();
+
+    sim.abort.store(true);
+    sim.q.abort();
+    prod.join();
+
+    static const char* kPhase[2] = {"play", "pause"};
+    for (int i = 0; i < 2; ++i) {
+        const PhaseStat& p = phase[i];
+        std::printf("%-7s %-5s cpu=%6.3fs (%5.2f%%)  wakeups=%6.0f/s  shown=%-5lld dropped=%-4lld err avg=%6.0fus max=%lldus\n",
+                    name, kPhase[i], p.cpuSeconds, p.seconds > 0 ? p.cpuSeconds * 100.0 / p.seconds : 0.0,
+                    p.seconds > 0 ? p.wakeups / p.seconds : 0.0, (long long) p.shown, (long long) p.dropped,
+                    p.shown ? p.sumLateUs / p.shown : 0.0, (long long) p.maxLateUs);
+    }
+}
+
+int main(int argc, char** argv) {
+    const int fps      = argc > 1 ? std::atoi(argv[1]) : 30;
+    const int playSec  = argc > 2 ? std::atoi(argv[2]) : 5;
+    const int pauseSec = argc > 3 ? std::atoi(argv[3]) : 2;
+
+    std::printf("fps=%d play=%ds pause=%ds\n", fps, playSec, pauseSec);
+    run("legacy", legacyLoop, fps, playSec, pauseSec);
+    run("event",  eventLoop,  fps, playSec, pauseSec);
+    return 0;
+}
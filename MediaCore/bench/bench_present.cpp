@@ -0,0 +1,282 @@
+// AXPlayerLib/MediaCore/bench/bench_present.cpp
+// 视频呈现调度的无头模拟：按 vsync 时间线回放帧 PTS，对比 AXFrameScheduler 与旧的固定窗口策略
+// （提前 20ms / 落后 120ms、不看下一帧），报告上屏/丢帧数、节奏抖动（judder）与音画偏差。
+// 模型：主时钟 = 首个 vsync 起按倍速线性走；帧在 ready 时刻之后才能取到；提交后在下一个 vsync 上屏，
+// 交换在该 vsync 返回（时刻带少量噪声喂给调度器）。视频线程按返回的等待时长休眠，与 AXPlayer 一致。
+//   judder = 每帧实际停留时长与理想时长（相邻上屏帧的 PTS 差 / 倍速）之差的均方根
+//   |A/V|  = 上屏那个 vsync 时刻主时钟与帧 PTS 之差
+// 用法：bench_present [trace.txt]
+//   不带参数跑内置场景（24/25/30/60fps × 60/90/120/144Hz、倍速、解码卡顿）；
+//   trace 文件逐行：vsync <us> | frame <pts_us> [ready_us] | speed <x>，# 开头为注释。
+// 内置场景下刷新周期估计偏差超过 2% 返回非 0（包括每帧 5 个刷新周期的 24fps@120Hz）。
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "AXFrameScheduler.h"
+
+struct SimFrame {
+    int64_t ptsUs;
+    int64_t readyUs;   // 解码完成（可被取走）的墙钟时刻
+};
+
+struct Trace {
+    std::string name;
+    std::vector<int64_t> vsyncs;   // 墙钟，升序
+    std::vector<SimFrame> frames;  // PTS 升序
+    float speed{1.f};
+    int64_t trueVsyncUs{0};        // 内置场景已知的真实刷新周期（trace 文件为 0，不校验）
+};
+
+struct SimResult {
+    int presented{0};
+    int dropped{0};
+    double judderMs{0};
+    double avMeanMs{0};
+    double avMaxMs{0};
+    double estHz{0};
+};
+
+// 策略接口：与 AXVideoSink::takeDueFrame_ 的用法一致
+struct Policy {
+    virtual ~Policy() = default;
+    virtual const char* name() const = 0;
+    virtual void onFrame(int64_t ptsUs) = 0;
+    virtual void onPresented(int64_t swapUs) = 0;
+    virtual bool wantsNext() const = 0;
+    virtual AXFrameScheduler::Decision decide(int64_t pts, int64_t next, int64_t master, int64_t now) = 0;
+    virtual int64_t vsyncUs() const { return 0; }
+};
+
+struct SchedulerPolicy : Policy {
+    AXFrameScheduler s;
+    explicit SchedulerPolicy(float speed) { s.setSpeed(speed); }
+    const char* name() const override { return "vsync"; }
+    void onFrame(int64_t ptsUs) override { s.onFrame(ptsUs); }
+    void onPresented(int64_t swapUs) override { s.onPresented(swapUs); }
+    bool wantsNext() const override { return true; }
+    AXFrameScheduler::Decision decide(int64_t pts, int64_t next, int64_t master, int64_t now) override {
+        return s.decide(pts, next, master, now);
+    }
+    int64_t vsyncUs() const override { return s.vsyncUs(); }
+};
+
+// 旧实现：提前 20ms 内或落后 120ms 内即呈现，否则等待/丢弃
+struct LegacyPolicy : Policy {
+    const char* name() const override { return "legacy"; }
+    void onFrame(int64_t) override {}
+    void onPresented(int64_t) override {}
+    bool wantsNext() const override { return false; }
+    AXFrameScheduler::Decision decide(int64_t pts, int64_t, int64_t master, int64_t) override {
+        AXFrameScheduler::Decision d;
+        const int64_t diff = pts - master;
+        if (diff > 20'000) {
+            d.action = AXFrameScheduler::Action::Wait;
+            d.waitUs = diff - 20'000;
+        } else if (diff < -120'000) {
+            d.action = AXFrameScheduler::Action::Drop;
+        }
+        return d;
+    }
+};
+
+static SimResult simulate(const Trace& tr, Policy& pol) {
+    SimResult r;
+    if (tr.vsyncs.size() < 2 || tr.frames.empty()) return r;
+    const double sp = tr.speed;
+    const int64_t t0 = tr.vsyncs.front();
+    const int64_t pts0 = tr.frames.front().ptsUs;
+    auto master = [&](int64_t t) { return pts0 + (int64_t) ((double) (t - t0) * sp); };
+
+    struct Shown {
+        int64_t ptsUs;
+        size_t vsync;
+    };
+    std::vector<Shown> shown;
+    size_t qi = 0;          // 下一个可取的帧
+    int pending = -1, next = -1;
+    uint32_t seed = 99;
+    int64_t t = t0;
+    const int64_t end = tr.vsyncs.back();
+
+    auto pop = [&](int& out) {
+        if (qi < tr.frames.size() && tr.frames[qi].readyUs <= t) {
+            out = (int) qi++;
+            pol.onFrame(tr.frames[out].ptsUs);
+            return true;
+        }
+        return false;
+    };
+
+    while (t < end) {
+        if (pending < 0) {
+            pending = next;
+            next = -1;
+            if (pending < 0 && !pop(pending)) {
+                // 没帧：等下一帧解出来
+                if (qi >= tr.frames.size()) break;
+                t = std::max(t + 200, tr.frames[qi].readyUs);
+                continue;
+            }
+        }
+        if (pol.wantsNext() && next < 0) pop(next);
+        const int64_t nextPts = next >= 0 ? tr.frames[next].ptsUs : -1;
+        const AXFrameScheduler::Decision d = pol.decide(tr.frames[pending].ptsUs, nextPts, master(t), t);
+        if (d.action == AXFrameScheduler::Action::Drop) {
+            ++r.dropped;
+            pending = -1;
+            continue;
+        }
+        if (d.action == AXFrameScheduler::Action::Wait) {
+            int64_t wake = t + std::max<int64_t>(200, (int64_t) ((double) d.waitUs / sp));
+            // 视频线程也会被“队列有新帧”唤醒（仅当手上没有预取帧时才有意义）
+            if (pol.wantsNext() && next < 0 && qi < tr.frames.size() && tr.frames[qi].readyUs > t) {
+                wake = std::min(wake, tr.frames[qi].readyUs);
+            }
+            t = wake;
+            continue;
+        }
+        // 上屏：提交后最早的 vsync（留 0.5ms 给上传与绘制）
+        const auto it = std::lower_bound(tr.vsyncs.begin(), tr.vsyncs.end(), t + 500);
+        if (it == tr.vsyncs.end()) break;
+        const size_t k = (size_t) (it - tr.vsyncs.begin());
+        // 同一 vsync 上后提交的帧覆盖先提交的（先提交的那帧实际没上屏）
+        if (!shown.empty() && shown.back().vsync == k) {
+            shown.pop_back();
+            ++r.dropped;
+        }
+        shown.push_back({tr.frames[pending].ptsUs, k});
+        pending = -1;
+        seed = seed * 1664525u + 1013904223u;
+        const int64_t noise = (int64_t) (seed >> 23) - 256;   // 约 ±0.25ms 的返回时刻噪声
+        pol.onPresented(tr.vsyncs[k] + noise);
+        t = tr.vsyncs[k] + 100;
+    }
+
+    r.presented = (int) shown.size();
+    double sq = 0, avSum = 0;
+    int n = 0;
+    for (size_t i = 0; i < shown.size(); ++i) {
+        const double av = std::fabs((double) (shown[i].ptsUs - master(tr.vsyncs[shown[i].vsync]))) / 1000.0;
+        avSum += av;
+        r.avMaxMs = std::max(r.avMaxMs, av);
+        if (i + 1 < shown.size()) {
+            const double onScreen = (double) (tr.vsyncs[shown[i + 1].vsync] - tr.vsyncs[shown[i].vsync]);
+            const double ideal = (double) (shown[i + 1].ptsUs - shown[i].ptsUs) / sp;
+            sq += (onScreen - ideal) * (onScreen - ideal);
+            ++n;
+        }
+    }
+    r.judderMs = n > 0 ? std::sqrt(sq / n) / 1000.0 : 0;
+    r.avMeanMs = shown.empty() ? 0 : avSum / (double) shown.size();
+    const int64_t v = pol.vsyncUs();
+    r.estHz = v > 0 ? 1e6 / (double) v : 0;
+    return r;
+}
+
+static Trace makeTrace(const char* name, double fps, double hz, float speed, int seconds,
+                       int64_t stallAtUs = -1, int64_t stallUs = 0) {
+    Trace tr;
+    tr.name = name;
+    tr.speed = speed;
+    const double vs = 1e6 / hz;
+    tr.trueVsyncUs = (int64_t) std::llround(vs);
+    const int64_t base = 1'000'000;   // 墙钟起点任意
+    const int nv = (int) (seconds * hz);
+    for (int i = 0; i <= nv; ++i) tr.vsyncs.push_back(base + (int64_t) std::llround(i * vs));
+    // 帧：解码领先主时钟 ~100ms；卡顿窗口内的帧要等到卡顿结束才一起就绪
+    const int nf = (int) (seconds * fps * speed);
+    for (int i = 0; i < nf; ++i) {
+        const int64_t pts = (int64_t) std::llround(i * 1e6 / fps);
+        int64_t ready = base + (int64_t) ((double) pts / speed) - 100'000;
+        if (stallAtUs >= 0 && ready >= base + stallAtUs && ready < base + stallAtUs + stallUs) {
+            ready = base + stallAtUs + stallUs;
+        }
+        tr.frames.push_back({pts, std::max<int64_t>(base, ready)});
+    }
+    return tr;
+}
+
+static bool loadTrace(const char* path, Trace& tr) {
+    FILE* fp = std::fopen(path, "r");
+    if (!fp) return false;
+    tr.name = path;
+    char line[256];
+    while (std::fgets(line, sizeof(line), fp)) {
+        if (line[0] == '#' || line[0] == '\n') continue;
+        char kind[16] = {0};
+        long long a = -1, b = -1;
+        double f = 0;
+        if (std::sscanf(line, "%15s", kind) != 1) continue;
+        if (!std::strcmp(kind, "vsync") && std::sscanf(line, "%*s %lld", &a) == 1) {
+            tr.vsyncs.push_back(a);
+        } else if (!std::strcmp(kind, "frame")) {
+            const int got = std::sscanf(line, "%*s %lld %lld", &a, &b);
+            if (got >= 1) tr.frames.push_back({a, got >= 2 ? b : 0});
+        } else if (!std::strcmp(kind, "speed") && std::sscanf(line, "%*s %lf", &f) == 1 && f > 0) {
+            tr.speed = (float) f;
+        }
+    }
+    std::fclose(fp);
+    std::sort(tr.vsyncs.begin(), tr.vsyncs.end());
+    std::sort(tr.frames.begin(), tr.frames.end(), [](const SimFrame& x, const SimFrame& y) { return x.ptsUs < y.ptsUs; });
+    // 没给 ready 的帧视为一开始就已解码
+    for (auto& fr: tr.frames) {
+        if (fr.readyUs <= 0 && !tr.vsyncs.empty()) fr.readyUs = tr.vsyncs.front();
+    }
+    return tr.vsyncs.size() >= 2 && !tr.frames.empty();
+}
+
+static void printRow(const Trace& tr, const char* policy, const SimResult& r) {
+    std::printf("%-22s %-7s presented=%5d dropped=%5d judder=%6.2fms |A/V| mean=%6.2fms max=%7.2fms",
+                tr.name.c_str(), policy, r.presented, r.dropped, r.judderMs, r.avMeanMs, r.avMaxMs);
+    if (r.estHz > 0) std::printf(" est=%.2fHz", r.estHz);
+    std::printf("\n");
+}
+
+int main(int argc, char** argv) {
+    std::vector<Trace> traces;
+    if (argc > 1) {
+        Trace tr;
+        if (!loadTrace(argv[1], tr)) {
+            std::fprintf(stderr, "bad trace: %s\n", argv[1]);
+            return 2;
+        }
+        traces.push_back(std::move(tr));
+    } else {
+        traces.push_back(makeTrace("24fps@60Hz", 24000.0 / 1001.0, 60, 1.f, 10));
+        traces.push_back(makeTrace("25fps@60Hz", 25, 60, 1.f, 10));
+        traces.push_back(makeTrace("30fps@60Hz", 30, 60, 1.f, 10));
+        traces.push_back(makeTrace("60fps@60Hz", 60, 60, 1.f, 10));
+        traces.push_back(makeTrace("30fps@90Hz", 30, 90, 1.f, 10));
+        traces.push_back(makeTrace("24fps@120Hz", 24, 120, 1.f, 10));
+        traces.push_back(makeTrace("24fps@144Hz", 24, 144, 1.f, 10));
+        traces.push_back(makeTrace("30fps@60Hz x1.5", 30, 60, 1.5f, 10));
+        traces.push_back(makeTrace("60fps@60Hz x2", 60, 60, 2.f, 10));
+        traces.push_back(makeTrace("30fps@60Hz stall400ms", 30, 60, 1.f, 10, 3'000'000, 400'000));
+    }
+
+    int errors = 0;
+    for (const Trace& tr: traces) {
+        LegacyPolicy legacy;
+        printRow(tr, legacy.name(), simulate(tr, legacy));
+        SchedulerPolicy sched(tr.speed);
+        const SimResult r = simulate(tr, sched);
+        printRow(tr, sched.name(), r);
+        // 刷新周期估计应收敛到真实值：估计若不是真实周期（也不是其整数倍），预测的 vsync 网格会漂移
+        if (tr.trueVsyncUs > 0) {
+            const double err = r.estHz > 0 ? std::fabs(1e6 / r.estHz - (double) tr.trueVsyncUs) / (double) tr.trueVsyncUs : 1.0;
+            if (err > 0.02) {
+                ++errors;
+                std::printf("  vsync estimate off by %.1f%%  MISMATCH\n", err * 100.0);
+            }
+        }
+    }
+    if (argc <= 1) std::printf("%s\n", errors == 0 ? "PASS" : "FAIL");
+    return errors == 0 ? 0 : 1;
+}
@@ -0,0 +1,112 @@
+// AXPlayerLib/MediaCore/bench/bench_queues.cpp
+// 队列微基准：SpscQueue（无锁环形 + futex 停车） vs BoundedQueue（mutex + condvar）
+// 场景：
+//   burst   —— 生产/消费都全速跑，衡量吞吐与上下文切换
+//   paced   —— 消费者按 60fps 节奏取帧（模拟渲染），衡量空转唤醒
+// 用法：bench_queues [items=2000000] [cap=32]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <sys/resource.h>
+
+#include "AXQueues.h"
+
+using Clock = std::chrono::steady_clock;
+
+struct RunStat {
+    double  seconds{0};
+    long    volCtxSw{0};    // 自愿上下文切换（≈ 停车/唤醒次数）
+    long    involCtxSw{0};
+    double  cpuSeconds{0};
+};
+
+static RunStat sample() {
+    rusage ru{};
+    getrusage(RUSAGE_SELF, &ru);
+    RunStat s;
+    s.volCtxSw   = ru.ru_nvcsw;
+    s.involCtxSw = ru.ru_nivcsw;
+    s.cpuSeconds = ru.ru_utime.tv_sec + ru.ru_stime.tv_sec +
+                   (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) / 1e6;
+    return s;
+}
+
+template <typename Q>
+static RunStat runBurst(size_t items, size_t cap) {
+    Q q(cap);
+    const RunStat r0 = sample();
+    const auto t0 = Clock::now();
+
+    std::thread prod([&] {
+        for (size_t i = 1; i <= items; ++i) {
+            if (!q.push(reinterpret_cast<void*>(i))) break;
+        }
+    });
+    size_t got = 0, sum = 0;
+    void* v = nullptr;
+    while (got < items && q.pop(v)) {
+        sum += reinterpret_cast<size_t>(v);
+        ++got;
+    }
+    prod.join();
+
+    const RunStat r1 = sample();
+    RunStat out;
+    out.seconds    = std::chrono::duration<double>(Clock::now() - t0).count();
+    out.volCtxSw   = r1.volCtxSw - r0.volCtxSw;
+    out.involCtxSw = r1.involCtxSw - r0.involCtxSw;
+    out.cpuSeconds = r1.cpuSeconds - r0.cpuSeconds;
+    if (sum != items * (items + 1) / 2) std::fprintf(stderr, "!!! checksum mismatch\n");
+    return out;
+}
+
+template <typename Q>
+static RunStat runPaced(int frames, size_t cap) {
+    Q q(cap);
+    const RunStat r0 = sample();
+    const auto t0 = Clock::now();
+
+    std::thread prod([&] {
+        for (int i = 1; i <= frames; ++i) {
+            if (!q.push(reinterpret_cast<void*>((uintptr_t) i))) break;
+        }
+    });
+    auto next = Clock::now();
+    void* v = nullptr;
+    for (int i = 0; i < frames; ++i) {
+        next += std::chrono::microseconds(16667);
+        std::this_thread::sleep_until(next);
+        if (!q.tryPop(v, std::chrono::milliseconds(5))) break;
+    }
+    q.abort();
+    prod.join();
+
+    const RunStat r1 = sample();
+    RunStat out;
+    out.seconds    = std::chrono::duration<double>(Clock::now() - t0).count();
+    out.volCtxSw   = r1.volCtxSw - r0.volCtxSw;
+    out.involCtxSw = r1.involCtxSw - r0.involCtxSw;
+    out.cpuSeconds = r1.cpuSeconds - r0.cpuSeconds;
+    return out;
+}
+
+static void print(const char* name, const char* scenario, size_t ops, const RunStat& s) {
+    std::printf("%-12s %-6s ops=%-9zu time=%8.3fs  %8.2f Mops/s  %7.1f ns/op  cpu=%6.3fs  vcsw=%-8ld ivcsw=%ld\n",
+                name, scenario, ops, s.seconds, ops / s.seconds / 1e6, s.seconds * 1e9 / ops,
+                s.cpuSeconds, s.volCtxSw, s.involCtxSw);
+}
+
+int main(int argc, char** argv) {
+    const size_t items = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+    const size_t cap   = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 32;
+    const int    paced = 180; // 3 秒 @60fps
+
+    std::printf("items=%zu cap=%zu\n", items, cap);
+    print("Bounded", "burst", items, runBurst<BoundedQueue<void*>>(items, cap));
+    print("Spsc",    "burst", items, runBurst<SpscQueue<void*>>(items, cap));
+    print("Bounded", "paced", paced, runPaced<BoundedQueue<void*>>(paced, cap));
+    print("Spsc",    "paced", paced, runPaced<SpscQueue<void*>>(paced, cap));
+    return 0;
+}
@@ -0,0 +1,108 @@
+// AXPlayerLib/MediaCore/bench/bench_soundtouch.cpp
+// SoundTouch 时伸基准：与 AXAudioRenderer 相同的用法（按解码帧粒度 put、立即 receive），
+// 在 0.25x~4x 下统计处理速度（实时倍数）、输出时长误差，以及 PTS 估算误差：
+// 每段输出首帧 PTS = 已送入的输入末端 - (未处理输入 + 待取输出 × tempo)，与理想值 outPos × tempo / rate 比较。
+// 同一源码由 CMake 编出 bench_soundtouch（SIMD）与 bench_soundtouch_nosimd 两个版本，在同一设备上对比。
+// 用法：bench_soundtouch [seconds=20] [rate=48000] [channels=2]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <type_traits>
+#include <vector>
+
+#include <SoundTouch.h>
+
+using Clock = std::chrono::steady_clock;
+using Sample = soundtouch::SAMPLETYPE;
+
+static constexpr double kPi = 3.14159265358979323846;
+
+#if defined(SOUNDTOUCH_DISABLE_X86_OPTIMIZATIONS)
+static const char* kBuild = "nosimd";
+#else
+static const char* kBuild = "simd";
+#endif
+
+static Sample toSample(float v) {
+    if (std::is_floating_point<Sample>::value) return (Sample) v;
+    return (Sample) std::lrint(v * 32767.f);
+}
+
+// 音乐化的测试信号：几路谐波 + 慢速包络，避免纯正弦让相关搜索过于“轻松”
+static std::vector<Sample> makeSignal(int frames, int rate, int ch) {
+    std::vector<Sample> s((size_t) frames * ch);
+    for (int i = 0; i < frames; ++i) {
+        const double t = (double) i / rate;
+        const double env = 0.6 + 0.4 * std::sin(2 * kPi * 0.7 * t);
+        for (int c = 0; c < ch; ++c) {
+            const double f = 220.0 * (1 + c * 0.25);
+            const double v = env * (0.5 * std::sin(2 * kPi * f * t) + 0.25 * std::sin(2 * kPi * 2.01 * f * t)
+                                    + 0.1 * std::sin(2 * kPi * 5.3 * f * t));
+            s[(size_t) i * ch + c] = toSample((float) (v * 0.8));
+        }
+    }
+    return s;
+}
+
+struct Result {
+    double cpuSec{0};
+    int64_t outFrames{0};
+    int64_t maxPtsErrUs{0};
+};
+
+static Result run(const std::vector<Sample>& in, int rate, int ch, float tempo) {
+    soundtouch::SoundTouch st;
+    st.setSampleRate((uint) rate);
+    st.setChannels((uint) ch);
+    st.setTempo(tempo);
+    st.setSetting(SETTING_USE_QUICKSEEK, 1);   // 与播放器一致
+
+    const int frames = (int) (in.size() / ch);
+    const int chunk = 1024;                    // 典型 AAC 帧
+    std::vector<Sample> out((size_t) 16384 * ch);
+
+    Result res;
+    int64_t inEndFrames = 0;
+    const auto t0 = Clock::now();
+    for (int off = 0; off < frames; off += chunk) {
+        const int n = std::min(chunk, frames - off);
+        st.putSamples(in.data() + (size_t) off * ch, (uint) n);
+        inEndFrames += n;
+        while (st.numSamples() > 0) {
+            const double buffered = st.numUnprocessedSamples() + (double) st.numSamples() * tempo;
+            const int64_t estUs = (int64_t) ((inEndFrames - buffered) * 1e6 / rate);
+            const int64_t idealUs = (int64_t) ((double) res.outFrames * tempo * 1e6 / rate);
+            res.maxPtsErrUs = std::max<int64_t>(res.maxPtsErrUs, std::llabs(estUs - idealUs));
+
+            const uint got = st.receiveSamples(out.data(), (uint) (out.size() / ch));
+            if (got == 0) break;
+            res.outFrames += got;
+        }
+    }
+    res.cpuSec = std::chrono::duration<double>(Clock::now() - t0).count();
+    return res;
+}
+
+int main(int argc, char** argv) {
+    const int seconds = argc > 1 ? std::atoi(argv[1]) : 20;
+    const int rate    = argc > 2 ? std::atoi(argv[2]) : 48000;
+    const int ch      = argc > 3 ? std::atoi(argv[3]) : 2;
+
+    const std::vector<Sample> in = makeSignal(seconds * rate, rate, ch);
+    std::printf("soundtouch %s build=%s sample=%s seconds=%d rate=%d ch=%d\n",
+                soundtouch::SoundTouch::getVersionString(), kBuild,
+                std::is_floating_point<Sample>::value ? "f32" : "s16", seconds, rate, ch);
+
+    const float tempos[] = {0.25f, 0.5f, 0.75f, 1.25f, 1.5f, 2.0f, 3.0f, 4.0f};
+    for (float tempo : tempos) {
+        const Result r = run(in, rate, ch, tempo);
+        const double expected = (double) in.size() / ch / tempo;
+        std::printf("tempo=%.2f  %7.1fx realtime  cpu=%6.3fs  out=%lld (%.2f%% of ideal)  max pts err=%lldus\n",
+                    tempo, seconds / r.cpuSec, r.cpuSec, (long long) r.outFrames,
+                    r.outFrames * 100.0 / expected, (long long) r.maxPtsErrUs);
+    }
+    return 0;
+}
@@ -0,0 +1,217 @@
+// AXPlayerLib/MediaCore/bench/bench_startup.cpp
+// 起播耗时基准：用播放器同一套 AXDemuxer + AXDecoder，把“打开到出第一帧”拆成四段：
+//   open    avformat_open_input（连接 + 读容器头）
+//   probe   find_stream_info / 快速打开的判定 / 缓存回填
+//   decoder 解码器打开（avcodec_open2 等）
+//   first   启动读包与解码线程 → 第一帧出解码器
+// 配置：default（FFmpeg 默认探测）、bounded（限制 probesize / analyzeduration）、fast-open（MP4/MKV 跳过探测）、
+//      cache-cold（空缓存目录，探测后写缓存）、cache-warm（命中缓存）。每种跑多次取中位数；
+// 先空跑一次把文件读进页缓存，各配置比的是探测本身而不是冷盘 IO。
+// 校验：每种配置都能出第一帧；选中的音视频流与 default 一致（流序号、codec、视频尺寸）；cache-warm 确实命中缓存。
+// 采样率/声道不比：HE-AAC 的 SBR/PS 只有解码后才知道，头里的值本来就可能与探测结果不同，渲染端按帧参数重采样。
+// 最后输出一行 RESULT key=value，便于 CI 抓取比对。
+// 用法：bench_startup <file> [runs=5]
+// 任一校验失败时返回非 0。
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include <dirent.h>
+#include <unistd.h>
+
+#include "AXDemuxer.h"
+#include "AXDecoder.h"
+#include "AXQueues.h"
+
+static constexpr int64_t kBoundedProbeSize = 512 * 1024;
+static constexpr int64_t kBoundedAnalyzeUs = 500'000;
+
+// 选中流的关键参数：各配置必须一致
+struct Layout {
+    int audioStream{-1}, videoStream{-1};
+    int aCodec{0}, vCodec{0};
+    int width{0}, height{0};
+
+    bool operator==(const Layout& o) const {
+        return audioStream == o.audioStream && videoStream == o.videoStream && aCodec == o.aCodec &&
+               vCodec == o.vCodec && width == o.width && height == o.height;
+    }
+};
+
+struct Sample {
+    bool ok{false};
+    int64_t openUs{0}, probeUs{0}, decoderUs{0}, firstUs{0};
+    AXOpenTiming::Probe probe{AXOpenTiming::Probe::Full};
+    Layout layout;
+
+    int64_t totalUs() const { return openUs + probeUs + decoderUs + firstUs; }
+};
+
+static Sample runOnce(const std::string& path, const AXOpenOptions& opts) {
+    Sample s;
+    AXDemuxer demux;
+    demux.setOpenOptions(opts);
+    DemuxResult info;
+    if (!demux.open(path, {}, info)) return s;
+    s.openUs = demux.openTiming().openInputUs;
+    s.probeUs = demux.openTiming().probeUs;
+    s.probe = demux.openTiming().probe;
+
+    AVFormatContext* fmt = demux.fmt();
+    s.layout.audioStream = info.audioStream;
+    s.layout.videoStream = info.videoStream;
+    if (info.audioStream >= 0) {
+        s.layout.aCodec = fmt->streams[info.audioStream]->codecpar->codec_id;
+    }
+    if (info.videoStream >= 0) {
+        s.layout.vCodec = fmt->streams[info.videoStream]->codecpar->codec_id;
+        s.layout.width = info.width;
+        s.layout.height = info.height;
+    }
+
+    // 第一帧按播放器的呈现路径算：有视频看视频，纯音频看音频；另一路的包直接丢
+    const bool video = info.videoStream >= 0;
+    const int idx = video ? info.videoStream : info.audioStream;
+    const AVRational tb = video ? info.vTimeBase : info.aTimeBase;
+    PacketQueue pktQ(1024);
+    FrameQueue frmQ(video ? 32 : 64);
+    pktQ.setTimeBase(tb);
+
+    int64_t t0 = axStampNowUs();
+    AXDecoder dec;
+    if (!dec.open(fmt->streams[idx]->codecpar, tb, video)) return s;
+    s.decoderUs = axStampNowUs() - t0;
+    dec.setPacketQueue(&pktQ);
+    dec.setFrameQueue(&frmQ);
+
+    t0 = axStampNowUs();
+    demux.start(video ? nullptr : &pktQ, video ? &pktQ : nullptr);
+    dec.start();
+    AVFrame* frm = nullptr;
+    if (frmQ.tryPop(frm, std::chrono::seconds(10)) && frm) {
+        s.firstUs = axStampNowUs() - t0;
+        s.ok = true;
+        axFrameFree(&frm);
+    }
+    demux.stop();
+    dec.stop();
+    return s;
+}
+
+static int64_t median(std::vector<int64_t> v) {
+    if (v.empty()) return 0;
+    std::sort(v.begin(), v.end());
+    return v[v.size() / 2];
+}
+
+struct Row {
+    std::string name;
+    Sample med;
+    AXOpenTiming::Probe probe{AXOpenTiming::Probe::Full};
+    bool ok{true};
+    Layout layout;
+};
+
+static Row runConfig(const char* name, const std::string& path, const AXOpenOptions& opts, int runs) {
+    Row row;
+    row.name = name;
+    std::vector<int64_t> open, probe, decoder, first;
+    for (int i = 0; i < runs; ++i) {
+        const Sample s = runOnce(path, opts);
+        if (!s.ok) {
+            row.ok = false;
+            continue;
+        }
+        open.push_back(s.openUs);
+        probe.push_back(s.probeUs);
+        decoder.push_back(s.decoderUs);
+        first.push_back(s.firstUs);
+        row.probe = s.probe;   // 取最后一次（cache-warm 应每次都命中）
+        row.layout = s.layout;
+    }
+    row.med.openUs = median(open);
+    row.med.probeUs = median(probe);
+    row.med.decoderUs = median(decoder);
+    row.med.firstUs = median(first);
+    std::printf("%-11s open %7.2f  probe %7.2f (%-6s)  decoder %6.2f  first %7.2f  total %7.2f ms%s\n", name,
+                row.med.openUs / 1000.0, row.med.probeUs / 1000.0, AXDemuxer::probeName(row.probe),
+                row.med.decoderUs / 1000.0, row.med.firstUs / 1000.0, row.med.totalUs() / 1000.0,
+                row.ok ? "" : "  FAILED");
+    return row;
+}
+
+static void removeDir(const std::string& dir) {
+    if (DIR* d = opendir(dir.c_str())) {
+        while (dirent* e = readdir(d)) {
+            if (std::strcmp(e->d_name, ".") && std::strcmp(e->d_name, "..")) unlink((dir + "/" + e->d_name).c_str());
+        }
+        closedir(d);
+    }
+    rmdir(dir.c_str());
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <file> [runs=5]\n", argv[0]);
+        return 2;
+    }
+    const std::string file = argv[1];
+    const int runs = argc > 2 ? std::max(1, std::atoi(argv[2])) : 5;
+
+    char tmpl[] = "/tmp/axsi_XXXXXX";
+    const char* cacheDir = mkdtemp(tmpl);
+    if (!cacheDir) {
+        std::printf("mkdtemp failed\nFAIL\n");
+        return 1;
+    }
+
+    // 预热页缓存
+    runOnce(file, AXOpenOptions{});
+
+    AXOpenOptions bounded;
+    bounded.probeSize = kBoundedProbeSize;
+    bounded.analyzeDurationUs = kBoundedAnalyzeUs;
+    AXOpenOptions fast;
+    fast.fastOpen = true;
+    AXOpenOptions cached;
+    cached.cacheDir = cacheDir;
+
+    std::printf("%s: %d run(s) per config, medians\n", file.c_str(), runs);
+    std::vector<Row> rows;
+    rows.push_back(runConfig("default", file, AXOpenOptions{}, runs));
+    rows.push_back(runConfig("bounded", file, bounded, runs));
+    rows.push_back(runConfig("fast-open", file, fast, runs));
+    rows.push_back(runConfig("cache-cold", file, cached, 1));
+    rows.push_back(runConfig("cache-warm", file, cached, runs));
+    removeDir(cacheDir);
+
+    int errors = 0;
+    for (const Row& r : rows) {
+        if (!r.ok) ++errors;
+        if (!(r.layout == rows.front().layout)) {
+            ++errors;
+            std::printf("  %s: stream layout differs from default  MISMATCH\n", r.name.c_str());
+        }
+    }
+    if (rows[3].probe != AXOpenTiming::Probe::Full) {
+        ++errors;
+        std::printf("  cache-cold: expected a full probe  MISMATCH\n");
+    }
+    if (rows[4].probe != AXOpenTiming::Probe::Cached) {
+        ++errors;
+        std::printf("  cache-warm: cache not hit  MISMATCH\n");
+    }
+
+    std::printf("RESULT default_ms=%.2f bounded_ms=%.2f fast_ms=%.2f fast_probe=%s cache_warm_ms=%.2f "
+                "default_probe_ms=%.2f cache_probe_ms=%.2f\n",
+                rows[0].med.totalUs() / 1000.0, rows[1].med.totalUs() / 1000.0, rows[2].med.totalUs() / 1000.0,
+                AXDemuxer::probeName(rows[2].probe), rows[4].med.totalUs() / 1000.0, rows[0].med.probeUs / 1000.0,
+                rows[4].med.probeUs / 1000.0);
+    std::printf("%s\n", errors == 0 ? "PASS" : "FAIL");
+    return errors == 0 ? 0 : 1;
+}
@@ -0,0 +1,123 @@
+// AXPlayerLib/MediaCore/bench/bench_thumbs.cpp
+// AXThumbnailer 基准/校验（无头）：
+//   1) 关键帧索引：耗时、条目数、来源（容器索引 / 扫包）；
+//   2) 均匀取 N 张缩略图，三种配置各跑一次并给出 thumbs/s：
+//        exact   1 线程：正常解码到目标帧（对照）
+//        key     1 线程：只解关键帧 + 跳过环路滤波
+//        key     N 线程：同上，多个解码实例并行
+//   校验：每张都成功、尺寸不超过上限、像素缓冲大小正确；关键帧模式的 PTS 不晚于目标（首个关键帧之前的目标除外）；
+//        单线程与多线程的关键帧结果逐字节一致（同一关键帧、同一套解码参数）。
+// 最后输出一行 RESULT key=value，便于 CI 抓取比对。
+// 用法：bench_thumbs <file> [count=20] [workers=0(自动)]
+// 任一校验失败时返回非 0。
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "AXThumbnailer.h"
+
+using Clock = std::chrono::steady_clock;
+
+static constexpr int kMaxW = 160;
+static constexpr int kMaxH = 90;
+
+struct Run {
+    const char* name{""};
+    double ms{0};
+    std::vector<AXThumbnail> thumbs{};
+};
+
+static int check(const Run& run, int64_t firstKeyUs, bool keyframeOnly) {
+    int errors = 0;
+    for (size_t i = 0; i < run.thumbs.size(); ++i) {
+        const AXThumbnail& t = run.thumbs[i];
+        const char* bad = nullptr;
+        if (t.ptsUs < 0) bad = "missing";
+        else if (t.width <= 0 || t.height <= 0 || t.width > kMaxW || t.height > kMaxH) bad = "size";
+        else if (t.rgba.size() != (size_t) t.width * t.height * 4) bad = "buffer";
+        else if (keyframeOnly && t.ptsUs > t.targetUs && t.targetUs >= firstKeyUs) bad = "after target";
+        if (bad) {
+            ++errors;
+            std::printf("  %s #%zu target=%lld pts=%lld %dx%d  MISMATCH (%s)\n", run.name, i,
+                        (long long) t.targetUs, (long long) t.ptsUs, t.width, t.height, bad);
+        }
+    }
+    return errors;
+}
+
+static bool runExtract(AXThumbnailer& th, Run& run, int count, int workers, bool exact) {
+    AXThumbnailer::Options o;
+    o.count = count;
+    o.maxWidth = kMaxW;
+    o.maxHeight = kMaxH;
+    o.workers = workers;
+    o.exact = exact;
+    const auto t0 = Clock::now();
+    const bool ok = th.extract(o, run.thumbs);
+    run.ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    const int w = run.thumbs.empty() ? 0 : run.thumbs.front().width;
+    const int h = run.thumbs.empty() ? 0 : run.thumbs.front().height;
+    std::printf("%-12s %3d thumbs %dx%d in %8.1f ms  -> %7.1f thumbs/s\n", run.name, count, w, h, run.ms,
+                run.ms > 0 ? count * 1000.0 / run.ms : 0.0);
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <file> [count=20] [workers=0]\n", argv[0]);
+        return 2;
+    }
+    const std::string file = argv[1];
+    const int count = argc > 2 ? std::max(1, std::atoi(argv[2])) : 20;
+    const int workers = argc > 3 ? std::max(0, std::atoi(argv[3])) : 0;
+
+    AXThumbnailer th(file);
+    if (!th.open()) {
+        std::printf("open failed: %s\nFAIL\n", file.c_str());
+        return 1;
+    }
+    std::printf("%s: %dx%d, %.2f s\n", file.c_str(), th.width(), th.height(), th.durationUs() / 1e6);
+
+    // 先跑对照（此时没有索引，不合并位置），再建索引
+    Run exact{"exact x1"};
+    int errors = 0;
+    if (!runExtract(th, exact, count, 1, true)) ++errors;
+    errors += check(exact, 0, false);
+
+    std::vector<AXKeyframe> index;
+    bool fromContainer = false;
+    const auto t0 = Clock::now();
+    if (!th.buildIndex(index, &fromContainer)) ++errors;
+    const double indexMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    std::printf("keyframe index: %zu entries (%s) in %.1f ms", index.size(), fromContainer ? "container" : "scan", indexMs);
+    if (index.size() > 1) {
+        std::printf(", mean GOP %.2f s", (index.back().ptsUs - index.front().ptsUs) / 1e6 / (index.size() - 1));
+    }
+    std::printf("\n");
+    const int64_t firstKeyUs = index.empty() ? 0 : index.front().ptsUs;
+
+    Run key1{"key x1"};
+    if (!runExtract(th, key1, count, 1, false)) ++errors;
+    errors += check(key1, firstKeyUs, true);
+
+    Run keyN{"key xN"};
+    if (!runExtract(th, keyN, count, workers, false)) ++errors;
+    errors += check(keyN, firstKeyUs, true);
+
+    for (size_t i = 0; i < key1.thumbs.size() && i < keyN.thumbs.size(); ++i) {
+        if (key1.thumbs[i].ptsUs != keyN.thumbs[i].ptsUs || key1.thumbs[i].rgba != keyN.thumbs[i].rgba) {
+            ++errors;
+            std::printf("  #%zu differs between 1 and N workers  MISMATCH\n", i);
+        }
+    }
+
+    auto rate = [count](const Run& r) { return r.ms > 0 ? count * 1000.0 / r.ms : 0.0; };
+    std::printf("RESULT index_ms=%.1f index_entries=%zu index_container=%d exact_tps=%.1f key1_tps=%.1f keyN_tps=%.1f\n",
+                indexMs, index.size(), fromContainer ? 1 : 0, rate(exact), rate(key1), rate(keyN));
+    std::printf("%s\n", errors == 0 ? "PASS" : "FAIL");
+    return errors == 0 ? 0 : 1;
+}
@@ -0,0 +1,34 @@
+#!/bin/bash
+set -euo pipefail
+
+# 按 axbench_corpus.txt 生成 axbench 语料（需要带 libx264/libx265/libsvtav1/libvpx/libopus/libmp3lame 的 ffmpeg）
+# 用法：MediaCore/bench/make_corpus.sh <输出目录> [秒数=10]
+# 已存在的文件会跳过；清单一并拷到输出目录，供 axbench --corpus <输出目录> 使用。
+
+BENCH_DIR="$(cd "$(dirname "$0")" && pwd)"
+MANIFEST="$BENCH_DIR/axbench_corpus.txt"
+OUT_DIR="${1:?usage: $0 <out-dir> [seconds]}"
+SECONDS_LEN="${2:-10}"
+FFMPEG="${FFMPEG:-ffmpeg}"
+
+mkdir -p "$OUT_DIR"
+cp "$MANIFEST" "$OUT_DIR/axbench_corpus.txt"
+
+while read -r name file size args; do
+  [[ -z "$name" || "$name" == \#* ]] && continue
+  out="$OUT_DIR/$file"
+  if [[ -f "$out" ]]; then
+    echo "skip $name (exists)"
+    continue
+  fi
+  echo "==> $name"
+  inputs=()
+  if [[ "$size" != "-" ]]; then
+    inputs+=(-f lavfi -i "testsrc2=size=${size}:rate=30:duration=${SECONDS_LEN}")
+  fi
+  inputs+=(-f lavfi -i "sine=frequency=440:sample_rate=48000:duration=${SECONDS_LEN},aformat=channel_layouts=stereo")
+  # shellcheck disable=SC2086  # args 需要按空格拆开
+  "$FFMPEG" -hide_banner -loglevel error -y "${inputs[@]}" $args -shortest "$out"
+done < "$MANIFEST"
+
+echo "corpus ready: $OUT_DIR"
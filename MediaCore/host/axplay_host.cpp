@@ -0,0 +1,208 @@
+// AXPlayerLib/MediaCore/host/axplay_host.cpp
+// 主机无头播放器：用真实的 AXPlayer 流水线（demux → decode → 队列 → 同步）播放文件，
+// 音频走 null / WAV / 假 DAC sink，视频走帧哈希（可选落盘 YUV），结束时打印吞吐与哈希。
+// 用法：axplay_host <file> [--audio null|dac|wav:<path>] [--video hash|yuv:<path>]
+//                         [--speed 1.0] [--seconds N] [--seek ms[:fast|:nearest|:scrub]] [--trace out.json]
+//                         [--probesize bytes] [--analyze ms] [--fast-open] [--cache <dir>]
+// null 音频 sink 不限速，配合 null 视频（hash）即可测整条流水线的极限吞吐；
+// dac 按墙钟节拍拉数据，行为与真机一致，适合查 A/V 同步。
+// --seek 在开播后立即 seek（默认精确，:fast 为前一关键帧，:nearest 为最近关键帧，:scrub 为拖动预览），结束时打印 seek 后首帧耗时。
+// --probesize / --analyze 限制探测读入量，--fast-open 对 MP4/MKV 跳过探测，--cache 启用探测结果磁盘缓存（见 AXOpenOptions）。
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+
+#include "AXPlayer.h"
+#include "AXAudioSink.h"
+#include "AXFrameDumpSink.h"
+#include "AXTrace.h"
+
+using Clock = std::chrono::steady_clock;
+
+class HostCallback : public AXPlayerCallback {
+public:
+    void onPrepared() override { signal_(prepared_); }
+
+    void onCompletion() override { signal_(completed_); }
+
+    void onBuffering(int) override {}
+
+    void onVideoSizeChanged(int w, int h, int sarNum, int sarDen) override {
+        std::fprintf(stderr, "video size %dx%d sar=%d/%d\n", w, h, sarNum, sarDen);
+    }
+
+    void onError(int what, int extra, const std::string &msg) override {
+        std::fprintf(stderr, "error what=%d extra=%d: %s\n", what, extra, msg.c_str());
+        signal_(failed_);
+    }
+
+    // 等到 prepared/completed/failed 之一或超时；返回是否失败
+    bool waitPrepared(std::chrono::milliseconds timeout) {
+        std::unique_lock<std::mutex> lk(mtx_);
+        cv_.wait_for(lk, timeout, [this] { return prepared_ || failed_; });
+        return prepared_ && !failed_;
+    }
+
+    void waitDone(std::chrono::milliseconds timeout) {
+        std::unique_lock<std::mutex> lk(mtx_);
+        cv_.wait_for(lk, timeout, [this] { return completed_ || failed_; });
+    }
+
+    bool failed() {
+        std::lock_guard<std::mutex> lk(mtx_);
+        return failed_;
+    }
+
+private:
+    void signal_(bool &flag) {
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            flag = true;
+        }
+        cv_.notify_all();
+    }
+
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    bool prepared_{false};
+    bool completed_{false};
+    bool failed_{false};
+};
+
+static void usage(const char *argv0) {
+    std::fprintf(stderr,
+                 "usage: %s <file> [--audio null|dac|wav:<path>] [--video hash|yuv:<path>]"
+                 " [--speed X] [--seconds N] [--seek ms[:fast|:nearest|:scrub]] [--trace <out.json>]"
+                 " [--probesize bytes] [--analyze ms] [--fast-open] [--cache <dir>]\n", argv0);
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        usage(argv[0]);
+        return 2;
+    }
+    std::string src = argv[1];
+    std::string audio = "null";
+    std::string video = "hash";
+    float speed = 1.f;
+    int seconds = 0;   // 0 = 播完为止
+    std::string tracePath;   // 需 -DAX_TRACE=ON
+    int64_t seekMs = -1;
+    AXPlayer::SeekMode seekMode = AXPlayer::SeekMode::Accurate;
+    AXOpenOptions openOpts;
+    for (int i = 2; i < argc; ++i) {
+        const bool hasVal = i + 1 < argc;
+        if (!std::strcmp(argv[i], "--audio") && hasVal) audio = argv[++i];
+        else if (!std::strcmp(argv[i], "--video") && hasVal) video = argv[++i];
+        else if (!std::strcmp(argv[i], "--speed") && hasVal) speed = (float) std::atof(argv[++i]);
+        else if (!std::strcmp(argv[i], "--seconds") && hasVal) seconds = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--trace") && hasVal) tracePath = argv[++i];
+        else if (!std::strcmp(argv[i], "--probesize") && hasVal) openOpts.probeSize = std::atoll(argv[++i]);
+        else if (!std::strcmp(argv[i], "--analyze") && hasVal) openOpts.analyzeDurationUs = std::atoll(argv[++i]) * 1000;
+        else if (!std::strcmp(argv[i], "--fast-open")) openOpts.fastOpen = true;
+        else if (!std::strcmp(argv[i], "--cache") && hasVal) openOpts.cacheDir = argv[++i];
+        else if (!std::strcmp(argv[i], "--seek") && hasVal) {
+            const std::string v = argv[++i];
+            seekMs = std::atoll(v.c_str());
+            if (v.size() > 5 && v.compare(v.size() - 5, 5, ":fast") == 0) seekMode = AXPlayer::SeekMode::Fast;
+            if (v.size() > 6 && v.compare(v.size() - 6, 6, ":scrub") == 0) seekMode = AXPlayer::SeekMode::Scrub;
+            if (v.size() > 8 && v.compare(v.size() - 8, 8, ":nearest") == 0) seekMode = AXPlayer::SeekMode::NearestKey;
+        }
+        else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    AXAudioSinkFactory audioFactory;
+    if (audio == "null") {
+        audioFactory = [] { return axCreateNullAudioSink(); };
+    } else if (audio == "dac") {
+        audioFactory = [] { return axCreateFakeDacAudioSink(); };
+    } else if (audio.rfind("wav:", 0) == 0) {
+        const std::string path = audio.substr(4);
+        audioFactory = [path] { return axCreateWavAudioSink(path); };
+    } else {
+        usage(argv[0]);
+        return 2;
+    }
+
+    std::string yuvPath;
+    if (video.rfind("yuv:", 0) == 0) yuvPath = video.substr(4);
+    else if (video != "hash") {
+        usage(argv[0]);
+        return 2;
+    }
+    // 播放器持有 sink；这里只留观察指针，在播放器析构前读统计
+    AXFrameDumpSink *dump = nullptr;
+
+    if (!tracePath.empty()) {
+        if (!AX_ENABLE_TRACE) std::fprintf(stderr, "--trace ignored: built without -DAX_TRACE=ON\n");
+        AXTrace::start();
+    }
+
+    auto cb = std::make_shared<HostCallback>();
+    int rc = 0;
+    {
+        AXPlayer player(cb);
+        player.setAudioSinkFactory(audioFactory);
+        player.setVideoSinkFactory([&dump, yuvPath] {
+            auto s = std::make_unique<AXFrameDumpSink>(yuvPath);
+            dump = s.get();
+            return std::unique_ptr<AXVideoSink>(std::move(s));
+        });
+        player.setOpenOptions(openOpts);
+        player.setDataSource(src, {});
+
+        const auto t0 = Clock::now();
+        player.prepareAsync();
+        if (!cb->waitPrepared(std::chrono::seconds(30))) {
+            std::fprintf(stderr, "prepare failed\n");
+            return 1;
+        }
+        const auto tPrepared = Clock::now();
+        player.setSpeed(speed);
+        player.start();
+        if (seekMs >= 0) player.seekTo(seekMs, seekMode);
+        cb->waitDone(seconds > 0 ? std::chrono::milliseconds(seconds * 1000LL)
+                                 : std::chrono::milliseconds(24LL * 3600 * 1000));
+        const double wallSec = std::chrono::duration<double>(Clock::now() - tPrepared).count();
+        const double posSec = player.getCurrentPositionMs() / 1000.0;
+        if (cb->failed()) rc = 1;
+
+        std::printf("source=%s audio=%s video=%s speed=%.2f\n", src.c_str(), audio.c_str(), video.c_str(), speed);
+        std::printf("prepare=%.1fms play wall=%.3fs position=%.3fs (%.2fx realtime)\n",
+                    std::chrono::duration<double, std::milli>(tPrepared - t0).count(), wallSec, posSec,
+                    wallSec > 0 ? posSec / wallSec : 0.0);
+        const AXHistogramStats first = player.getStatistics().firstFrameUs;
+        if (first.count > 0) std::printf("first frame=%.1fms after prepareAsync (poster)\n", first.max / 1000.0);
+        if (seekMs >= 0) {
+            const AXHistogramStats ttff = player.getStatistics().seekFirstFrameUs;
+            std::printf("seek=%lldms (%s) first frame after %.1fms%s\n", (long long) seekMs,
+                        seekMode == AXPlayer::SeekMode::Fast ? "fast" :
+                        seekMode == AXPlayer::SeekMode::Scrub ? "scrub" :
+                        seekMode == AXPlayer::SeekMode::NearestKey ? "nearest" : "accurate", ttff.max / 1000.0,
+                        ttff.count > 0 ? "" : " (no frame presented)");
+        }
+        if (dump) {
+            const AXFrameDumpSink::Stats st = dump->stats();
+            std::printf("video frames=%lld dropped=%lld %dx%d fmt=%d pts=[%lld, %lld]us (%.1f fps)\n",
+                        (long long) st.frames, (long long) st.dropped, st.width, st.height, st.format,
+                        (long long) st.firstPtsUs, (long long) st.lastPtsUs,
+                        wallSec > 0 ? st.frames / wallSec : 0.0);
+            std::printf("video lastHash=%016llx seqHash=%016llx\n",
+                        (unsigned long long) st.lastHash, (unsigned long long) st.seqHash);
+        }
+        dump = nullptr;
+    }
+    if (!tracePath.empty()) {
+        AXTrace::stop();
+        if (AXTrace::dump(tracePath.c_str())) std::printf("trace=%s\n", tracePath.c_str());
+    }
+    return rc;
+}
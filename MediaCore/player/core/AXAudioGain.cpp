@@ -0,0 +1,305 @@
+//AXPlayerLib/MediaCore/player/core/AXAudioGain.cpp
+
+#include "AXAudioGain.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define AX_GAIN_NEON 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define AX_GAIN_X86 1
+#endif
+
+#define AX_LOG_TAG "AXAudioGain"
+#include "AXLog.h"
+
+namespace axgain {
+
+int16_t toQ15(float g) {
+    const long q = std::lrint(std::clamp(g, 0.f, 1.f) * 32768.f);
+    return (int16_t) std::min(q, 32767L);
+}
+
+// ======================= 标量（参考实现） =======================
+// S16 与向量版逐位一致：(x * g + 2^14) >> 15（即 mulhrs / vqrdmulh 的定义）
+static inline int16_t mulQ15(int16_t x, int16_t g) {
+    return (int16_t) (((int32_t) x * g + (1 << 14)) >> 15);
+}
+
+static void f32Scalar(float *p, int64_t n, int ch, const float *pat) {
+    int k = 0;
+    for (int64_t i = 0; i < n; ++i) {
+        p[i] *= pat[k];
+        if (++k == ch) k = 0;
+    }
+}
+
+static void s16Scalar(int16_t *p, int64_t n, int ch, const int16_t *pat) {
+    int k = 0;
+    for (int64_t i = 0; i < n; ++i) {
+        p[i] = mulQ15(p[i], pat[k]);
+        if (++k == ch) k = 0;
+    }
+}
+
+// 尾部：块起点处图样下标为 0，因此 pat[j] 直接可用（j < 块长）
+static inline void f32Tail(float *p, int64_t n, const float *pat) {
+    for (int64_t j = 0; j < n; ++j) p[j] *= pat[j];
+}
+
+static inline void s16Tail(int16_t *p, int64_t n, const int16_t *pat) {
+    for (int64_t j = 0; j < n; ++j) p[j] = mulQ15(p[j], pat[j]);
+}
+
+#if AX_GAIN_NEON
+// ======================= NEON（arm64 / armv7a） =======================
+// 一块 = 4 帧（F32）/ 8 帧（S16），恰好是 ch 个寄存器，图样寄存器在循环外装好
+static void f32Neon(float *p, int64_t n, int ch, const float *pat) {
+    float32x4_t g[AXAudioGain::kMaxChannels];
+    for (int v = 0; v < ch; ++v) g[v] = vld1q_f32(pat + 4 * v);
+    const int64_t blk = 4LL * ch;
+    int64_t i = 0;
+    for (; i + blk <= n; i += blk) {
+        for (int v = 0; v < ch; ++v) {
+            float *q = p + i + 4 * v;
+            vst1q_f32(q, vmulq_f32(vld1q_f32(q), g[v]));
+        }
+    }
+    f32Tail(p + i, n - i, pat);
+}
+
+static void s16Neon(int16_t *p, int64_t n, int ch, const int16_t *pat) {
+    int16x8_t g[AXAudioGain::kMaxChannels];
+    for (int v = 0; v < ch; ++v) g[v] = vld1q_s16(pat + 8 * v);
+    const int64_t blk = 8LL * ch;
+    int64_t i = 0;
+    for (; i + blk <= n; i += blk) {
+        for (int v = 0; v < ch; ++v) {
+            int16_t *q = p + i + 8 * v;
+            vst1q_s16(q, vqrdmulhq_s16(vld1q_s16(q), g[v]));
+        }
+    }
+    s16Tail(p + i, n - i, pat);
+}
+#endif
+
+#if AX_GAIN_X86
+// ======================= SSE / AVX2（x86_64 模拟器与主机） =======================
+// F32 用 SSE（x86_64 基线）；S16 的 mulhrs 需要 SSSE3；AVX2 按运行时 CPUID 选择
+static void f32Sse(float *p, int64_t n, int ch, const float *pat) {
+    __m128 g[AXAudioGain::kMaxChannels];
+    for (int v = 0; v < ch; ++v) g[v] = _mm_loadu_ps(pat + 4 * v);
+    const int64_t blk = 4LL * ch;
+    int64_t i = 0;
+    for (; i + blk <= n; i += blk) {
+        for (int v = 0; v < ch; ++v) {
+            float *q = p + i + 4 * v;
+            _mm_storeu_ps(q, _mm_mul_ps(_mm_loadu_ps(q), g[v]));
+        }
+    }
+    f32Tail(p + i, n - i, pat);
+}
+
+__attribute__((target("ssse3")))
+static void s16Sse(int16_t *p, int64_t n, int ch, const int16_t *pat) {
+    __m128i g[AXAudioGain::kMaxChannels];
+    for (int v = 0; v < ch; ++v) g[v] = _mm_loadu_si128((const __m128i *) (pat + 8 * v));
+    const int64_t blk = 8LL * ch;
+    int64_t i = 0;
+    for (; i + blk <= n; i += blk) {
+        for (int v = 0; v < ch; ++v) {
+            __m128i *q = (__m128i *) (p + i + 8 * v);
+            _mm_storeu_si128(q, _mm_mulhrs_epi16(_mm_loadu_si128(q), g[v]));
+        }
+    }
+    s16Tail(p + i, n - i, pat);
+}
+
+__attribute__((target("avx2")))
+static void f32Avx2(float *p, int64_t n, int ch, const float *pat) {
+    __m256 g[AXAudioGain::kMaxChannels];
+    for (int v = 0; v < ch; ++v) g[v] = _mm256_loadu_ps(pat + 8 * v);
+    const int64_t blk = 8LL * ch;
+    int64_t i = 0;
+    for (; i + blk <= n; i += blk) {
+        for (int v = 0; v < ch; ++v) {
+            float *q = p + i + 8 * v;
+            _mm256_storeu_ps(q, _mm256_mul_ps(_mm256_loadu_ps(q), g[v]));
+        }
+    }
+    f32Tail(p + i, n - i, pat);
+}
+
+__attribute__((target("avx2")))
+static void s16Avx2(int16_t *p, int64_t n, int ch, const int16_t *pat) {
+    __m256i g[AXAudioGain::kMaxChannels];
+    for (int v = 0; v < ch; ++v) g[v] = _mm256_loadu_si256((const __m256i *) (pat + 16 * v));
+    const int64_t blk = 16LL * ch;
+    int64_t i = 0;
+    for (; i + blk <= n; i += blk) {
+        for (int v = 0; v < ch; ++v) {
+            __m256i *q = (__m256i *) (p + i + 16 * v);
+            _mm256_storeu_si256(q, _mm256_mulhrs_epi16(_mm256_loadu_si256(q), g[v]));
+        }
+    }
+    s16Tail(p + i, n - i, pat);
+}
+#endif
+
+static const Kernels kScalar{Isa::Scalar, "scalar", &f32Scalar, &s16Scalar};
+#if AX_GAIN_NEON
+static const Kernels kNeon{Isa::Neon, "neon", &f32Neon, &s16Neon};
+#endif
+#if AX_GAIN_X86
+static const Kernels kSse{Isa::Sse, "sse", &f32Sse, &s16Sse};
+static const Kernels kAvx2{Isa::Avx2, "avx2", &f32Avx2, &s16Avx2};
+#endif
+
+const Kernels *kernelsFor(Isa isa) {
+    switch (isa) {
+        case Isa::Scalar:
+            return &kScalar;
+#if AX_GAIN_NEON
+        case Isa::Neon:
+            return &kNeon;
+#endif
+#if AX_GAIN_X86
+        case Isa::Sse:
+            return __builtin_cpu_supports("ssse3") ? &kSse : nullptr;
+        case Isa::Avx2:
+            return __builtin_cpu_supports("avx2") ? &kAvx2 : nullptr;
+#endif
+        default:
+            return nullptr;
+    }
+}
+
+const Kernels &best() {
+    static const Kernels *k = [] {
+        for (Isa isa : {Isa::Avx2, Isa::Sse, Isa::Neon}) {
+            if (const Kernels *c = kernelsFor(isa)) return c;
+        }
+        return &kScalar;
+    }();
+    return *k;
+}
+
+} // namespace axgain
+
+// ======================= AXAudioGain =======================
+const char *AXAudioGain::isaName() {
+    return axgain::best().name;
+}
+
+bool AXAudioGain::configure(Format fmt, int channels, int sampleRate) {
+    fmt_ = fmt;
+    if (channels <= 0 || channels > kMaxChannels) {
+        AX_LOGE("unsupported channel count %d (max %d), gain bypassed", channels, kMaxChannels);
+        ch_ = 0;
+        return false;
+    }
+    ch_ = channels;
+    rampLen_ = std::max(1, sampleRate * kRampMs / 1000);
+    // 重新配置（新流/新设备）不做过渡：直接落到目标增益
+    for (int c = 0; c < kMaxChannels; ++c) {
+        cur_[c] = target_[c];
+        step_[c] = 0.f;
+    }
+    rampLeft_ = 0;
+    rebuildPatterns_();
+    AX_LOGI("configured: %s x%d, ramp %d frames, isa=%s",
+            fmt == Format::F32 ? "f32" : "s16", channels, rampLen_, isaName());
+    return true;
+}
+
+void AXAudioGain::setGains(const float *gains, int n) {
+    if (!gains || n <= 0) return;
+    float fill = 0.f;
+    for (int c = 0; c < n && c < kMaxChannels; ++c) fill = std::max(fill, gains[c]);
+
+    bool changed = false;
+    for (int c = 0; c < kMaxChannels; ++c) {
+        const float g = std::clamp(c < n ? gains[c] : fill, 0.f, 1.f);
+        if (g != target_[c]) {
+            target_[c] = g;
+            changed = true;
+        }
+    }
+    if (!changed) return;
+
+    if (ch_ > 0) {
+        // 从当前（可能仍在过渡中的）增益出发，重新开始一段过渡
+        for (int c = 0; c < kMaxChannels; ++c) step_[c] = (target_[c] - cur_[c]) / (float) rampLen_;
+        rampLeft_ = rampLen_;
+    } else {
+        for (int c = 0; c < kMaxChannels; ++c) cur_[c] = target_[c];
+    }
+    rebuildPatterns_();
+}
+
+void AXAudioGain::setStereoVolume(float left, float right) {
+    const float g[2] = {left, right};
+    setGains(g, 2);
+}
+
+void AXAudioGain::rebuildPatterns_() {
+    unity_ = true;
+    for (int c = 0; c < ch_; ++c) {
+        if (std::fabs(target_[c] - 1.f) > 1e-4f) unity_ = false;
+    }
+    if (ch_ <= 0) return;
+    for (int i = 0; i < ch_ * 8; ++i) patF32_[i] = target_[i % ch_];
+    for (int i = 0; i < ch_ * 16; ++i) patQ15_[i] = axgain::toQ15(target_[i % ch_]);
+}
+
+// 过渡段：逐帧累加增益（每次 volume 变化只有 kRampMs，标量即可）
+void AXAudioGain::rampFrames_(uint8_t *data, int frames) {
+    if (fmt_ == Format::F32) {
+        float *p = reinterpret_cast<float *>(data);
+        for (int n = 0; n < frames; ++n, p += ch_) {
+            for (int c = 0; c < ch_; ++c) {
+                cur_[c] += step_[c];
+                p[c] *= cur_[c];
+            }
+        }
+    } else {
+        int16_t *p = reinterpret_cast<int16_t *>(data);
+        for (int n = 0; n < frames; ++n, p += ch_) {
+            for (int c = 0; c < ch_; ++c) {
+                cur_[c] += step_[c];
+                const long v = std::lrint((float) p[c] * cur_[c]);
+                p[c] = (int16_t) std::clamp(v, -32768L, 32767L);
+            }
+        }
+    }
+}
+
+void AXAudioGain::process(void *data, int frames) {
+    if (!data || frames <= 0 || ch_ <= 0) return;
+    uint8_t *p = static_cast<uint8_t *>(data);
+
+    if (rampLeft_ > 0) {
+        const int n = std::min(frames, rampLeft_);
+        rampFrames_(p, n);
+        rampLeft_ -= n;
+        if (rampLeft_ == 0) {
+            // 消除累加误差：过渡结束时精确落到目标
+            for (int c = 0; c < kMaxChannels; ++c) cur_[c] = target_[c];
+        }
+        frames -= n;
+        p += (size_t) n * ch_ * (fmt_ == Format::F32 ? sizeof(float) : sizeof(int16_t));
+        if (frames <= 0) return;
+    }
+
+    if (unity_) return;
+    const axgain::Kernels &k = axgain::best();
+    const int64_t samples = (int64_t) frames * ch_;
+    if (fmt_ == Format::F32) {
+        k.f32(reinterpret_cast<float *>(p), samples, ch_, patF32_);
+    } else {
+        k.s16(reinterpret_cast<int16_t *>(p), samples, ch_, patQ15_);
+    }
+}
@@ -1,14 +1,18 @@
 //AXPlayerLib/MediaCore/player/core/AXAudioRenderer.cpp
 #include "AXAudioRenderer.h"
+#include "AXTrace.h"
 
 #include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <ctime>
 #include <limits>
 #include <thread>
+#include <type_traits>
 
-#if defined(AX_WITH_OBOE)
-
-#include <oboe/Oboe.h>
-
+#if __has_include(<SoundTouch.h>)
+#include <SoundTouch.h>
+#define AX_HAS_SOUNDTOUCH 1
 #endif
 
 using namespace std::chrono;
@@ -35,6 +39,12 @@ static inline AVSampleFormat pickOutFormat(bool preferFloat) {
     return preferFloat ? AV_SAMPLE_FMT_FLT : AV_SAMPLE_FMT_S16;
 }
 
+static inline int64_t nowMonoNs() {
+    timespec ts{};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t) ts.tv_sec * 1'000'000'000LL + ts.tv_nsec;
+}
+
 static inline AVChannelLayout layoutForChannels(int ch) {
     AVChannelLayout l{};
     switch (ch) {
@@ -56,303 +66,142 @@ static inline AVChannelLayout layoutForChannels(int ch) {
     return l;
 }
 
-// ======================= PcmFifo =======================
-AXAudioRenderer::PcmFifo::PcmFifo(size_t maxFrames) : capFrames_(maxFrames) {}
-
-void AXAudioRenderer::PcmFifo::clear() {
-    std::lock_guard<std::mutex> lk(m_);
-    q_.clear();
-    framesSum_ = 0;
-}
-
-void AXAudioRenderer::PcmFifo::push(const PcmChunk &c) {
-    std::lock_guard<std::mutex> lk(m_);
-    // 简单防溢策略：超出上限就丢队尾（最新数据更重要）
-    if (framesSum_ + c.frames > (int64_t) capFrames_) {
-        int64_t drop = framesSum_ + c.frames - (int64_t) capFrames_;
-        while (drop > 0 && !q_.empty()) {
-            auto &back = q_.back();
-            drop -= back.frames;
-            framesSum_ -= back.frames;
-            q_.pop_back();
-        }
-    }
-    q_.push_back(c);
-    framesSum_ += c.frames;
-}
-
-int32_t AXAudioRenderer::PcmFifo::popInterleaved(void *dst, int32_t frames, int32_t bpf,
-                                                 int64_t &outPtsUs) {
-    std::lock_guard<std::mutex> lk(m_);
-    int32_t need = frames;
-    uint8_t *wr = static_cast<uint8_t *>(dst);
-    outPtsUs = -1;
-    while (need > 0 && !q_.empty()) {
-        auto &f = q_.front();
-        if (outPtsUs < 0 && f.ptsUs >= 0) outPtsUs = f.ptsUs;
-        int32_t take = std::min(need, f.frames);
-        int32_t bytes = take * bpf;
-        std::memcpy(wr, f.bytes.data(), bytes);
-        wr += bytes;
-        need -= take;
-        framesSum_ -= take;
-
-        if (take < f.frames) {
-            // 剩余部分回写（简单起见，直接擦除已拷部分）
-            f.bytes.erase(f.bytes.begin(), f.bytes.begin() + bytes);
-            f.frames -= take;
-            f.ptsUs = (f.ptsUs >= 0) ? (f.ptsUs + (int64_t) (1'000'000LL * take / std::max(1,
-                                                                                           bpf /
-                                                                                           (int) sizeof(float))))
-                                     : -1;
-        } else {
-            q_.pop_front();
-        }
-    }
-    // 不足则补零
-    int32_t filled = frames - need;
-    if (need > 0) {
-        std::memset(wr, 0, need * bpf);
-    }
-    return filled;
-}
-
-int64_t AXAudioRenderer::PcmFifo::framesAvailable() const {
-    std::lock_guard<std::mutex> lk(m_);
-    return framesSum_;
-}
-
-int64_t AXAudioRenderer::PcmFifo::durationUs(int sampleRate) const {
-    std::lock_guard<std::mutex> lk(m_);
-    if (sampleRate <= 0) return 0;
-    return (int64_t) (framesSum_ * 1'000'000LL / sampleRate);
-}
-
-// ======================= OboeSink =======================
-class AXAudioRenderer::OboeSink
-#if defined(AX_WITH_OBOE)
-        : public oboe::AudioStreamCallback
-#endif
-{
+// ======================= TimeStretch =======================
+// SoundTouch 时伸（变速不变调）。输入/输出都是设备格式的交织 PCM；
+// SoundTouch 的 SAMPLETYPE 与设备格式一致时不做任何转换（常见：F32），否则经 conv_ 转一次
+class AXAudioRenderer::TimeStretch {
 public:
-    explicit OboeSink(AXAudioRenderer *owner) : owner_(owner) {}
-
-    bool open() {
-#if !defined(AX_WITH_OBOE)
-        AX_LOGE("Oboe backend not enabled at build time");
-    return false;
+    bool configure(int rate, int channels, bool isFloat) {
+#if !defined(AX_HAS_SOUNDTOUCH)
+        AX_LOGW("SoundTouch not available at build time; speed != 1 plays at 1x");
+        (void) rate; (void) channels; (void) isFloat;
+        return false;
 #else
-        using namespace oboe;
-
-        AudioStreamBuilder b;
-        b.setDirection(Direction::Output);
-        b.setPerformanceMode(PerformanceMode::LowLatency);
-        b.setSharingMode(SharingMode::Exclusive);
-        b.setUsage(Usage::Media);
-        b.setContentType(ContentType::Music);
-
-        // 优先 F32，失败再回退
-        bool preferFloat = true;
-        b.setFormat(AudioFormat::Float);
-        b.setCallback(this);
-
-        // 让系统选最优采样率/通道（若你想强制 8ch，可先 setChannelCount(8) 再失败降级）
-        // 这里采用“先申请 8→6→2”的策略
-        static const int kTryCh[] = {2, 6, 8};
-        AudioStream *tmp = nullptr;
-        Result r = Result::OK;
-        for (int ch: kTryCh) {
-            b.setChannelCount(ch);
-            r = b.openStream(&tmp);
-            if (r == Result::OK) {
-                stream_.reset(tmp);
-                break;
-            }
-        }
-        if (!stream_) {
-            // 回退 2ch + I16
-            preferFloat = false;
-            b.setFormat(AudioFormat::I16);
-            b.setChannelCount(2);
-            r = b.openStream(&tmp);
-            if (r == Result::OK) stream_.reset(tmp);
-        }
-        if (!stream_) {
-            AX_LOGE("Oboe openStream failed: %s", convertToText(r));
-            return false;
-        }
-
-        // 拿到最终参数
-        actualRate_ = stream_->getSampleRate();
-        actualChannels_ = stream_->getChannelCount();
-        actualIsFloat_ = (stream_->getFormat() == AudioFormat::Float);
-        framesPerBurst_ = stream_->getFramesPerBurst();
-
-        AX_LOGI("Oboe opened: rate=%d, ch=%d, fmt=%s, burst=%d, perf=%d, share=%d",
-                actualRate_, actualChannels_, actualIsFloat_ ? "F32" : "S16",
-                framesPerBurst_, (int) stream_->getPerformanceMode(),
-                (int) stream_->getSharingMode());
-
-        // 启动
-        r = stream_->requestStart();
-        if (r != Result::OK) {
-            AX_LOGE("Oboe requestStart failed: %s", convertToText(r));
-            stream_.reset();
-            return false;
-        }
-        started_.store(true, std::memory_order_release);
+        rate_ = rate;
+        ch_ = channels;
+        isFloat_ = isFloat;
+        st_.setSampleRate((uint) rate);
+        st_.setChannels((uint) channels);
+        st_.setTempo(1.0);
+        tempo_ = 1.f;
+        // 4x 时每秒要做 4 倍的相关搜索：用快速搜索把移动端 CPU 控制在常数级
+        st_.setSetting(SETTING_USE_QUICKSEEK, 1);
+        st_.clear();
         return true;
 #endif
     }
 
-    bool startStream() {
-#if defined(AX_WITH_OBOE)
-        if (stream_) return stream_->requestStart() == oboe::Result::OK;
+    void setTempo(float t) {
+#if defined(AX_HAS_SOUNDTOUCH)
+        if (t == tempo_) return;
+        tempo_ = t;
+        st_.setTempo(t);
 #endif
-        return false;
     }
 
-    bool stopStream() {
-#if defined(AX_WITH_OBOE)
-        if (stream_) {
-            (void) stream_->requestStop();
-            return true;
+    float tempo() const { return tempo_; }
+
+    void put(const uint8_t *data, int frames) {
+#if defined(AX_HAS_SOUNDTOUCH)
+        if (frames <= 0) return;
+        if (kNative(isFloat_)) {
+            st_.putSamples(reinterpret_cast<const soundtouch::SAMPLETYPE *>(data), (uint) frames);
+            return;
         }
+        const size_t n = (size_t) frames * ch_;
+        if (conv_.size() < n) conv_.resize(n);
+        for (size_t i = 0; i < n; ++i) conv_[i] = toSample_(data, i);
+        st_.putSamples(conv_.data(), (uint) frames);
+#else
+        (void) data; (void) frames;
 #endif
-        return false;
     }
 
-    void resetBase() { baseSet_.store(false, std::memory_order_release); }
-
-    void close() {
-#if defined(AX_WITH_OBOE)
-        if (stream_) {
-            (void) stream_->requestStop();
-            stream_.reset();
-        }
+    int available() const {
+#if defined(AX_HAS_SOUNDTOUCH)
+        return (int) st_.numSamples();
+#else
+        return 0;
 #endif
-        started_.store(false, std::memory_order_release);
-        baseSet_.store(false, std::memory_order_release);
     }
 
-    bool started() const { return started_.load(std::memory_order_acquire); }
-
-    int sampleRate() const { return actualRate_; }
-
-    int channels() const { return actualChannels_; }
-
-    bool isFloat() const { return actualIsFloat_; }
-
-    int framesPerBurst() const { return framesPerBurst_; }
-
-    void setVolume(float l, float r) {
-//#if defined(AX_WITH_OBOE)
-//            if (stream_) {
-//                // Oboe 没有左右声道独立音量，使用 master gain
-//                float g = std::max(l, r);
-//                (void) stream_->setVolume(g);
-//            }
-//#endif
-//            (void)l; (void)r;
+    // 取最多 maxFrames 帧到 dst（设备格式）；返回帧数
+    int receive(uint8_t *dst, int maxFrames) {
+#if defined(AX_HAS_SOUNDTOUCH)
+        if (maxFrames <= 0) return 0;
+        if (kNative(isFloat_)) {
+            return (int) st_.receiveSamples(reinterpret_cast<soundtouch::SAMPLETYPE *>(dst), (uint) maxFrames);
+        }
+        const size_t cap = (size_t) maxFrames * ch_;
+        if (conv_.size() < cap) conv_.resize(cap);
+        const int got = (int) st_.receiveSamples(conv_.data(), (uint) maxFrames);
+        for (size_t i = 0; i < (size_t) got * ch_; ++i) fromSample_(dst, i, conv_[i]);
+        return got;
+#else
+        (void) dst; (void) maxFrames;
+        return 0;
+#endif
     }
 
-    // 取播放头时间戳（CLOCK_MONOTONIC）。返回 true 则 outPtsUs 有效。
-    bool getClockUs(int64_t &outPtsUs) {
-#if !defined(AX_WITH_OBOE)
-        return false;
+    // SoundTouch 内部尚未输出的媒体时长：未处理的输入 + 已处理待取的输出 × tempo
+    int64_t bufferedMediaUs() const {
+#if defined(AX_HAS_SOUNDTOUCH)
+        if (rate_ <= 0) return 0;
+        const double frames = (double) st_.numUnprocessedSamples() + (double) st_.numSamples() * tempo_;
+        return (int64_t) (frames * 1e6 / rate_);
 #else
-        if (!stream_) return false;
-
-        // 设备时间戳：framePosition & timeNanos
-        int64_t framePos = 0;
-        int64_t timeNs = 0;
-        auto r = stream_->getTimestamp(CLOCK_MONOTONIC, &framePos, &timeNs);
-        if (r != oboe::Result::OK) return false;
-
-        // 建立首帧播放时的媒体 PTS 基准（外部通过 owner_->basePtsUs_ 传入）
-        int64_t basePts = owner_->basePtsUs_.load(std::memory_order_acquire);
-        if (basePts < 0) return false;
-
-        if (!baseSet_.load(std::memory_order_acquire)) {
-            baseFramePos_ = framePos;
-            baseTimeNs_ = timeNs;
-            baseSet_.store(true, std::memory_order_release);
-        }
-
-        // 注意：framePos 是“已播放到 DAC 的帧数”
-        const int rate = std::max(1, actualRate_);
-        int64_t framesDiff = (framePos - baseFramePos_);
-        outPtsUs = basePts + framesDiff * 1'000'000LL / rate;
-        return true;
+        return 0;
 #endif
     }
 
-#if defined(AX_WITH_OBOE)
+    // 流结束：把内部残留处理完（尾部补静音）
+    void flush() {
+#if defined(AX_HAS_SOUNDTOUCH)
+        st_.flush();
+#endif
+    }
 
-    // ========== 回调：从 FIFO 取数据 ==========
-    oboe::DataCallbackResult
-    onAudioReady(oboe::AudioStream *, void *audioData, int32_t numFrames) override {
-        if (!owner_) return oboe::DataCallbackResult::Stop;
+    void clear() {
+#if defined(AX_HAS_SOUNDTOUCH)
+        st_.clear();
+#endif
+    }
 
-        const int bpf = bytesPerFrameOf(owner_->outFormat_, owner_->outChannels_);
-        // ★ 暂停：写静音，不动 FIFO，不刷新任何时钟
-        if (owner_->paused_.load(std::memory_order_acquire)) {
-            std::memset(audioData, 0, numFrames * bpf);
-            return oboe::DataCallbackResult::Continue;
-        }
-        int64_t ptsUs = -1;
-        int32_t filled = owner_->fifo_.popInterleaved(audioData, numFrames, bpf, ptsUs);
+private:
+#if defined(AX_HAS_SOUNDTOUCH)
+    static constexpr bool kNative(bool isFloat) {
+        return isFloat == std::is_floating_point<soundtouch::SAMPLETYPE>::value;
+    }
 
-        if (filled < numFrames) {
-            // 欠载，补零
-            std::memset((uint8_t *) audioData + filled * bpf, 0, (numFrames - filled) * bpf);
-            owner_->underrunCnt_.fetch_add(1, std::memory_order_relaxed);
+    soundtouch::SAMPLETYPE toSample_(const uint8_t *data, size_t i) const {
+        if (isFloat_) {
+            // 设备 F32、SoundTouch 整数样本（软浮点 ABI）
+            const float v = reinterpret_cast<const float *>(data)[i];
+            return (soundtouch::SAMPLETYPE) std::clamp(std::lrint(v * 32768.f), -32768L, 32767L);
         }
-        // 更新基准：当我们第一次把真实数据送到 DAC 时，用该块的 PTS 作为 basePts
-        if (ptsUs >= 0 && owner_->basePtsUs_.load(std::memory_order_acquire) < 0) {
-            owner_->basePtsUs_.store(ptsUs, std::memory_order_release);
-        }
-        // 更新时间戳（用于上层查询）
-        int64_t clk;
-        if (getClockUs(clk)) {
-            owner_->lastPtsUs_.store(clk, std::memory_order_release);
-            owner_->active_.store(true, std::memory_order_release);
-        }
-        return oboe::DataCallbackResult::Continue;
+        return (soundtouch::SAMPLETYPE) (reinterpret_cast<const int16_t *>(data)[i] * (1.f / 32768.f));
     }
 
-    void onErrorAfterClose(oboe::AudioStream *, oboe::Result r) override {
-        AX_LOGE("Oboe onErrorAfterClose: %s", oboe::convertToText(r));
-        // 让上层感知非活跃，必要时触发重建
-        owner_->active_.store(false, std::memory_order_release);
-        owner_->basePtsUs_.store(-1, std::memory_order_release);
+    void fromSample_(uint8_t *dst, size_t i, soundtouch::SAMPLETYPE v) const {
+        if (isFloat_) {
+            reinterpret_cast<float *>(dst)[i] = (float) v * (1.f / 32768.f);
+        } else {
+            reinterpret_cast<int16_t *>(dst)[i] =
+                    (int16_t) std::clamp(std::lrint((float) v * 32768.f), -32768L, 32767L);
+        }
     }
 
+    soundtouch::SoundTouch st_;
+    std::vector<soundtouch::SAMPLETYPE> conv_;
+    int rate_{0};
+    int ch_{0};
+    bool isFloat_{true};
 #endif
-
-private:
-    AXAudioRenderer *owner_{nullptr};
-#if defined(AX_WITH_OBOE)
-    std::unique_ptr<oboe::AudioStream> stream_;
-#endif
-    std::atomic<bool> started_{false};
-
-    // 播放头基准
-    std::atomic<bool> baseSet_{false};
-    int64_t baseFramePos_{0};
-    int64_t baseTimeNs_{0};
-
-    // 实参
-    int actualRate_{48000};
-    int actualChannels_{2};
-    bool actualIsFloat_{true};
-    int framesPerBurst_{192};
+    float tempo_{1.f};
 };
 
 // ======================= AXAudioRenderer =======================
-AXAudioRenderer::AXAudioRenderer()
-        : fifo_(48000 * 4) // FIFO 上限 ~4 秒（48k 单声道），足够抗抖
-{
+AXAudioRenderer::AXAudioRenderer() {
     av_channel_layout_uninit(&inChLayout_);
     av_channel_layout_uninit(&outChLayout_);
 }
@@ -362,30 +211,44 @@ AXAudioRenderer::~AXAudioRenderer() {
 }
 
 bool AXAudioRenderer::init() {
-#if !defined(AX_WITH_OBOE)
-    AX_LOGE("AXAudioRenderer built WITHOUT Oboe. Please enable AX_WITH_OBOE and add MediaCore/oboe.");
-return false;
-#else
     if (sink_) {
         AX_LOGW("AXAudioRenderer::init called twice");
         return true;
     }
-    sink_ = std::make_unique<OboeSink>(this);
-    if (!sink_->open()) {
-        AX_LOGE("OboeSink open failed");
+    sink_ = sinkFactory_ ? sinkFactory_() : axCreateDefaultAudioSink();
+    if (!sink_ || !sink_->open(this)) {
+        AX_LOGE("audio sink open failed");
         sink_.reset();
         return false;
     }
-    outRate_ = sink_->sampleRate();
-    outChannels_ = sink_->channels();
-    outFormat_ = pickOutFormat(sink_->isFloat());
+    const AXAudioSink::Params &p = sink_->params();
+    outRate_ = p.sampleRate;
+    outChannels_ = p.channels;
+    outFormat_ = pickOutFormat(p.isFloat);
     outChLayout_ = layoutForChannels(outChannels_);
-    AX_LOGI("Audio out params: rate=%d ch=%d fmt=%s",
-            outRate_, outChannels_, outFormat_ == AV_SAMPLE_FMT_FLT ? "F32" : "S16");
+
+    // 回调启动前按最终参数分配 FIFO（约 1 秒），回调里只做无锁读
+    if (!fifo_.configure(outRate_, bytesPerFrameOf(outFormat_, outChannels_), outRate_)) {
+        sink_->close();
+        sink_.reset();
+        return false;
+    }
+    gain_.configure(outFormat_ == AV_SAMPLE_FMT_FLT ? AXAudioGain::Format::F32 : AXAudioGain::Format::S16,
+                    outChannels_, outRate_);
+    stretch_ = std::make_unique<TimeStretch>();
+    if (!stretch_->configure(outRate_, outChannels_, outFormat_ == AV_SAMPLE_FMT_FLT)) stretch_.reset();
+    stInEndUs_ = -1;
+    AX_LOGI("Audio out params: sink=%s rate=%d ch=%d fmt=%s",
+            sink_->name(), outRate_, outChannels_, outFormat_ == AV_SAMPLE_FMT_FLT ? "F32" : "S16");
 
     resetClock_();
+    if (!sink_->start()) {
+        sink_->close();
+        sink_.reset();
+        return false;
+    }
+    sinkStarted_.store(true, std::memory_order_release);
     return true;
-#endif
 }
 
 bool AXAudioRenderer::start() {
@@ -393,40 +256,47 @@ bool AXAudioRenderer::start() {
         AX_LOGE("start() called before init()");
         return false;
     }
-    // Oboe 已在 open 时 requestStart，这里只置位
+    // sink 已在 init 时启动，这里只置位
     active_.store(true, std::memory_order_release);
     return true;
 }
 
 void AXAudioRenderer::pause(bool on) {
     paused_.store(on, std::memory_order_release);
-#if defined(AX_WITH_OBOE)
     if (sink_) {
         if (on) {
-            (void) sink_->stopStream();
-            sink_->resetBase();     // 让下次 getTimestamp 重建 frame 基准
+            sink_->stop();
+            requestAnchorReset_();     // 让下次回调重建播放头基准
         } else {
-            sink_->resetBase();
-            (void) sink_->startStream();
+            requestAnchorReset_();
+            (void) sink_->start();
         }
     }
-#endif
     if (on) {
         fifo_.clear();   // 不把暂停前的音频残留带到恢复后
-        resetClock_();   // basePtsUs_ = -1, lastPtsUs_ = -1
+        resetClock_();   // 锚点作废, lastPtsUs_ = -1
     }
 }
 
+void AXAudioRenderer::hold() {
+    // 与 pause(true) 的区别：不停 sink、不清 FIFO
+    paused_.store(true, std::memory_order_release);
+    requestAnchorReset_();
+}
+
 void AXAudioRenderer::stop() {
+    sinkStarted_.store(false, std::memory_order_release);
     if (sink_) {
         sink_->close();
     }
+    requestAnchorReset_();
     active_.store(false, std::memory_order_release);
 }
 
 void AXAudioRenderer::release() {
     stop();
     fifo_.clear();
+    logCopyStats_();
 
     if (swr_) {
         swr_free(&swr_);
@@ -434,28 +304,160 @@ void AXAudioRenderer::release() {
     }
     av_channel_layout_uninit(&inChLayout_);
     av_channel_layout_uninit(&outChLayout_);
+    stretch_.reset();
+    stInEndUs_ = -1;
     sink_.reset();
 }
 
+void AXAudioRenderer::flush() {
+    flushReq_.store(true, std::memory_order_release);
+    fifo_.clear();   // 任意线程可调；回调立即不再读到旧样本
+    resetClock_();
+}
+
+void AXAudioRenderer::setMuted(bool on) {
+    muted_.store(on, std::memory_order_release);
+    if (on) {
+        fifo_.clear();
+        resetClock_();
+    }
+}
+
+void AXAudioRenderer::dropConverterState_() {
+    // swr 内部缓冲的旧样本无法单独清掉：释放后按下一帧参数重建
+    if (swr_) swr_free(&swr_);
+    swr_ = nullptr;
+    inFmt_ = AV_SAMPLE_FMT_NONE;
+    if (stretch_) stretch_->clear();
+    stInEndUs_ = -1;
+}
+
 void AXAudioRenderer::setSpeed(float spd) {
     if (spd <= 0.f) spd = 1.f;
-    speed_ = std::min(4.f, std::max(0.25f, spd));
-    // 若启用 SoundTouch，这里会更新 tempo；我们在 convertAndQueue_ 里按需处理
+    // 只记录目标值；喂料线程在下一帧时切换 SoundTouch tempo
+    speed_.store(std::min(4.f, std::max(0.25f, spd)), std::memory_order_relaxed);
 }
 
 void AXAudioRenderer::setVolume(float left, float right) {
-    volL_ = std::clamp(left, 0.f, 1.f);
-    volR_ = std::clamp(right, 0.f, 1.f);
+    // 只记录目标值；喂料线程在下一次写 FIFO 时交给 gain_ 做过渡
+    volL_.store(std::clamp(left, 0.f, 1.f), std::memory_order_relaxed);
+    volR_.store(std::clamp(right, 0.f, 1.f), std::memory_order_relaxed);
 //        if (sink_) sink_->setVolume(volL_, volR_);
 }
 
+// 每秒音频的内存拷贝量：生产侧 swr 直写 FIFO 不产生拷贝，唯一一次拷贝发生在 FIFO → 回调缓冲
+void AXAudioRenderer::logCopyStats_() {
+    const int64_t frames = pcmFramesQueued_.exchange(0, std::memory_order_relaxed);
+    const int64_t device = pcmBytesToDevice_.exchange(0, std::memory_order_relaxed);
+    if (frames <= 0 || outRate_ <= 0) return;
+    const double sec = (double) frames / outRate_;
+    AX_LOGI("pcm copy stats: %.1fs audio, copied %.0f B per audio second, underruns=%d overflows=%d",
+            sec, device / sec,
+            underrunCnt_.load(std::memory_order_relaxed), overflowCnt_.load(std::memory_order_relaxed));
+}
+
 int64_t AXAudioRenderer::lastRenderedPtsUs() const {
     return lastPtsUs_.load(std::memory_order_acquire);
 }
 
 void AXAudioRenderer::resetClock_() {
-    lastPtsUs_.store(-1, std::memory_order_release);
-    basePtsUs_.store(-1, std::memory_order_release);
+    // 先作废锚点再清播放头：与 publishClock_ 的“写后复查”配对，飞行中的回调不会把旧位置写回来
+    requestAnchorReset_();
+    lastPtsUs_.store(-1, std::memory_order_seq_cst);
+}
+
+void AXAudioRenderer::publishClock_(int64_t clkUs, uint32_t gen) {
+    lastPtsUs_.store(clkUs, std::memory_order_seq_cst);
+    active_.store(true, std::memory_order_release);
+    // 算出 clkUs 之后锚点被作废（seek/pause）：撤回，不让旧位置盖掉 resetClock_ 写的 -1
+    if (anchorResetReq_.load(std::memory_order_seq_cst) != gen) {
+        lastPtsUs_.store(-1, std::memory_order_seq_cst);
+        active_.store(false, std::memory_order_release);
+    }
+}
+
+// ======================= 设备拉取 & 音频时钟 =======================
+// sink 线程（Oboe 实时回调 / 主机输出线程）：无锁、无分配
+int32_t AXAudioRenderer::onPull(void *dst, int32_t frames, int64_t devPos) {
+    const int bpf = fifo_.bytesPerFrame();
+    // 先取作废代次：本次拉取期间若有 flush/pause，这里发布的锚点带着旧代次，读侧直接不用
+    const uint32_t gen = anchorResetReq_.load(std::memory_order_seq_cst);
+    // ★ 暂停/静音：写静音，不动 FIFO，不刷新任何时钟
+    if (paused_.load(std::memory_order_acquire) || muted_.load(std::memory_order_acquire)) {
+        std::memset(dst, 0, (size_t) frames * bpf);
+        return 0;
+    }
+    int64_t ptsUs = -1;
+    float speed = 1.f;
+    const int32_t filled = fifo_.read(dst, frames, ptsUs, &speed);   // 不足部分已补零
+    pcmBytesToDevice_.fetch_add((int64_t) filled * bpf, std::memory_order_relaxed);
+    if (filled < frames) {
+        underrunCnt_.fetch_add(1, std::memory_order_relaxed);
+        if (tel_) tel_->audioUnderruns.fetch_add(1, std::memory_order_relaxed);
+    }
+    // 每次送出真实数据都刷新锚点：欠载插入的静音不会让时钟跑到媒体前面
+    if (filled > 0 && ptsUs >= 0) publishAnchor_(devPos, ptsUs, speed, gen);
+
+    // 更新时间戳（用于上层查询）
+    int64_t clk;
+    uint32_t clkGen = 0;
+    if (getClockUs_(clk, clkGen)) publishClock_(clk, clkGen);
+    return filled;
+}
+
+void AXAudioRenderer::onSinkError() {
+    // 让上层感知非活跃，必要时触发重建（可能不在回调线程：只登记作废）
+    requestAnchorReset_();
+    active_.store(false, std::memory_order_release);
+}
+
+// 锚点 = 某次拉取时写给设备的首帧序号 + 该帧的媒体 PTS 与倍速（来自 FIFO 标记，精确到帧）；
+// 播放头 = 锚点 PTS + (设备已呈现帧号 - 锚点帧号) × speed / rate，再补上时间戳之后流逝的时间
+bool AXAudioRenderer::getClockUs_(int64_t &outPtsUs, uint32_t &gen) {
+    if (!sink_) return false;
+    gen = anchorResetReq_.load(std::memory_order_seq_cst);
+    int64_t framePos = 0;
+    int64_t timeNs = 0;
+    if (!sink_->getTimestamp(framePos, timeNs)) return false;
+
+    int64_t anchorPos = 0, anchorPts = -1;
+    float speed = 1.f;
+    uint32_t anchorGen = 0;
+    if (!loadAnchor_(anchorPos, anchorPts, speed, anchorGen) || anchorPts < 0) return false;
+    if (anchorGen != gen) return false;   // 发布之后已被 flush/pause 作废（回调还没重建）
+
+    const int rate = std::max(1, outRate_);
+    outPtsUs = anchorPts + (int64_t) ((double) (framePos - anchorPos) * 1e6 * speed / rate);
+    if (!paused_.load(std::memory_order_acquire)) {
+        const int64_t sinceUs = (nowMonoNs() - timeNs) / 1000;
+        if (sinceUs > 0 && sinceUs < 100'000) outPtsUs += (int64_t) (sinceUs * speed);
+    }
+    return true;
+}
+
+// 播放头锚点（seqlock：只有 sink 线程写，喂料/查询线程读）。
+// 其它线程要作废锚点只能 requestAnchorReset_ 推进代次；锚点带着发布时的代次，与当前代次不符即视为无效
+void AXAudioRenderer::publishAnchor_(int64_t devPos, int64_t ptsUs, float speed, uint32_t gen) {
+    anchorSeq_.fetch_add(1, std::memory_order_acq_rel);   // 奇数：写入中
+    anchorPos_.store(devPos, std::memory_order_relaxed);
+    anchorPts_.store(ptsUs, std::memory_order_relaxed);
+    anchorSpeed_.store(speed, std::memory_order_relaxed);
+    anchorGen_.store(gen, std::memory_order_relaxed);
+    anchorSeq_.fetch_add(1, std::memory_order_release);
+}
+
+bool AXAudioRenderer::loadAnchor_(int64_t &devPos, int64_t &ptsUs, float &speed, uint32_t &gen) const {
+    for (int i = 0; i < 8; ++i) {
+        const uint32_t s0 = anchorSeq_.load(std::memory_order_acquire);
+        if (s0 & 1u) continue;
+        devPos = anchorPos_.load(std::memory_order_relaxed);
+        ptsUs = anchorPts_.load(std::memory_order_relaxed);
+        speed = anchorSpeed_.load(std::memory_order_relaxed);
+        gen = anchorGen_.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (anchorSeq_.load(std::memory_order_relaxed) == s0) return true;
+    }
+    return false;
 }
 
 bool AXAudioRenderer::ensureSwrForFrame_(const AVFrame *frm) {
@@ -501,129 +503,179 @@ bool AXAudioRenderer::ensureSwrForFrame_(const AVFrame *frm) {
     return true;
 }
 
-static void interleavePlanarToInterleaved(const uint8_t **srcPlanes, int nbSamples, int ch,
-                                          AVSampleFormat fmt,
-                                          std::vector<uint8_t> &out) {
-    // swr_convert 已可直接输出交织；该函数作为兜底/调试用途
-    const int bytesPerSample = (fmt == AV_SAMPLE_FMT_FLT || fmt == AV_SAMPLE_FMT_FLTP)
-                               ? sizeof(float) : sizeof(int16_t);
-    out.resize((size_t) nbSamples * ch * bytesPerSample);
-    if (fmt == AV_SAMPLE_FMT_FLT || fmt == AV_SAMPLE_FMT_FLTP) {
-        auto *dst = reinterpret_cast<float *>(out.data());
-        for (int n = 0; n < nbSamples; ++n) {
-            for (int c = 0; c < ch; ++c) {
-                dst[n * ch + c] = reinterpret_cast<const float *>(srcPlanes[c])[n];
-            }
-        }
-    } else {
-        auto *dst = reinterpret_cast<int16_t *>(out.data());
-        for (int n = 0; n < nbSamples; ++n) {
-            for (int c = 0; c < ch; ++c) {
-                dst[n * ch + c] = reinterpret_cast<const int16_t *>(srcPlanes[c])[n];
-            }
-        }
-    }
+// 软件音量（设备不支持左右独立增益）：对刚写好的 FIFO 区域原地处理，变化时带过渡
+void AXAudioRenderer::applyGain_(const AXPcmFifo::Region &r, int frames) {
+    gain_.setStereoVolume(volL_.load(std::memory_order_relaxed), volR_.load(std::memory_order_relaxed));
+    if (gain_.isUnity()) return;
+    gain_.process(r.ptr[0], std::min(frames, r.frames[0]));
+    if (frames > r.frames[0]) gain_.process(r.ptr[1], frames - r.frames[0]);
 }
 
 // 帧 → 重采样 → (可选时伸) → FIFO
+// 1x：swr_convert 直接写进 FIFO 的可写区域（环尾回绕时分两段），不经过任何中间缓冲；
+// FIFO 放不下的输出留在 swr 内部缓冲里，下一帧时先吐出来，不会丢样本
 bool AXAudioRenderer::convertAndQueue_(const AVFrame *frm) {
     if (!ensureSwrForFrame_(frm)) return false;
 
-    const int outCh = outChLayout_.nb_channels;
-    const int outBps = (outFormat_ == AV_SAMPLE_FMT_FLT) ? sizeof(float) : sizeof(int16_t);
-    const int outBpf = outBps * outCh;
+    // 首个输出样本的 PTS = 本帧 PTS - swr 内部尚未输出的延迟
+    int64_t ptsUs = -1;
+    if (frm->pts != AV_NOPTS_VALUE) {
+        ptsUs = av_rescale_q(frm->pts, tb_, AVRational{1, 1000000}) - swr_get_delay(swr_, 1000000);
+        if (ptsUs < 0) ptsUs = 0;
+    }
 
-    // 估算输出样本数（加 64 保险）
-    const int maxOut = swr_get_out_samples(swr_, frm->nb_samples) + 64;
+    const float speed = speed_.load(std::memory_order_relaxed);
+    if (stretch_) {
+        if (speed != 1.f) return stretchAndQueue_(frm, ptsUs, speed);
+        if (stretch_->tempo() != 1.f) {
+            // 刚切回 1x：取走已处理好的输出，丢掉 SoundTouch 内的残留（至多一个处理序列）
+            drainStretch_();
+            stretch_->clear();
+            stretch_->setTempo(1.f);
+            stInEndUs_ = -1;
+        }
+    }
 
-    std::vector<uint8_t> tmp;
-    tmp.resize((size_t) maxOut * outBpf);
+    const int maxOut = swr_get_out_samples(swr_, frm->nb_samples);
+    AXPcmFifo::Region r;
+    const int32_t room = fifo_.beginWrite(r, std::max(maxOut, 0));
+    if (room < maxOut) {
+        overflowCnt_.fetch_add(1, std::memory_order_relaxed);
+    }
 
+    AX_TRACE_SCOPE("swr_convert");
     const uint8_t **inData = (const uint8_t **) frm->extended_data;
-    uint8_t *outData[1] = {tmp.data()};
-    int outSamples = swr_convert(swr_, outData, maxOut, inData, frm->nb_samples);
-    if (outSamples < 0) {
-        AX_LOGE("swr_convert failed: %d", outSamples);
+    int written = 0;
+    int ret = swr_convert(swr_, &r.ptr[0], r.frames[0], inData, frm->nb_samples);
+    if (ret < 0) {
+        AX_LOGE("swr_convert failed: %d", ret);
         return false;
     }
+    written = ret;
+    if (ret == r.frames[0] && r.frames[1] > 0) {
+        // 第一段写满：把 swr 缓冲的剩余输出接到环头（in_count=0 只取缓冲，不触发 flush）
+        ret = swr_convert(swr_, &r.ptr[1], r.frames[1], inData, 0);
+        if (ret > 0) written += ret;
+    }
+    if (written <= 0) return false;
 
-    // 倍速：可选 SoundTouch（这里给出留口，默认直通）
-    // 如果需要接入：将 tmp(F32) 送入 ST，取出 tempo= speed_ 的输出，再覆盖 tmp/outSamples
-    // 为简洁，本版先直通，后续你需要我再补 SoundTouch 集成时，我会按 F32 路径对齐。
+    applyGain_(r, written);
+    if (!fifo_.commitWrite(written, ptsUs)) return false;   // 转换期间被 flush/pause 清过：旧数据作废
+    pcmFramesQueued_.fetch_add(written, std::memory_order_relaxed);
+    return true;
+}
 
-    // 音量（软件侧增益，避免设备不支持左右独立）
-    if (outFormat_ == AV_SAMPLE_FMT_FLT && (volL_ < 0.999f || volR_ < 0.999f)) {
-        float *p = reinterpret_cast<float *>(tmp.data());
-        for (int n = 0; n < outSamples; ++n) {
-            for (int c = 0; c < outCh; ++c) {
-                const float g = (c == 0 ? volL_ : (c == 1 ? volR_ : std::max(volL_, volR_)));
-                p[n * outCh + c] *= g;
-            }
-        }
-    } else if (outFormat_ == AV_SAMPLE_FMT_S16 && (volL_ < 0.999f || volR_ < 0.999f)) {
-        int16_t *p = reinterpret_cast<int16_t *>(tmp.data());
-        for (int n = 0; n < outSamples; ++n) {
-            for (int c = 0; c < outCh; ++c) {
-                const float g = (c == 0 ? volL_ : (c == 1 ? volR_ : std::max(volL_, volR_)));
-                int v = (int) std::lrint((float) p[n * outCh + c] * g);
-                p[n * outCh + c] = (int16_t) std::clamp(v,
-                                                        (int) std::numeric_limits<int16_t>::min(),
-                                                        (int) std::numeric_limits<int16_t>::max());
-            }
-        }
-    }
+// 倍速：swr 输出到 stretchIn_（只在帧变大时扩容）→ SoundTouch → 直接收进 FIFO 可写区域
+bool AXAudioRenderer::stretchAndQueue_(const AVFrame *frm, int64_t ptsUs, float speed) {
+    stretch_->setTempo(speed);
 
-    // 入 FIFO（一次一个 chunk，记录首样本 PTS）
-    PcmChunk c;
-    c.frames = outSamples;
-    c.ptsUs = (frm->pts == AV_NOPTS_VALUE)
-              ? -1
-              : av_rescale_q(frm->pts, tb_, AVRational{1, 1000000});
-    c.bytes.resize((size_t) c.frames * outBpf);
-    std::memcpy(c.bytes.data(), tmp.data(), c.bytes.size());
+    const int maxOut = swr_get_out_samples(swr_, frm->nb_samples);
+    const size_t need = (size_t) std::max(maxOut, 0) * fifo_.bytesPerFrame();
+    if (stretchIn_.size() < need) stretchIn_.resize(need);
 
-    fifo_.push(c);
-    return true;
+    uint8_t *out = stretchIn_.data();
+    int got;
+    {
+        AX_TRACE_SCOPE("swr_convert");
+        got = swr_convert(swr_, &out, maxOut, (const uint8_t **) frm->extended_data, frm->nb_samples);
+    }
+    if (got < 0) {
+        AX_LOGE("swr_convert failed: %d", got);
+        return false;
+    }
+    if (got > 0) {
+        stretch_->put(out, got);
+        // 记录已送入 SoundTouch 的输入末端媒体时间（无 PTS 的帧按时长顺延）
+        const int64_t durUs = (int64_t) got * 1'000'000LL / outRate_;
+        if (ptsUs >= 0) stInEndUs_ = ptsUs + durUs;
+        else if (stInEndUs_ >= 0) stInEndUs_ += durUs;
+    }
+    return drainStretch_() > 0;
+}
+
+// 把 SoundTouch 已产出的样本收进 FIFO；每段首帧 PTS = 输入末端 - 仍在 SoundTouch 内的媒体时长，
+// 标记带上 tempo，回调侧据此按“每帧 tempo/rate 秒”推进音频时钟
+int AXAudioRenderer::drainStretch_() {
+    int total = 0;
+    while (stretch_->available() > 0) {
+        AXPcmFifo::Region r;
+        if (fifo_.beginWrite(r, stretch_->available()) <= 0) {
+            overflowCnt_.fetch_add(1, std::memory_order_relaxed);
+            break;
+        }
+        const int64_t ptsUs = stInEndUs_ >= 0 ? std::max<int64_t>(0, stInEndUs_ - stretch_->bufferedMediaUs()) : -1;
+        int n = stretch_->receive(r.ptr[0], r.frames[0]);
+        if (n == r.frames[0] && r.frames[1] > 0) n += stretch_->receive(r.ptr[1], r.frames[1]);
+        if (n <= 0) break;
+
+        applyGain_(r, n);
+        if (!fifo_.commitWrite(n, ptsUs, stretch_->tempo())) break;
+        pcmFramesQueued_.fetch_add(n, std::memory_order_relaxed);
+        total += n;
+    }
+    return total;
 }
 
 bool AXAudioRenderer::renderOnce(int64_t /*masterClockUs*/) {
-    if (!sink_ || !sink_->started()) return false;
+    if (!sink_ || !sinkStarted_.load(std::memory_order_acquire)) return false;
     if (!frmQ_) return false;
 
-    // 目标 FIFO 水位（AAudio 60~120ms；OpenSL 100~200ms）
-    const int64_t lowUs = 80'000;   // 80ms
-    const int64_t highUs = 160'000;  // 160ms
-    int64_t curUs = fifo_.durationUs(outRate_);
+    if (flushReq_.exchange(false, std::memory_order_acq_rel)) dropConverterState_();
+    if (muted_.load(std::memory_order_acquire)) {
+        // 静音：帧队列照常取空（不让解码/解封装被音频背压卡住），时钟交给外部时钟
+        AVFrame *frm = nullptr;
+        while (frmQ_->tryPop(frm, std::chrono::milliseconds(0))) {
+            if (frm) axFrameFree(&frm);
+        }
+        active_.store(false, std::memory_order_release);
+        return false;
+    }
+
+    int64_t curUs = fifo_.durationUs();
 
     bool wrote = false;
-    while (curUs < lowUs) {
+    while (curUs < kFifoLowUs) {
         if (frmQ_->isAborted()) break;
 
         AVFrame *frm = nullptr;
-        if (!frmQ_->tryPop(frm, std::chrono::milliseconds(5))) { // 最多等5ms，避免卡死
+        if (!frmQ_->tryPop(frm, std::chrono::milliseconds(0))) { // 不等待：空了由上层挂到队列就绪事件上
             break;
         }
         if (!frm) {
             // 哨兵：流结束
             AX_LOGI("Audio frame nullptr (eof sentinel)");
+            if (stretch_ && stretch_->tempo() != 1.f) {
+                stretch_->flush();
+                wrote |= drainStretch_() > 0;
+            }
             break;
         }
         wrote |= convertAndQueue_(frm);
 
         // 释放传入帧（由 AXDecoder clone 的帧）
-        av_frame_free(&frm);
+        axFrameFree(&frm);
 
-        curUs = fifo_.durationUs(outRate_);
-        if (curUs >= highUs) break;
+        curUs = fifo_.durationUs();
+        if (curUs >= kFifoHighUs) break;
+    }
+    if (tel_) {
+        tel_->audioFifoUs.record(curUs);
+        tel_->audioFifoNowUs.store(curUs, std::memory_order_relaxed);
     }
 
     // 更新时钟
     int64_t clk;
-    if (sink_->getClockUs(clk)) {
-        lastPtsUs_.store(clk, std::memory_order_release);
-        active_.store(true, std::memory_order_release);
+    uint32_t clkGen = 0;
+    if (getClockUs_(clk, clkGen)) {
+        publishClock_(clk, clkGen);
     } else {
         active_.store(false, std::memory_order_release);
     }
     return wrote;
 }
+
+int64_t AXAudioRenderer::feedDelayUs() const {
+    if (!sink_ || !sinkStarted_.load(std::memory_order_acquire) || !frmQ_) return -1;
+    const int64_t curUs = fifo_.durationUs();
+    return curUs < kFifoLowUs ? 0 : curUs - kFifoLowUs;
+}
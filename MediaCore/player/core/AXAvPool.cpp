@@ -0,0 +1,214 @@
+//AXPlayerLib/MediaCore/player/core/AXAvPool.cpp
+
+#include "AXAvPool.h"
+
+#define AX_LOG_TAG "AXAvPool"
+#include "AXLog.h"
+
+extern "C" {
+#include <libavutil/imgutils.h>
+#include <libavutil/pixdesc.h>
+}
+
+// ======================= AXAvPool =======================
+AXAvPool& AXAvPool::instance() {
+    static AXAvPool pool;
+    return pool;
+}
+
+AXAvPool::AXAvPool() {
+    // 预留容量：回收路径上的 push_back 不会触发扩容分配
+    frames_.reserve(kMaxKeep);
+    packets_.reserve(kMaxKeep);
+}
+
+AXAvPool::~AXAvPool() {
+    for (AVFrame* f : frames_) av_frame_free(&f);
+    for (AVPacket* p : packets_) av_packet_free(&p);
+}
+
+AVFrame* AXAvPool::acquireFrame() {
+    {
+        std::lock_guard<std::mutex> lk(fm_);
+        if (!frames_.empty()) {
+            AVFrame* f = frames_.back();
+            frames_.pop_back();
+            frameReuses_.fetch_add(1, std::memory_order_relaxed);
+            return f;
+        }
+    }
+    frameAllocs_.fetch_add(1, std::memory_order_relaxed);
+    return av_frame_alloc();
+}
+
+void AXAvPool::releaseFrame(AVFrame* f) {
+    if (!f) return;
+    av_frame_unref(f);
+    {
+        std::lock_guard<std::mutex> lk(fm_);
+        if (frames_.size() < kMaxKeep) {
+            frames_.push_back(f);
+            return;
+        }
+    }
+    av_frame_free(&f);
+}
+
+AVPacket* AXAvPool::acquirePacket() {
+    {
+        std::lock_guard<std::mutex> lk(pm_);
+        if (!packets_.empty()) {
+            AVPacket* p = packets_.back();
+            packets_.pop_back();
+            packetReuses_.fetch_add(1, std::memory_order_relaxed);
+            return p;
+        }
+    }
+    packetAllocs_.fetch_add(1, std::memory_order_relaxed);
+    return av_packet_alloc();
+}
+
+void AXAvPool::releasePacket(AVPacket* p) {
+    if (!p) return;
+    av_packet_unref(p);
+    {
+        std::lock_guard<std::mutex> lk(pm_);
+        if (packets_.size() < kMaxKeep) {
+            packets_.push_back(p);
+            return;
+        }
+    }
+    av_packet_free(&p);
+}
+
+AXAvPool::Stats AXAvPool::stats() const {
+    Stats s;
+    s.frameAllocs    = frameAllocs_.load(std::memory_order_relaxed);
+    s.frameReuses    = frameReuses_.load(std::memory_order_relaxed);
+    s.packetAllocs   = packetAllocs_.load(std::memory_order_relaxed);
+    s.packetReuses   = packetReuses_.load(std::memory_order_relaxed);
+    s.imageBufAllocs = imageBufAllocs_.load(std::memory_order_relaxed);
+    s.imageBufGets   = imageBufGets_.load(std::memory_order_relaxed);
+    return s;
+}
+
+void AXAvPool::logStats(const char* where) const {
+    const Stats s = stats();
+    AX_LOGI("pool stats @%s: frame alloc=%lld reuse=%lld | packet alloc=%lld reuse=%lld | image buf alloc=%lld get=%lld",
+            where ? where : "-",
+            (long long) s.frameAllocs, (long long) s.frameReuses,
+            (long long) s.packetAllocs, (long long) s.packetReuses,
+            (long long) s.imageBufAllocs, (long long) s.imageBufGets);
+}
+
+// ======================= AXVideoBufferPool =======================
+AXVideoBufferPool::~AXVideoBufferPool() {
+    std::lock_guard<std::mutex> lk(m_);
+    releasePools_();
+}
+
+void AXVideoBufferPool::install(AVCodecContext* ctx) {
+    if (!ctx) return;
+    ctx->opaque = this;
+    ctx->get_buffer2 = &AXVideoBufferPool::getBuffer2;
+}
+
+AVBufferRef* AXVideoBufferPool::poolAlloc_(void* /*opaque*/, size_t size) {
+    AXAvPool::instance().countImageBufAlloc();
+    return av_buffer_alloc(size);
+}
+
+void AXVideoBufferPool::releasePools_() {
+    for (auto& p : pools_) {
+        if (p) av_buffer_pool_uninit(&p);   // 已借出的缓冲归还后池才真正销毁
+    }
+    planes_ = 0;
+    w_ = h_ = 0;
+    fmt_ = AV_PIX_FMT_NONE;
+}
+
+bool AXVideoBufferPool::ensurePools_(int w, int h, AVPixelFormat fmt, AVCodecContext* alignCtx) {
+    if (planes_ > 0 && w == w_ && h == h_ && fmt == fmt_) return true;
+    releasePools_();
+
+    // 与 FFmpeg 默认实现一致：先按解码器要求对齐宽高，再加宽到每个平面 linesize 都满足对齐
+    int aw = w, ah = h;
+    int align[AV_NUM_DATA_POINTERS];
+    for (int& a : align) a = 64;
+    if (alignCtx) {
+        avcodec_align_dimensions2(alignCtx, &aw, &ah, align);
+    } else {
+        aw = FFALIGN(w, 64);
+        ah = FFALIGN(h, 2);
+    }
+
+    int ls[4] = {0};
+    int unaligned = 0;
+    do {
+        if (av_image_fill_linesizes(ls, fmt, aw) < 0) return false;
+        aw += aw & ~(aw - 1);
+        unaligned = 0;
+        for (int i = 0; i < 4; ++i) {
+            if (align[i] > 0) unaligned |= ls[i] % align[i];
+        }
+    } while (unaligned);
+
+    ptrdiff_t ls1[4];
+    for (int i = 0; i < 4; ++i) ls1[i] = ls[i];
+    size_t sizes[4] = {0};
+    if (av_image_fill_plane_sizes(sizes, fmt, ah, ls1) < 0) return false;
+
+    for (int i = 0; i < 4 && sizes[i] > 0; ++i) {
+        // 与默认实现相同的尾部冗余（SIMD 越界读）
+        pools_[i] = av_buffer_pool_init2(sizes[i] + 16 + 64 - 1, this, &AXVideoBufferPool::poolAlloc_, nullptr);
+        if (!pools_[i]) {
+            releasePools_();
+            return false;
+        }
+        linesize_[i] = ls[i];
+        planes_ = i + 1;
+    }
+    w_ = w;
+    h_ = h;
+    fmt_ = fmt;
+    AX_LOGI("video buffer pool: %dx%d fmt=%d planes=%d", w, h, (int) fmt, planes_);
+    return planes_ > 0;
+}
+
+bool AXVideoBufferPool::allocFrame(AVFrame* frm, int w, int h, AVPixelFormat fmt, AVCodecContext* alignCtx) {
+    if (!frm || w <= 0 || h <= 0) return false;
+    std::lock_guard<std::mutex> lk(m_);
+    if (!ensurePools_(w, h, fmt, alignCtx)) return false;
+
+    for (int i = 0; i < AV_NUM_DATA_POINTERS; ++i) {
+        frm->data[i] = nullptr;
+        frm->linesize[i] = 0;
+    }
+    for (int i = 0; i < planes_; ++i) {
+        frm->buf[i] = av_buffer_pool_get(pools_[i]);
+        if (!frm->buf[i]) {
+            for (int k = 0; k < i; ++k) av_buffer_unref(&frm->buf[k]);
+            return false;
+        }
+        frm->data[i] = frm->buf[i]->data;
+        frm->linesize[i] = linesize_[i];
+    }
+    frm->extended_data = frm->data;
+    frm->width  = w;
+    frm->height = h;
+    frm->format = fmt;
+    AXAvPool::instance().countImageBufGet();
+    return true;
+}
+
+int AXVideoBufferPool::getBuffer2(AVCodecContext* ctx, AVFrame* frm, int flags) {
+    auto* self = static_cast<AXVideoBufferPool*>(ctx->opaque);
+    const AVPixFmtDescriptor* desc = av_pix_fmt_desc_get((AVPixelFormat) frm->format);
+    const bool usable = self && desc && ctx->codec && (ctx->codec->capabilities & AV_CODEC_CAP_DR1)
+                        && !(desc->flags & (AV_PIX_FMT_FLAG_HWACCEL | AV_PIX_FMT_FLAG_PAL))
+                        && !ctx->hw_frames_ctx;
+    if (!usable || !self->allocFrame(frm, frm->width, frm->height, (AVPixelFormat) frm->format, ctx)) {
+        return avcodec_default_get_buffer2(ctx, frm, flags);
+    }
+    return 0;
+}
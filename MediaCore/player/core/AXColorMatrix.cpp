@@ -0,0 +1,107 @@
+//AXPlayerLib/MediaCore/player/core/AXColorMatrix.cpp
+#include "AXColorMatrix.h"
+
+#include <algorithm>
+#include <cmath>
+
+extern "C" {
+#include <libavutil/pixfmt.h>
+}
+
+namespace {
+
+// 亮度系数 Kr / Kb（Kg = 1 - Kr - Kb）
+struct LumaCoeffs {
+    double kr;
+    double kb;
+};
+
+bool lumaCoeffsOf(int colorspace, LumaCoeffs& out) {
+    switch (colorspace) {
+        case AVCOL_SPC_BT709:      out = {0.2126, 0.0722}; return true;
+        case AVCOL_SPC_FCC:        out = {0.30, 0.11}; return true;
+        case AVCOL_SPC_BT470BG:
+        case AVCOL_SPC_SMPTE170M:  out = {0.299, 0.114}; return true;
+        case AVCOL_SPC_SMPTE240M:  out = {0.212, 0.087}; return true;
+        // CL 的传递函数不同，这里按 NCL 的线性系数近似
+        case AVCOL_SPC_BT2020_NCL:
+        case AVCOL_SPC_BT2020_CL:  out = {0.2627, 0.0593}; return true;
+        default:                   out = {0.299, 0.114}; return false;
+    }
+}
+
+} // namespace
+
+int axResolveColorSpace(int colorspace, int height) {
+    LumaCoeffs c;
+    if (lumaCoeffsOf(colorspace, c)) return colorspace;
+    return height >= 720 ? AVCOL_SPC_BT709 : AVCOL_SPC_SMPTE170M;
+}
+
+int axResolveColorRange(int range, bool jpegPixFmt) {
+    if (range == AVCOL_RANGE_MPEG || range == AVCOL_RANGE_JPEG) return range;
+    return jpegPixFmt ? AVCOL_RANGE_JPEG : AVCOL_RANGE_MPEG;
+}
+
+bool axColorMatrixFor(int colorspace, int range, int bitDepth, AXColorMatrix& out) {
+    LumaCoeffs c;
+    const bool known = lumaCoeffsOf(colorspace, c);
+    if (bitDepth < 8 || bitDepth > 16) bitDepth = 8;
+    const double kg = 1.0 - c.kr - c.kb;
+
+    // 归一化到 [0, 2^n - 1] 的样本：有限范围 Y 占 [16, 235]、C 占 [16, 240]（按位深左移）
+    const double maxV = (double) ((1 << bitDepth) - 1);
+    const double unit = (double) (1 << (bitDepth - 8));
+    double yOff, yScale, cScale;
+    const double cOff = (double) (1 << (bitDepth - 1)) / maxV;
+    if (range == AVCOL_RANGE_JPEG) {
+        yOff = 0.0;
+        yScale = 1.0;
+        cScale = 1.0;
+    } else {
+        yOff = 16.0 * unit / maxV;
+        yScale = maxV / (219.0 * unit);
+        cScale = maxV / (224.0 * unit);
+    }
+
+    // R = Y + 2(1-Kr)Cr；B = Y + 2(1-Kb)Cb；G 由 Kr、Kb、Kg 反解
+    const double rCr = 2.0 * (1.0 - c.kr);
+    const double bCb = 2.0 * (1.0 - c.kb);
+    const double gCb = -bCb * c.kb / kg;
+    const double gCr = -rCr * c.kr / kg;
+
+    AXColorMatrix m;
+    // 列 0：Y
+    m.mat[0] = m.mat[1] = m.mat[2] = (float) yScale;
+    // 列 1：Cb
+    m.mat[3] = 0.f;
+    m.mat[4] = (float) (gCb * cScale);
+    m.mat[5] = (float) (bCb * cScale);
+    // 列 2：Cr
+    m.mat[6] = (float) (rCr * cScale);
+    m.mat[7] = (float) (gCr * cScale);
+    m.mat[8] = 0.f;
+    m.offset[0] = (float) yOff;
+    m.offset[1] = m.offset[2] = (float) cOff;
+    m.colorspace = known ? colorspace : AVCOL_SPC_SMPTE170M;
+    m.range = range == AVCOL_RANGE_JPEG ? AVCOL_RANGE_JPEG : AVCOL_RANGE_MPEG;
+    m.bitDepth = bitDepth;
+    out = m;
+    return known;
+}
+
+void AXColorMatrix::apply(float y, float u, float v, float rgb[3]) const {
+    const float d[3] = {y - offset[0], u - offset[1], v - offset[2]};
+    for (int r = 0; r < 3; ++r) {
+        rgb[r] = mat[r] * d[0] + mat[3 + r] * d[1] + mat[6 + r] * d[2];
+    }
+}
+
+void AXColorMatrix::toRgb8(int y, int u, int v, uint8_t rgb[3]) const {
+    const float maxV = (float) ((1 << bitDepth) - 1);
+    float f[3];
+    apply((float) y / maxV, (float) u / maxV, (float) v / maxV, f);
+    for (int i = 0; i < 3; ++i) {
+        rgb[i] = (uint8_t) std::min(255.f, std::max(0.f, std::round(f[i] * 255.f)));
+    }
+}
@@ -1,4 +1,6 @@
 #include "AXDecoder.h"
+#include "AXStageStamp.h"
+#include "AXTrace.h"
 #include <thread>
 #include <chrono>
 
@@ -38,6 +40,15 @@ bool AXDecoder::open(AVCodecParameters* par, AVRational timeBase, bool isVideo)
         ctx_->thread_type |= FF_THREAD_SLICE;
 #endif
 
+    // 视频帧图像走自有缓冲池（稳态复用，不再每帧向系统申请大块内存）
+    if (isVideo_) {
+        bufPool_.reset(new AXVideoBufferPool());
+        bufPool_->install(ctx_);
+    }
+
+    // 包上的 opaque_ref（分段时间戳）随帧带出；没挂时无开销
+    ctx_->flags |= AV_CODEC_FLAG_COPY_OPAQUE;
+
     // TODO: 硬解可在此切到 MediaCodec（另行实现）
 
     if ((ret = avcodec_open2(ctx_, codec, nullptr)) < 0) {
@@ -49,6 +60,7 @@ bool AXDecoder::open(AVCodecParameters* par, AVRational timeBase, bool isVideo)
 
 void AXDecoder::start() {
     abort_.store(false);
+    eof_.store(false);
     // 若已在跑，直接返回（防呆；通常上层会新建实例）
     if (th_.joinable()) return;
     th_ = std::thread(&AXDecoder::loop_, this);
@@ -62,24 +74,161 @@ void AXDecoder::stop() {
 }
 
 void AXDecoder::flush() {
-    if (ctx_) avcodec_flush_buffers(ctx_);
+    if (pktQ_) pktQ_->flush();   // 先推进序号：此后解码线程产出的旧帧在入队前/取帧时都会被丢掉
     if (frmQ_) frmQ_->flush();
-    if (pktQ_) pktQ_->flush();
 }
 
 bool AXDecoder::safePushFrame_(AVFrame* frm) {
     if (!frmQ_) {
-        av_frame_free(&frm);
+        axFrameFree(&frm);
         return false;
     }
     if (!frmQ_->push(frm)) {
-        av_frame_free(&frm);
+        axFrameFree(&frm);
         return false;
     }
     return true;
 }
 
+void AXDecoder::setRenderableCheck(bool (*renderable)(int)) {
+    renderable_ = renderable;
+    if (renderable_ && isVideo_ && !conv_) conv_.reset(new AXFrameConverter());
+}
+
+// 输出端不能直接呈现的格式在这里转成 I420（解码线程有余量，渲染线程只管上传）；转换失败则原样入队，由输出端跳过
+AVFrame* AXDecoder::convertIfNeeded_(AVFrame* frm) {
+    if (!conv_ || !renderable_ || renderable_(frm->format)) return frm;
+    AVFrame* dst = axFrameAlloc();
+    if (!dst) return frm;
+    AXFrameConverter::Backend b;
+    {
+        AX_TRACE_SCOPE("convertFrame");
+        b = conv_->convert(frm, dst);
+    }
+    if (frm->format != lastConvFmt_) {
+        lastConvFmt_ = frm->format;
+        if (b != AXFrameConverter::Backend::None) {
+            AX_LOGI("convert pix_fmt %d -> yuv420p via %s", frm->format, AXFrameConverter::backendName(b));
+        } else {
+            AX_LOGW("convert pix_fmt %d failed, passing through", frm->format);
+        }
+    }
+    if (b == AXFrameConverter::Backend::None) {
+        axFrameFree(&dst);
+        return frm;
+    }
+    axFrameFree(&frm);
+    return dst;
+}
+
+void AXDecoder::setDiscardBefore(int64_t targetUs) {
+    discardArmedUs_.store(axStampNowUs(), std::memory_order_relaxed);
+    discardSerial_.store(pktQ_ ? pktQ_->serial() : 0, std::memory_order_relaxed);
+    discardBeforeUs_.store(targetUs < 0 ? -1 : targetUs, std::memory_order_release);
+}
+
+int64_t AXDecoder::frameDurationUs_(const AVFrame* frm) const {
+    if (frm->duration > 0) return av_rescale_q(frm->duration, tb_, AVRational{1, 1000000});
+    if (!isVideo_) return frm->sample_rate > 0 ? (int64_t) frm->nb_samples * 1000000 / frm->sample_rate : 0;
+    const AVRational fr = ctx_->framerate;
+    return (fr.num > 0 && fr.den > 0) ? (int64_t) fr.den * 1000000 / fr.num : 0;
+}
+
+// 精确 seek 时从关键帧解到目标：整段落在目标之前的帧直接丢（参考帧仍由解码器内部保留），
+// 跨过目标的那一帧就是 seek 后的首帧。没有时间戳的帧无法判断，照常放行。
+// 设目标之后、demux seek 推进序号之前解出的帧仍是旧位置的（后退 seek 时 pts 还可能大于目标），
+// 直接丢掉且不关闭丢弃
+bool AXDecoder::discardForSeek_(const AVFrame* frm) {
+    int64_t target = discardBeforeUs_.load(std::memory_order_acquire);
+    if (target < 0) return false;
+    if ((int32_t) (serial_ - discardSerial_.load(std::memory_order_relaxed)) <= 0) return true;
+    const int64_t pts = frm->pts != AV_NOPTS_VALUE ? frm->pts : frm->best_effort_timestamp;
+    if (pts == AV_NOPTS_VALUE) return false;
+    const int64_t startUs = av_rescale_q(pts, tb_, AVRational{1, 1000000});
+    if (startUs + frameDurationUs_(frm) <= target) {
+        ++discarded_;
+        return true;
+    }
+    // 到达目标：关闭丢弃（期间若又来了新的 seek，保留新目标）
+    if (discardBeforeUs_.compare_exchange_strong(target, -1, std::memory_order_acq_rel)) {
+        AX_LOGI("accurate seek (%s): discarded %lld frames, first frame %lld us for target %lld us in %lld ms",
+                isVideo_ ? "video" : "audio", (long long) discarded_, (long long) startUs, (long long) target,
+                (long long) ((axStampNowUs() - discardArmedUs_.load(std::memory_order_relaxed)) / 1000));
+    }
+    discarded_ = 0;
+    return false;
+}
+
+void AXDecoder::applyKeyframeOnly_() {
+    const bool on = keyOnly_.load(std::memory_order_acquire);
+    if (on == keyOnlyApplied_) return;
+    keyOnlyApplied_ = on;
+    ctx_->skip_frame = on ? AVDISCARD_NONKEY : AVDISCARD_DEFAULT;
+    AX_LOGI("keyframe-only decoding %s", on ? "on" : "off");
+}
+
+// 关键帧单独成段：送包后立即 drain 取出这一帧，再 flush 让解码器回到可接收状态。
+// 帧线程解码器平时要攒够 thread_count 个包才出第一帧，拖动时这会让预览落后好几个关键帧
+bool AXDecoder::decodeKeyframe_(AVPacket* pkt, AVFrame* frame) {
+    int ret;
+    {
+        AX_TRACE_SCOPE("avcodec_send_packet");
+        ret = avcodec_send_packet(ctx_, pkt);
+    }
+    if (ret < 0 && ret != AVERROR(EAGAIN)) AX_LOGW("send_packet(key) ret=%d", ret);
+    avcodec_send_packet(ctx_, nullptr);
+    const bool ok = receiveFrames_(frame, true);
+    avcodec_flush_buffers(ctx_);
+    return ok;
+}
+
+// 取出解码器当前可输出的全部帧：直接把帧所有权 move 进池化壳再入队（无克隆、无额外引用计数往返）
+// 返回 false 表示帧队列已 abort，调用方应退出线程
+bool AXDecoder::receiveFrames_(AVFrame* frame, bool draining) {
+    while (!abort_.load()) {
+        const int64_t recvStartUs = tel_ ? axStampNowUs() : 0;
+        int ret;
+        {
+            AX_TRACE_SCOPE("avcodec_receive_frame");
+            ret = avcodec_receive_frame(ctx_, frame);
+        }
+        if (tel_) codecUs_ += axStampNowUs() - recvStartUs;   // 只计解码器耗时，不含帧队列背压
+        if (ret == AVERROR(EAGAIN) || ret == AVERROR_EOF) return true;
+        if (ret < 0) {
+            AX_LOGW("receive_frame ret=%d%s", ret, draining ? " on drain" : "");
+            return true;
+        }
+
+        // 期间发生了 flush/seek：解码器里剩下的都是旧帧，留给下一段首包前的冲刷处理
+        if (serial_ != pktQ_->serial()) {
+            av_frame_unref(frame);
+            return true;
+        }
+
+        if (discardForSeek_(frame)) {
+            av_frame_unref(frame);
+            continue;
+        }
+
+        AVFrame* out = axFrameAlloc();
+        if (!out) {
+            AX_LOGE("axFrameAlloc OOM");
+            av_frame_unref(frame);
+            return true;
+        }
+        av_frame_move_ref(out, frame);   // frame 被重置为空，可直接复用
+        out = convertIfNeeded_(out);
+        axSetFrameSerial(out, serial_);
+        if (out->opaque_ref && av_buffer_make_writable(&out->opaque_ref) >= 0) {
+            if (AXStageStamp* st = axStampOf(out->opaque_ref)) st->decodedUs = axStampNowUs();
+        }
+        if (!safePushFrame_(out)) return false;
+    }
+    return true;
+}
+
 void AXDecoder::loop_() {
+    AX_TRACE_THREAD(isVideo_ ? "AXDecoder-video" : "AXDecoder-audio");
     AVFrame* frame = av_frame_alloc();
     if (!frame) return;
 
@@ -91,62 +240,69 @@ void AXDecoder::loop_() {
 
         if (!pkt) continue;
 
+        // 序号过期：flush/seek 之前读出的包（读包线程阻塞在满队列时被 flush 放行后才入队）
+        if (axPacketSerial(pkt) != pktQ_->serial()) {
+            axPacketFree(&pkt);
+            continue;
+        }
+        if (axPacketSerial(pkt) != serial_) {
+            // seek 之后的首包：在本线程冲掉上一段留在解码器里的参考帧与待出帧（ffplay 的 serial 做法）
+            avcodec_flush_buffers(ctx_);
+            serial_ = axPacketSerial(pkt);
+        }
+
         // 空包：表示 demux EOF，送 NULL packet 触发冲刷
         if (pkt->data == nullptr && pkt->size == 0) {
-            av_packet_free(&pkt);
+            axPacketFree(&pkt);
 
             // drain 剩余帧
-            int ret = 0;
-            ret = avcodec_send_packet(ctx_, nullptr);
+            int ret = avcodec_send_packet(ctx_, nullptr);
             if (ret < 0 && ret != AVERROR(EAGAIN) && ret != AVERROR_EOF) {
                 AX_LOGW("send_packet(NULL) ret=%d", ret);
             }
+            receiveFrames_(frame, true);
+            eof_.store(true, std::memory_order_release);
+            // 不退出：冲刷后解码器可再次收包，seek 回来后接着解（直到 stop）
+            avcodec_flush_buffers(ctx_);
+            continue;
+        }
+        eof_.store(false, std::memory_order_release);
 
-            while (!abort_.load()) {
-                ret = avcodec_receive_frame(ctx_, frame);
-                if (ret == AVERROR(EAGAIN) || ret == AVERROR_EOF) break;
-                if (ret < 0) { AX_LOGW("receive_frame ret=%d on drain", ret); break; }
-
-                // 交给渲染/上层
-                AVFrame* out = av_frame_clone(frame);
-                if (!out) { AX_LOGE("av_frame_clone OOM"); break; }
-                if (!safePushFrame_(out)) { // 队列 abort
-                    break;
-                }
-                av_frame_unref(frame);
+        applyKeyframeOnly_();
+        if (keyOnlyApplied_) {
+            const bool key = (pkt->flags & AV_PKT_FLAG_KEY) != 0;
+            const bool ok = !key || decodeKeyframe_(pkt, frame);
+            axPacketFree(&pkt);
+            if (!ok) {
+                abort_.store(true);
+                break;
             }
-            break; // EOF 后退出解码线程
+            continue;
         }
 
         // 常规包
-        int ret = avcodec_send_packet(ctx_, pkt);
-        av_packet_free(&pkt);
+        const int64_t decStartUs = tel_ ? axStampNowUs() : 0;
+        int ret;
+        {
+            AX_TRACE_SCOPE("avcodec_send_packet");
+            ret = avcodec_send_packet(ctx_, pkt);
+        }
+        axPacketFree(&pkt);
 
         if (ret < 0 && ret != AVERROR(EAGAIN)) {
             AX_LOGW("send_packet ret=%d", ret);
         }
 
         // 尽量把可取的帧都取出来（避免缓存积压）
-        while (!abort_.load()) {
-            ret = avcodec_receive_frame(ctx_, frame);
-            if (ret == AVERROR(EAGAIN) || ret == AVERROR_EOF) {
-                break;
-            }
-            if (ret < 0) {
-                AX_LOGW("receive_frame ret=%d", ret);
-                break;
-            }
-
-            AVFrame* out = av_frame_clone(frame);
-            if (!out) { AX_LOGE("av_frame_clone OOM"); break; }
-            if (!safePushFrame_(out)) {
-                // 队列已 abort，直接退出线程
-                abort_.store(true);
-                break;
-            }
-            av_frame_unref(frame);
+        if (tel_) codecUs_ = axStampNowUs() - decStartUs;
+        const bool ok = receiveFrames_(frame, false);
+        if (tel_) (isVideo_ ? tel_->videoDecodeUs : tel_->audioDecodeUs).record(codecUs_);
+        if (!ok) {
+            // 队列已 abort，直接退出线程
+            abort_.store(true);
+            break;
         }
     }
 
     av_frame_free(&frame);
-}
\ No newline at end of file
+}
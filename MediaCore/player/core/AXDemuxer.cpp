@@ -1,6 +1,11 @@
 #include "AXDemuxer.h"
-#include <android/log.h>
 #include "AXErrors.h"
+#include "AXStageStamp.h"
+#include "AXStreamInfoCache.h"
+#include "AXTrace.h"
+
+#include <algorithm>
+#include <cstring>
 
 
 AXDemuxer::AXDemuxer() {}
@@ -9,9 +14,11 @@ AXDemuxer::~AXDemuxer() {
     if (fmt_) {
         avformat_close_input(&fmt_);
     }
+    // 池在所有块归还后才真正释放，帧上残留的 opaque_ref 不受影响
+    av_buffer_pool_uninit(&stampPool_);
 }
 
-static AVDictionary* buildDict(const std::map<std::string,std::string>& headers) {
+static AVDictionary* buildDict(const std::map<std::string,std::string>& headers, const AXOpenOptions& opts) {
     AVDictionary* dict = nullptr;
     if (!headers.empty()) {
         std::string h;
@@ -25,15 +32,22 @@ static AVDictionary* buildDict(const std::map<std::string,std::string>& headers)
     av_dict_set(&dict, "user_agent", "AXPlayer/1.0", 0);
     // 合理的网络超时（微秒）
     av_dict_set(&dict, "timeout", "8000000", 0); // 8s
+    // 探测上限：不设则 FFmpeg 默认最多读 5MB / 分析 5s 媒体时间
+    if (opts.probeSize > 0) av_dict_set_int(&dict, "probesize", opts.probeSize, 0);
+    if (opts.analyzeDurationUs > 0) av_dict_set_int(&dict, "analyzeduration", opts.analyzeDurationUs, 0);
     return dict;
 }
 
 bool AXDemuxer::open(const std::string& url, const std::map<std::string,std::string>& headers, DemuxResult& out) {
     eof_.store(false);
 
-    AVDictionary* dict = buildDict(headers);
+    timing_ = AXOpenTiming{};
+
+    AVDictionary* dict = buildDict(headers, openOpts_);
+    int64_t t0 = axStampNowUs();
     int ret = avformat_open_input(&fmt_, url.c_str(), nullptr, &dict);
     av_dict_free(&dict);
+    timing_.openInputUs = axStampNowUs() - t0;
     if (ret < 0) {
         AX_LOGE("open input fail: %d", ret);
         return false;
@@ -46,10 +60,24 @@ bool AXDemuxer::open(const std::string& url, const std::map<std::string,std::str
     };
     fmt_->interrupt_callback.opaque = this;
 
-    if ((ret = avformat_find_stream_info(fmt_, nullptr)) < 0) {
-        AX_LOGE("find_stream_info fail: %d", ret);
-        return false;
+    // 探测：缓存命中 > 容器头已够用 > 完整 find_stream_info
+    const AXStreamInfoCache cache(openOpts_.cacheDir);
+    t0 = axStampNowUs();
+    if (cache.load(url, fmt_)) {
+        timing_.probe = AXOpenTiming::Probe::Cached;
+    } else if (openOpts_.fastOpen && headerSufficient_()) {
+        timing_.probe = AXOpenTiming::Probe::Fast;
+    } else {
+        AX_TRACE_SCOPE("find_stream_info");
+        if ((ret = avformat_find_stream_info(fmt_, nullptr)) < 0) {
+            AX_LOGE("find_stream_info fail: %d", ret);
+            return false;
+        }
+        cache.store(url, fmt_);
     }
+    timing_.probeUs = axStampNowUs() - t0;
+    AX_LOGI("open: input %.1f ms, probe %.1f ms (%s)", timing_.openInputUs / 1000.0, timing_.probeUs / 1000.0,
+            probeName(timing_.probe));
 
     aIdx_ = av_find_best_stream(fmt_, AVMEDIA_TYPE_AUDIO, -1, -1, nullptr, 0);
     vIdx_ = av_find_best_stream(fmt_, AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0);
@@ -61,6 +89,13 @@ bool AXDemuxer::open(const std::string& url, const std::map<std::string,std::str
     out.audioStream = aIdx_;
     out.videoStream = vIdx_;
     out.durationUs  = (fmt_->duration > 0) ? fmt_->duration * 1000000LL / AV_TIME_BASE : 0;
+    if (out.durationUs <= 0 && timing_.probe == AXOpenTiming::Probe::Fast) {
+        // 没跑 find_stream_info 时总时长还没由各流汇总，取最长的流
+        for (unsigned i = 0; i < fmt_->nb_streams; ++i) {
+            const AVStream* st = fmt_->streams[i];
+            if (st->duration > 0) out.durationUs = std::max(out.durationUs, av_rescale_q(st->duration, st->time_base, AVRational{1, 1000000}));
+        }
+    }
 
     if (vIdx_ >= 0) {
         AVStream* st = fmt_->streams[vIdx_];
@@ -79,17 +114,48 @@ bool AXDemuxer::open(const std::string& url, const std::map<std::string,std::str
     return true;
 }
 
+const char* AXDemuxer::probeName(AXOpenTiming::Probe p) {
+    switch (p) {
+        case AXOpenTiming::Probe::Fast:   return "fast";
+        case AXOpenTiming::Probe::Cached: return "cached";
+        default:                          return "full";
+    }
+}
+
+// 只信任把编解码参数完整写在头里的容器（MP4 的 stsd、MKV 的 CodecPrivate）；
+// 要播的音视频流参数都齐了才跳过探测，否则（如 AAC 没给声道、裸 H.264 没尺寸）仍走 find_stream_info
+bool AXDemuxer::headerSufficient_() const {
+    const char* name = fmt_->iformat ? fmt_->iformat->name : nullptr;
+    if (!name || (!std::strstr(name, "mp4") && !std::strstr(name, "matroska"))) return false;
+    bool any = false;
+    for (unsigned i = 0; i < fmt_->nb_streams; ++i) {
+        const AVCodecParameters* p = fmt_->streams[i]->codecpar;
+        if (p->codec_type == AVMEDIA_TYPE_VIDEO) {
+            if (fmt_->streams[i]->disposition & AV_DISPOSITION_ATTACHED_PIC) continue;
+            if (p->codec_id == AV_CODEC_ID_NONE || p->width <= 0 || p->height <= 0) return false;
+            any = true;
+        } else if (p->codec_type == AVMEDIA_TYPE_AUDIO) {
+            if (p->codec_id == AV_CODEC_ID_NONE || p->sample_rate <= 0 || p->ch_layout.nb_channels <= 0) return false;
+            any = true;
+        }
+    }
+    return any;
+}
+
 void AXDemuxer::start(PacketQueue* aQ, PacketQueue* vQ) {
     aQ_ = aQ;
     vQ_ = vQ;
+    if (stamps_ && !stampPool_) stampPool_ = av_buffer_pool_init(sizeof(AXStageStamp), nullptr);
     abort_.store(false);
     eof_.store(false);
     th_ = std::thread(&AXDemuxer::loop_, this);
 }
 
 void AXDemuxer::stop() {
-    // 先置位中断标志
+    // 先置位中断标志（锁外：阻塞中的 av_read_frame 靠它经 interrupt_callback 返回并放锁）
     abort_.store(true);
+    { std::lock_guard<std::mutex> lk(ioMtx_); }   // 与 EOF 等待的谓词检查同步，避免漏唤醒
+    eofCv_.notify_all();
     // ★ 同时让队列退出阻塞（防止 push 卡住）
     if (aQ_) aQ_->abort();
     if (vQ_) vQ_->abort();
@@ -97,14 +163,26 @@ void AXDemuxer::stop() {
     if (th_.joinable()) th_.join();
 }
 
-bool AXDemuxer::seek(int streamIndex, int64_t pts) {
+bool AXDemuxer::seek(int streamIndex, int64_t pts, bool nearestKey) {
     if (!fmt_) return false;
+    std::lock_guard<std::mutex> lk(ioMtx_);
+    // 已在队列里的旧包在这里清掉；读包线程手里还没入队的旧包带着旧序号，入队后由解码线程丢弃
+    seekGen_.fetch_add(1, std::memory_order_acq_rel);
+    if (aQ_) aQ_->flush();
+    if (vQ_) vQ_->flush();
     eof_.store(false);
+    eofCv_.notify_all();
 
     // 将局部 PTS 转为全局时基
     int64_t seekTarget = av_rescale_q(pts, fmt_->streams[streamIndex]->time_base, AV_TIME_BASE_Q);
-    int flags = AVSEEK_FLAG_BACKWARD;
-    int ret = av_seek_frame(fmt_, -1, seekTarget, flags);
+    int ret = -1;
+    if (nearestKey) {
+        ret = avformat_seek_file(fmt_, -1, INT64_MIN, seekTarget, INT64_MAX, 0);
+    }
+    if (ret < 0) {
+        int flags = AVSEEK_FLAG_BACKWARD;
+        ret = av_seek_frame(fmt_, -1, seekTarget, flags);
+    }
     if (ret < 0) {
         AX_LOGW("seek fail: %d", ret);
         return false;
@@ -114,58 +192,99 @@ bool AXDemuxer::seek(int streamIndex, int64_t pts) {
     return true;
 }
 
+void AXDemuxer::stampPacket_(AVPacket* pkt) {
+    AVBufferRef* ref = av_buffer_pool_get(stampPool_);
+    if (!ref) return;
+    *reinterpret_cast<AXStageStamp*>(ref->data) = AXStageStamp{axStampNowUs(), -1};
+    av_buffer_unref(&pkt->opaque_ref);
+    pkt->opaque_ref = ref;
+}
+
 void AXDemuxer::loop_() {
+    AX_TRACE_THREAD("AXDemux");
     while (!abort_.load()) {
-        AVPacket* pkt = av_packet_alloc();
+        AVPacket* pkt = axPacketAlloc();
         if (!pkt) {
-            AX_LOGE("av_packet_alloc fail");
+            AX_LOGE("axPacketAlloc fail");
             break;
         }
 
-        int ret = av_read_frame(fmt_, pkt);
+        const int64_t readStartUs = tel_ ? axStampNowUs() : 0;
+        int ret;
+        uint32_t gen, aSerial = 0, vSerial = 0;
+        {
+            AX_TRACE_SCOPE("av_read_frame");
+            std::lock_guard<std::mutex> lk(ioMtx_);
+            gen = seekGen_.load(std::memory_order_acquire);
+            ret = av_read_frame(fmt_, pkt);
+            if (ret == AVERROR_EOF) eof_.store(true);
+            // 包按读出时的队列序号打标（seek 在锁内 flush 队列、推进序号）：
+            // 入队前后才发生的 seek 由解码线程按序号丢包，不依赖这里的代号检查
+            if (aQ_) aSerial = aQ_->serial();
+            if (vQ_) vSerial = vQ_->serial();
+        }
+        if (tel_) tel_->demuxReadUs.record(axStampNowUs() - readStartUs);
 
         if (ret == AVERROR_EOF) {
-            eof_.store(true);
             // 尝试发送 EOF 空包；若队列已 abort，push 会返回 false，我们直接 free
-            if (aIdx_ >= 0 && aQ_) {
-                AVPacket* ap = av_packet_alloc();
+            const bool current = gen == seekGen_.load(std::memory_order_acquire);   // 期间 seek 过就不算 EOF
+            if (current && aIdx_ >= 0 && aQ_) {
+                AVPacket* ap = axPacketAlloc();
                 if (ap) {
                     ap->stream_index = aIdx_;
                     ap->data = nullptr; ap->size = 0;
-                    if (!aQ_->push(ap)) av_packet_free(&ap);
+                    axSetPacketSerial(ap, aSerial);
+                    if (!aQ_->push(ap)) axPacketFree(&ap);
                 }
             }
-            if (vIdx_ >= 0 && vQ_) {
-                AVPacket* vp = av_packet_alloc();
+            if (current && vIdx_ >= 0 && vQ_) {
+                AVPacket* vp = axPacketAlloc();
                 if (vp) {
                     vp->stream_index = vIdx_;
                     vp->data = nullptr; vp->size = 0;
-                    if (!vQ_->push(vp)) av_packet_free(&vp);
+                    axSetPacketSerial(vp, vSerial);
+                    if (!vQ_->push(vp)) axPacketFree(&vp);
                 }
             }
-            av_packet_free(&pkt);
-            break;
+            axPacketFree(&pkt);
+
+            // 停在 EOF：seek 会清掉 eof_ 并唤醒，从新位置接着读；stop 时退出
+            std::unique_lock<std::mutex> lk(ioMtx_);
+            eofCv_.wait(lk, [this] { return abort_.load() || !eof_.load(); });
+            continue;
         }
 
         if (ret < 0) {
             // 其他错误：如果是中断或临时错误，略过；避免忙等稍微让步
             AX_LOGW("read_frame error: %d", ret);
-            av_packet_free(&pkt);
+            axPacketFree(&pkt);
             if (abort_.load()) break;
             std::this_thread::sleep_for(std::chrono::milliseconds(5));
             continue;
         }
 
+        if (gen != seekGen_.load(std::memory_order_acquire)) {
+            // 读完这个包之后发生过 seek：它属于旧位置（提前丢；阻塞在 push 里时才 seek 的由序号兜底）
+            axPacketFree(&pkt);
+            continue;
+        }
+
+        packetsRead_.fetch_add(1, std::memory_order_relaxed);
+        bytesRead_.fetch_add(pkt->size, std::memory_order_relaxed);
+        if (stampPool_) stampPacket_(pkt);
+
         bool pushed = false;
         if (pkt->stream_index == aIdx_ && aQ_) {
+            axSetPacketSerial(pkt, aSerial);
             pushed = aQ_->push(pkt);
         } else if (pkt->stream_index == vIdx_ && vQ_) {
+            axSetPacketSerial(pkt, vSerial);
             pushed = vQ_->push(pkt);
         }
 
         if (!pushed) {
             // 队列已被 abort 或者其它原因导致 push 失败
-            av_packet_free(&pkt);
+            axPacketFree(&pkt);
             if (abort_.load()) break;
             // 如果只是容量满而未 abort，这里不要马上退出；轻微让步
             std::this_thread::sleep_for(std::chrono::milliseconds(1));
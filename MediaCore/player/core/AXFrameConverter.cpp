@@ -0,0 +1,156 @@
+//AXPlayerLib/MediaCore/player/core/AXFrameConverter.cpp
+#include "AXFrameConverter.h"
+
+extern "C" {
+#include <libavutil/pixdesc.h>
+#include <libswscale/swscale.h>
+}
+
+#if __has_include(<libyuv.h>)
+#include <libyuv.h>
+#define AX_HAS_LIBYUV 1
+#endif
+
+#define AX_LOG_TAG "AXFrameConverter"
+#include "AXLog.h"
+
+#if defined(AX_HAS_LIBYUV)
+namespace {
+// 单平面源 → I420 的 libyuv 入口（打包 RGB / YUY2 / 灰度共用同一签名）
+using PackedToI420 = int (*)(const uint8_t*, int, uint8_t*, int, uint8_t*, int, uint8_t*, int, int, int);
+
+// libyuv 的格式名按小端 32 位字序命名，与 FFmpeg 的内存字节序相反：FFmpeg BGRA == libyuv ARGB
+PackedToI420 packedKernel(int fmt) {
+    switch (fmt) {
+        case AV_PIX_FMT_BGRA:
+        case AV_PIX_FMT_BGR0:     return libyuv::ARGBToI420;
+        case AV_PIX_FMT_RGBA:
+        case AV_PIX_FMT_RGB0:     return libyuv::ABGRToI420;
+        case AV_PIX_FMT_ARGB:
+        case AV_PIX_FMT_0RGB:     return libyuv::BGRAToI420;
+        case AV_PIX_FMT_ABGR:
+        case AV_PIX_FMT_0BGR:     return libyuv::RGBAToI420;
+        case AV_PIX_FMT_BGR24:    return libyuv::RGB24ToI420;
+        case AV_PIX_FMT_RGB24:    return libyuv::RAWToI420;
+        case AV_PIX_FMT_RGB565LE: return libyuv::RGB565ToI420;
+        case AV_PIX_FMT_YUYV422:  return libyuv::YUY2ToI420;
+        case AV_PIX_FMT_UYVY422:  return libyuv::UYVYToI420;
+        case AV_PIX_FMT_GRAY8:    return libyuv::I400ToI420;
+        default:                  return nullptr;
+    }
+}
+} // namespace
+#endif
+
+AXFrameConverter::~AXFrameConverter() {
+    if (sws_) sws_freeContext(sws_);
+    sws_ = nullptr;
+}
+
+bool AXFrameConverter::hasLibYuv() {
+#if defined(AX_HAS_LIBYUV)
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool AXFrameConverter::libyuvSupports(int pixFmt) {
+#if defined(AX_HAS_LIBYUV)
+    return packedKernel(pixFmt) != nullptr || pixFmt == AV_PIX_FMT_YUVA420P;
+#else
+    (void) pixFmt;
+    return false;
+#endif
+}
+
+const char* AXFrameConverter::backendName(Backend b) {
+    switch (b) {
+        case Backend::LibYuv:  return "libyuv";
+        case Backend::Swscale: return "swscale";
+        default:               return "none";
+    }
+}
+
+// 目标 I420 从池里取；RGB 源按 BT.601 有限范围转换（libyuv 与 swscale 默认一致），色彩标签随之改写
+bool AXFrameConverter::allocI420_(const AVFrame* src, AVFrame* dst) {
+    if (!pool_.allocFrame(dst, src->width, src->height, AV_PIX_FMT_YUV420P, nullptr)) {
+        AX_LOGE("alloc I420 %dx%d failed", src->width, src->height);
+        return false;
+    }
+    av_frame_copy_props(dst, src);
+    const AVPixFmtDescriptor* desc = av_pix_fmt_desc_get((AVPixelFormat) src->format);
+    if (desc && (desc->flags & AV_PIX_FMT_FLAG_RGB)) {
+        dst->colorspace = AVCOL_SPC_SMPTE170M;
+        dst->color_range = AVCOL_RANGE_MPEG;
+    }
+    return true;
+}
+
+bool AXFrameConverter::libyuv_(const AVFrame* src, AVFrame* dst) {
+#if defined(AX_HAS_LIBYUV)
+    const int w = src->width, h = src->height;
+    int ret;
+    if (PackedToI420 fn = packedKernel(src->format)) {
+        ret = fn(src->data[0], src->linesize[0],
+                 dst->data[0], dst->linesize[0], dst->data[1], dst->linesize[1], dst->data[2], dst->linesize[2],
+                 w, h);
+    } else if (src->format == AV_PIX_FMT_YUVA420P) {
+        // 丢弃 alpha 平面
+        ret = libyuv::I420Copy(src->data[0], src->linesize[0], src->data[1], src->linesize[1],
+                               src->data[2], src->linesize[2],
+                               dst->data[0], dst->linesize[0], dst->data[1], dst->linesize[1],
+                               dst->data[2], dst->linesize[2], w, h);
+    } else {
+        return false;
+    }
+    if (ret != 0) {
+        AX_LOGW("libyuv convert fmt=%d failed: %d", src->format, ret);
+        return false;
+    }
+    return true;
+#else
+    (void) src;
+    (void) dst;
+    return false;
+#endif
+}
+
+bool AXFrameConverter::swscale_(const AVFrame* src, AVFrame* dst) {
+    // 同尺寸只换格式：双线性足够（只影响色度重采样），上下文按参数缓存复用
+    sws_ = sws_getCachedContext(sws_, src->width, src->height, (AVPixelFormat) src->format,
+                                src->width, src->height, AV_PIX_FMT_YUV420P, SWS_BILINEAR,
+                                nullptr, nullptr, nullptr);
+    if (!sws_) {
+        AX_LOGW("sws_getCachedContext fmt=%d failed", src->format);
+        return false;
+    }
+    const int rows = sws_scale(sws_, src->data, src->linesize, 0, src->height, dst->data, dst->linesize);
+    return rows > 0;
+}
+
+AXFrameConverter::Backend AXFrameConverter::convertWith(Backend backend, const AVFrame* src, AVFrame* dst) {
+    if (!src || !dst || src->width <= 0 || src->height <= 0) return Backend::None;
+    if (backend == Backend::LibYuv && !libyuvSupports(src->format)) return Backend::None;
+    if (backend == Backend::None) return Backend::None;
+
+    if (!allocI420_(src, dst)) return Backend::None;
+    const bool ok = backend == Backend::LibYuv ? libyuv_(src, dst) : swscale_(src, dst);
+    if (!ok) {
+        av_frame_unref(dst);
+        return Backend::None;
+    }
+    return backend;
+}
+
+AXFrameConverter::Backend AXFrameConverter::convert(const AVFrame* src, AVFrame* dst) {
+    if (!src) return Backend::None;
+    const AVPixFmtDescriptor* desc = av_pix_fmt_desc_get((AVPixelFormat) src->format);
+    if (!desc || (desc->flags & AV_PIX_FMT_FLAG_HWACCEL)) return Backend::None;   // 硬件表面不在 CPU 上
+
+    if (libyuvSupports(src->format)) {
+        const Backend b = convertWith(Backend::LibYuv, src, dst);
+        if (b != Backend::None) return b;
+    }
+    return convertWith(Backend::Swscale, src, dst);
+}
@@ -0,0 +1,120 @@
+//AXPlayerLib/MediaCore/player/core/AXFrameDumpSink.cpp
+#include "AXFrameDumpSink.h"
+
+#define AX_LOG_TAG "AXFrameDumpSink"
+#include "AXLog.h"
+
+extern "C" {
+#include <libavutil/imgutils.h>
+#include <libavutil/pixdesc.h>
+}
+
+static constexpr uint64_t kFnvOffset = 1469598103934665603ULL;
+static constexpr uint64_t kFnvPrime = 1099511628211ULL;
+
+static inline uint64_t fnv1a(uint64_t h, const uint8_t *p, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        h ^= p[i];
+        h *= kFnvPrime;
+    }
+    return h;
+}
+
+// 逐平面遍历可见区域的每一行：fn(plane, rowPtr, rowBytes)
+template<typename Fn>
+static bool forEachVisibleRow(const AVFrame *frm, Fn &&fn) {
+    const auto fmt = (AVPixelFormat) frm->format;
+    const AVPixFmtDescriptor *desc = av_pix_fmt_desc_get(fmt);
+    if (!desc || (desc->flags & AV_PIX_FMT_FLAG_HWACCEL)) return false;
+    int lines[4] = {0, 0, 0, 0};
+    if (av_image_fill_linesizes(lines, fmt, frm->width) < 0) return false;
+
+    const int planes = av_pix_fmt_count_planes(fmt);
+    for (int p = 0; p < planes && p < 4; ++p) {
+        if (!frm->data[p]) continue;
+        // 与 av_image_copy 相同：1/2 号平面为色度（RGB 类除外）
+        const bool chroma = (p == 1 || p == 2) && !(desc->flags & AV_PIX_FMT_FLAG_RGB);
+        const int rows = chroma ? -((-frm->height) >> desc->log2_chroma_h) : frm->height;
+        for (int y = 0; y < rows; ++y) {
+            fn(p, frm->data[p] + (ptrdiff_t) y * frm->linesize[p], (size_t) lines[p]);
+        }
+    }
+    return true;
+}
+
+AXFrameDumpSink::AXFrameDumpSink(std::string yuvPath) : yuvPath_(std::move(yuvPath)) {}
+
+AXFrameDumpSink::~AXFrameDumpSink() { release(); }
+
+bool AXFrameDumpSink::init(ANativeWindow * /*win*/, int w, int h, int sarNum, int sarDen) {
+    std::lock_guard<std::mutex> lk(mtx_);
+    if (!yuvPath_.empty() && !yuv_) {
+        yuv_ = std::fopen(yuvPath_.c_str(), "wb");
+        if (!yuv_) {
+            AX_LOGE("open %s failed", yuvPath_.c_str());
+            return false;
+        }
+    }
+    AX_LOGI("init ok: w=%d h=%d sar=%d/%d dump=%s", w, h, sarNum, sarDen,
+            yuvPath_.empty() ? "-" : yuvPath_.c_str());
+    return true;
+}
+
+int64_t AXFrameDumpSink::drawLoopOnce(int64_t masterPtsUs) {
+    int64_t waitUs = kNoFrame;
+    AVFrame *frm = takeDueFrame_(masterPtsUs, waitUs);
+    if (!frm) return waitUs;
+    present_(frm);
+    axFrameFree(&frm);
+    return 0;
+}
+
+void AXFrameDumpSink::present_(const AVFrame *frm) {
+    const uint64_t h = hashFrame(frm);
+    const int64_t ptsUs = framePtsUs_(frm, tb_);
+
+    std::lock_guard<std::mutex> lk(mtx_);
+    if (st_.frames == 0) {
+        st_.seqHash = kFnvOffset;
+        st_.firstPtsUs = ptsUs;
+    }
+    if (st_.format != frm->format || st_.width != frm->width || st_.height != frm->height) {
+        const char *fmtName = av_get_pix_fmt_name((AVPixelFormat) frm->format);
+        AX_LOGI("frame format: %s %dx%d", fmtName ? fmtName : "?", frm->width, frm->height);
+        st_.format = frm->format;
+        st_.width = frm->width;
+        st_.height = frm->height;
+    }
+    st_.frames++;
+    st_.lastPtsUs = ptsUs;
+    st_.lastHash = h;
+    st_.seqHash = fnv1a(st_.seqHash, reinterpret_cast<const uint8_t *>(&h), sizeof(h));
+
+    if (yuv_) {
+        forEachVisibleRow(frm, [this](int, const uint8_t *row, size_t n) { std::fwrite(row, 1, n, yuv_); });
+    }
+}
+
+uint64_t AXFrameDumpSink::hashFrame(const AVFrame *frm) {
+    if (!frm) return 0;
+    uint64_t h = kFnvOffset;
+    if (!forEachVisibleRow(frm, [&h](int, const uint8_t *row, size_t n) { h = fnv1a(h, row, n); })) return 0;
+    return h;
+}
+
+AXFrameDumpSink::Stats AXFrameDumpSink::stats() const {
+    std::lock_guard<std::mutex> lk(mtx_);
+    Stats s = st_;
+    s.dropped = framesDropped();
+    return s;
+}
+
+void AXFrameDumpSink::release() {
+    dropPending_();
+    std::lock_guard<std::mutex> lk(mtx_);
+    if (yuv_) {
+        std::fclose(yuv_);
+        yuv_ = nullptr;
+        AX_LOGI("dump closed: %s, %lld frames", yuvPath_.c_str(), (long long) st_.frames);
+    }
+}
@@ -0,0 +1,142 @@
+//AXPlayerLib/MediaCore/player/core/AXFrameScheduler.cpp
+#include "AXFrameScheduler.h"
+
+#include <algorithm>
+#include <cmath>
+
+// 刷新周期合理范围：240Hz ~ 20Hz
+static constexpr int64_t kMinVsyncUs = 4'000;
+static constexpr int64_t kMaxVsyncUs = 50'000;
+// 两次交换之间最多按几个刷新周期拆分：24fps@120Hz 为 5，24fps@144Hz 为 6，留到 8（24fps@165/180Hz 的 7/8 个）
+static constexpr int kMaxVsyncsPerSwap = 8;
+
+void AXFrameScheduler::reset() {
+    lastPtsUs_ = -1;
+}
+
+void AXFrameScheduler::setNominalVsyncUs(int64_t us) {
+    if (us < kMinVsyncUs || us > kMaxVsyncUs) return;
+    vsyncUs_ = us;
+    deltaCount_ = 0;
+    deltaIdx_ = 0;
+}
+
+void AXFrameScheduler::onFrame(int64_t ptsUs) {
+    if (ptsUs < 0) return;
+    if (lastPtsUs_ >= 0) {
+        const int64_t d = ptsUs - lastPtsUs_;
+        // 乱序、重复或跨过断点的间隔不参与估计
+        if (d >= 1'000 && d <= 200'000) frameUs_ += (d - frameUs_) / 8;
+    }
+    lastPtsUs_ = ptsUs;
+}
+
+void AXFrameScheduler::onPresented(int64_t swapDoneUs) {
+    if (lastSwapUs_ >= 0) {
+        const int64_t d = swapDoneUs - lastSwapUs_;
+        if (d >= kMinVsyncUs && d <= 250'000) {
+            deltas_[deltaIdx_] = d;
+            deltaIdx_ = (deltaIdx_ + 1) % kDeltaWindow;
+            deltaCount_ = std::min(deltaCount_ + 1, kDeltaWindow);
+            refineVsync_();
+        }
+    }
+    lastSwapUs_ = swapDoneUs;
+}
+
+/**
+ * 两次交换之间隔的是整数个刷新周期（帧率低于刷新率时 >1，且可能交替，如 24fps@60Hz 的 2/3、30fps@90Hz 追帧后的 2/3）。
+ * 取窗口内每个间隔的 1/m（m = 1..kMaxVsyncsPerSwap）作候选周期，能让至少 7/8 的间隔落在整数倍附近的候选里选最接近当前估计的，
+ * 再用这些间隔的总时长 / 总周期数得到精确值；偶发的短间隔（交换未阻塞、追帧连交）作为离群值被忽略。
+ * 所有间隔都是同一个倍数时（如 30fps@60Hz 恒为 2 个、24fps@120Hz 恒为 5 个周期）数据本身无法区分，保留最接近当前估计的解：
+ * 起播追帧、卡顿后连交等不均匀的间隔会先把估计定在真实周期上，之后的均匀间隔只是维持它；没有这类样本时停在先验（60Hz）附近。
+ * m 的上限必须覆盖“每帧最多几个刷新周期”：真实周期不在候选里时只能选一个既非约数也非倍数的周期
+ * （例如 m 只到 4 时 24fps@120Hz 会落到 41.67/4 = 10.42ms），预测的 vsync 网格会逐渐偏离真实网格。
+ */
+void AXFrameScheduler::refineVsync_() {
+    if (deltaCount_ < 4) {
+        // 样本太少：按当前估计折算成单周期平滑
+        const int64_t d = deltas_[(deltaIdx_ + kDeltaWindow - 1) % kDeltaWindow];
+        const int64_t n = std::max<int64_t>(1, std::llround((double) d / (double) vsyncUs_));
+        vsyncUs_ += (d / n - vsyncUs_) / 2;
+        vsyncUs_ = std::min(kMaxVsyncUs, std::max(kMinVsyncUs, vsyncUs_));
+        return;
+    }
+    double best = 0, bestDist = 0;
+    for (int j = 0; j < deltaCount_; ++j) {
+        for (int m = 1; m <= kMaxVsyncsPerSwap; ++m) {
+            const double p = (double) deltas_[j] / m;
+            if (p < (double) kMinVsyncUs) break;
+            int fit = 0;
+            for (int i = 0; i < deltaCount_; ++i) {
+                const double k = (double) deltas_[i] / p;
+                if (k >= 0.85 && std::fabs(k - std::round(k)) <= 0.15) ++fit;
+            }
+            if (fit * 8 < deltaCount_ * 7) continue;
+            const double dist = std::fabs(std::log(p / (double) vsyncUs_));
+            if (best <= 0 || dist < bestDist) {
+                best = p;
+                bestDist = dist;
+            }
+        }
+    }
+    if (best <= 0) return;   // 没有一致的周期：保持原估计
+    double sum = 0, periods = 0;
+    for (int i = 0; i < deltaCount_; ++i) {
+        const double k = std::round((double) deltas_[i] / best);
+        if (k >= 1 && std::fabs((double) deltas_[i] / best - k) <= 0.15) {
+            sum += (double) deltas_[i];
+            periods += k;
+        }
+    }
+    if (periods > 0) vsyncUs_ = std::min(kMaxVsyncUs, std::max(kMinVsyncUs, (int64_t) std::llround(sum / periods)));
+}
+
+int64_t AXFrameScheduler::submitLeadUs_() const {
+    return std::min<int64_t>(1'000, vsyncUs_ / 8);
+}
+
+int64_t AXFrameScheduler::nextVsyncUs(int64_t nowUs) const {
+    if (lastSwapUs_ < 0) return nowUs;
+    // 上一次交换刚落在一个 vsync 上；提交（上传 + 绘制）要留出余量，贴着 vsync 提交的帧赶不上这一个
+    const int64_t ready = nowUs + submitLeadUs_();
+    const int64_t k = std::max<int64_t>(1, (ready - lastSwapUs_ + vsyncUs_ - 1) / vsyncUs_);
+    return lastSwapUs_ + k * vsyncUs_;
+}
+
+int64_t AXFrameScheduler::lateLimitUs() const {
+    const int64_t byVsync = (int64_t) ((double) vsyncUs_ * 6.0 * speed_);
+    return std::min<int64_t>(500'000, std::max<int64_t>(80'000, std::max(frameUs_ * 4, byVsync)));
+}
+
+AXFrameScheduler::Decision AXFrameScheduler::decide(int64_t ptsUs, int64_t nextPtsUs,
+                                                    int64_t masterUs, int64_t nowUs) const {
+    Decision d;
+    if (ptsUs < 0) return d;   // 未知 PTS：直接呈现
+
+    const double sp = speed_;
+    const int64_t half = (int64_t) ((double) vsyncUs_ * sp / 2.0);
+    const int64_t vNext = nextVsyncUs(nowUs);
+    const int64_t mediaAtV = masterUs + (int64_t) ((double) (vNext - nowUs) * sp);
+
+    // 下一帧也落在这个 vsync 的窗口里：当前帧永远没有机会上屏
+    if (nextPtsUs >= 0 && nextPtsUs <= mediaAtV + half) {
+        d.action = Action::Drop;
+        return d;
+    }
+    if (ptsUs < mediaAtV - lateLimitUs()) {
+        d.action = Action::Drop;
+        return d;
+    }
+    if (ptsUs > mediaAtV + half) {
+        // 目标 vsync：主时钟首次达到 pts - half 的那个；醒在它前一个周期的 1/4 处（远离两端，休眠误差不至于错过），
+        // 届时预测正好指向它
+        const int64_t needWall = nowUs + (int64_t) ((double) (ptsUs - half - masterUs) / sp);
+        const int64_t target = nextVsyncUs(needWall);
+        const int64_t wakeWall = std::max(nowUs, target - vsyncUs_ + vsyncUs_ / 4);
+        d.action = Action::Wait;
+        d.waitUs = std::max<int64_t>((int64_t) (500.0 * sp), (int64_t) ((double) (wakeWall - nowUs) * sp));
+        return d;
+    }
+    return d;
+}
@@ -0,0 +1,213 @@
+//AXPlayerLib/MediaCore/player/core/AXHostAudioSinks.cpp
+// 不依赖音频设备的 sink：null（不限速丢弃）、WAV 文件、按墙钟节拍的假 DAC。
+// 都由一个输出线程驱动 Source::onPull，播放头 = 已拉取的帧数。
+
+#include "AXAudioSink.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#define AX_LOG_TAG "AXHostAudioSink"
+#include "AXLog.h"
+
+static int64_t monoNs() {
+    timespec ts{};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t) ts.tv_sec * 1'000'000'000LL + ts.tv_nsec;
+}
+
+class AXPullThreadSink : public AXAudioSink {
+public:
+    AXPullThreadSink(const char *name, const Params &p, bool paced) : name_(name), paced_(paced) {
+        params_ = p;
+        if (params_.sampleRate <= 0) params_.sampleRate = 48000;
+        if (params_.channels <= 0) params_.channels = 2;
+        if (params_.framesPerBurst <= 0) params_.framesPerBurst = 192;
+    }
+
+    ~AXPullThreadSink() override { close(); }
+
+    const char *name() const override { return name_; }
+
+    bool open(Source *src) override {
+        src_ = src;
+        const int bpf = params_.channels * (params_.isFloat ? 4 : 2);
+        buf_.assign((size_t) params_.framesPerBurst * bpf, 0);
+        if (!onOpen_()) return false;
+        AX_LOGI("%s opened: rate=%d ch=%d fmt=%s burst=%d paced=%d", name_, params_.sampleRate,
+                params_.channels, params_.isFloat ? "F32" : "S16", params_.framesPerBurst, (int) paced_);
+        return true;
+    }
+
+    const Params &params() const override { return params_; }
+
+    bool start() override {
+        if (!src_) return false;
+        if (thread_.joinable()) return true;
+        running_.store(true);
+        thread_ = std::thread(&AXPullThreadSink::loop_, this);
+        return true;
+    }
+
+    void stop() override {
+        running_.store(false);
+        if (thread_.joinable()) thread_.join();
+    }
+
+    void close() override {
+        stop();
+        if (src_) {
+            onClose_();
+            src_ = nullptr;
+        }
+    }
+
+    bool getTimestamp(int64_t &framePos, int64_t &timeNs) override {
+        std::lock_guard<std::mutex> lk(tsMtx_);
+        if (tsNs_ == 0) return false;
+        framePos = played_;
+        // 不限速时“设备”没有独立节拍：播放头就是此刻已取走的帧
+        timeNs = paced_ ? tsNs_ : monoNs();
+        return true;
+    }
+
+protected:
+    virtual bool onOpen_() { return true; }
+
+    virtual void onClose_() {}
+
+    // 处理一批“已播放”的输出：不限速时只含真实数据；限速时为整个 burst（含欠载静音）
+    virtual void consume_(const uint8_t * /*data*/, int32_t /*frames*/) {}
+
+    Params params_;
+
+private:
+    void loop_() {
+        const int32_t burst = params_.framesPerBurst;
+        const auto period = std::chrono::nanoseconds((int64_t) burst * 1'000'000'000LL / params_.sampleRate);
+        auto next = std::chrono::steady_clock::now();
+        while (running_.load(std::memory_order_relaxed)) {
+            if (paced_) {
+                next += period;
+                std::this_thread::sleep_until(next);
+            }
+            const int32_t filled = src_->onPull(buf_.data(), burst, devFrames_);
+            if (!paced_ && filled <= 0) {
+                // 不限速且没数据：不推进“设备”，稍后再取，避免空转
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                continue;
+            }
+            const int32_t advance = paced_ ? burst : filled;
+            consume_(buf_.data(), advance);
+            devFrames_ += advance;
+            std::lock_guard<std::mutex> lk(tsMtx_);
+            played_ = devFrames_;
+            tsNs_ = monoNs();
+        }
+    }
+
+    const char *name_;
+    const bool paced_;
+    Source *src_{nullptr};
+    std::vector<uint8_t> buf_;
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    int64_t devFrames_{0};                // 仅输出线程
+
+    std::mutex tsMtx_;
+    int64_t played_{0};
+    int64_t tsNs_{0};
+};
+
+// ======================= WAV =======================
+class AXWavAudioSink : public AXPullThreadSink {
+public:
+    AXWavAudioSink(std::string path, const Params &p, bool paced)
+            : AXPullThreadSink("wav", p, paced), path_(std::move(path)) {}
+
+    ~AXWavAudioSink() override { close(); }
+
+protected:
+    bool onOpen_() override {
+        fp_ = std::fopen(path_.c_str(), "wb");
+        if (!fp_) {
+            AX_LOGE("open %s failed", path_.c_str());
+            return false;
+        }
+        bytes_ = 0;
+        writeHeader_();
+        return true;
+    }
+
+    void onClose_() override {
+        if (!fp_) return;
+        std::fseek(fp_, 0, SEEK_SET);
+        writeHeader_();   // 回填长度
+        std::fclose(fp_);
+        fp_ = nullptr;
+        AX_LOGI("wav closed: %s, %u bytes", path_.c_str(), bytes_);
+    }
+
+    void consume_(const uint8_t *data, int32_t frames) override {
+        if (!fp_) return;
+        bytes_ += (uint32_t) std::fwrite(data, 1, (size_t) frames * bytesPerFrame_(), fp_);
+    }
+
+private:
+    int bytesPerFrame_() const { return params_.channels * (params_.isFloat ? 4 : 2); }
+
+    void put32_(uint32_t v) { std::fwrite(&v, 4, 1, fp_); }
+
+    void put16_(uint16_t v) { std::fwrite(&v, 2, 1, fp_); }
+
+    // 小端 RIFF/WAVE；F32 用 WAVE_FORMAT_IEEE_FLOAT(3)，S16 用 PCM(1)
+    void writeHeader_() {
+        const int bpf = bytesPerFrame_();
+        std::fwrite("RIFF", 1, 4, fp_);
+        put32_(36 + bytes_);
+        std::fwrite("WAVEfmt ", 1, 8, fp_);
+        put32_(16);
+        put16_(params_.isFloat ? 3 : 1);
+        put16_((uint16_t) params_.channels);
+        put32_((uint32_t) params_.sampleRate);
+        put32_((uint32_t) (params_.sampleRate * bpf));
+        put16_((uint16_t) bpf);
+        put16_(params_.isFloat ? 32 : 16);
+        std::fwrite("data", 1, 4, fp_);
+        put32_(bytes_);
+    }
+
+    std::string path_;
+    FILE *fp_{nullptr};
+    uint32_t bytes_{0};
+};
+
+// ======================= 工厂 =======================
+std::unique_ptr<AXAudioSink> axCreateNullAudioSink(const AXAudioSink::Params &p) {
+    return std::make_unique<AXPullThreadSink>("null", p, false);
+}
+
+std::unique_ptr<AXAudioSink> axCreateWavAudioSink(const std::string &path, const AXAudioSink::Params &p, bool paced) {
+    return std::make_unique<AXWavAudioSink>(path, p, paced);
+}
+
+std::unique_ptr<AXAudioSink> axCreateFakeDacAudioSink(const AXAudioSink::Params &p) {
+    return std::make_unique<AXPullThreadSink>("fakedac", p, true);
+}
+
+std::unique_ptr<AXAudioSink> axCreateDefaultAudioSink() {
+#if defined(AX_WITH_OBOE)
+    return axCreateOboeSink();
+#elif defined(__ANDROID__)
+    AX_LOGE("built WITHOUT Oboe. Please enable AX_WITH_OBOE and add MediaCore/oboe.");
+    return nullptr;
+#else
+    return axCreateFakeDacAudioSink();
+#endif
+}
@@ -0,0 +1,138 @@
+//AXPlayerLib/MediaCore/player/core/AXOboeSink.cpp
+// Oboe 后端（AAudio 优先）：数据回调里向 Source 拉 PCM
+
+#include "AXAudioSink.h"
+#include "AXTrace.h"
+
+#if defined(AX_WITH_OBOE)
+
+#include <oboe/Oboe.h>
+
+#define AX_LOG_TAG "AXOboeSink"
+#include "AXLog.h"
+
+class AXOboeSink : public AXAudioSink, public oboe::AudioStreamCallback {
+public:
+    ~AXOboeSink() override { close(); }
+
+    const char *name() const override { return "oboe"; }
+
+    bool open(Source *src) override {
+        using namespace oboe;
+        src_ = src;
+        // 回调线程的 trace 环在这里（非实时线程）建好，回调里不分配、不加锁；新流换了回调线程，重新记一次线程 id
+        if (!traceRing_) traceRing_ = AXTrace::createRing("OboeCallback");
+        traceAttached_ = false;
+
+        AudioStreamBuilder b;
+        b.setDirection(Direction::Output);
+        b.setPerformanceMode(PerformanceMode::LowLatency);
+        b.setSharingMode(SharingMode::Exclusive);
+        b.setUsage(Usage::Media);
+        b.setContentType(ContentType::Music);
+
+        // 优先 F32，失败再回退
+        b.setFormat(AudioFormat::Float);
+        b.setCallback(this);
+
+        // 让系统选最优采样率/通道（若你想强制 8ch，可先 setChannelCount(8) 再失败降级）
+        // 这里采用“先申请 8→6→2”的策略
+        static const int kTryCh[] = {2, 6, 8};
+        AudioStream *tmp = nullptr;
+        Result r = Result::OK;
+        for (int ch: kTryCh) {
+            b.setChannelCount(ch);
+            r = b.openStream(&tmp);
+            if (r == Result::OK) {
+                stream_.reset(tmp);
+                break;
+            }
+        }
+        if (!stream_) {
+            // 回退 2ch + I16
+            b.setFormat(AudioFormat::I16);
+            b.setChannelCount(2);
+            r = b.openStream(&tmp);
+            if (r == Result::OK) stream_.reset(tmp);
+        }
+        if (!stream_) {
+            AX_LOGE("Oboe openStream failed: %s", convertToText(r));
+            return false;
+        }
+
+        // 拿到最终参数
+        params_.sampleRate = stream_->getSampleRate();
+        params_.channels = stream_->getChannelCount();
+        params_.isFloat = (stream_->getFormat() == AudioFormat::Float);
+        params_.framesPerBurst = stream_->getFramesPerBurst();
+
+        AX_LOGI("Oboe opened: rate=%d, ch=%d, fmt=%s, burst=%d, perf=%d, share=%d",
+                params_.sampleRate, params_.channels, params_.isFloat ? "F32" : "S16",
+                params_.framesPerBurst, (int) stream_->getPerformanceMode(),
+                (int) stream_->getSharingMode());
+        return true;
+    }
+
+    const Params &params() const override { return params_; }
+
+    bool start() override {
+        if (!stream_) return false;
+        const oboe::Result r = stream_->requestStart();
+        if (r != oboe::Result::OK) {
+            AX_LOGE("Oboe requestStart failed: %s", oboe::convertToText(r));
+            return false;
+        }
+        return true;
+    }
+
+    void stop() override {
+        if (stream_) (void) stream_->requestStop();
+    }
+
+    void close() override {
+        if (stream_) {
+            (void) stream_->requestStop();
+            stream_.reset();
+        }
+    }
+
+    bool getTimestamp(int64_t &framePos, int64_t &timeNs) override {
+        if (!stream_) return false;
+        return stream_->getTimestamp(CLOCK_MONOTONIC, &framePos, &timeNs) == oboe::Result::OK;
+    }
+
+    // ========== 回调：实时线程，只做无锁拉取 ==========
+    oboe::DataCallbackResult
+    onAudioReady(oboe::AudioStream *, void *audioData, int32_t numFrames) override {
+        if (!src_) return oboe::DataCallbackResult::Stop;
+        if (!traceAttached_) {
+            AXTrace::attachRing(traceRing_.get());
+            traceAttached_ = true;
+        }
+        AX_TRACE_SCOPE_RING("oboe_onAudioReady", traceRing_.get());
+        const int64_t devPos = devFrames_;
+        devFrames_ += numFrames;
+        (void) src_->onPull(audioData, numFrames, devPos);
+        return oboe::DataCallbackResult::Continue;
+    }
+
+    void onErrorAfterClose(oboe::AudioStream *, oboe::Result r) override {
+        AX_LOGE("Oboe onErrorAfterClose: %s", oboe::convertToText(r));
+        // 让上层感知非活跃，必要时触发重建
+        if (src_) src_->onSinkError();
+    }
+
+private:
+    Source *src_{nullptr};
+    std::unique_ptr<oboe::AudioStream> stream_;
+    Params params_;
+    int64_t devFrames_{0};                 // 已交给设备的帧数（仅回调线程）
+    std::shared_ptr<AXTraceRing> traceRing_;   // 回调线程的 trace 环（未开 AX_TRACE 时为空）
+    bool traceAttached_{false};            // 本条流的回调线程已记下线程 id（open 后仅回调线程）
+};
+
+std::unique_ptr<AXAudioSink> axCreateOboeSink() {
+    return std::make_unique<AXOboeSink>();
+}
+
+#endif
@@ -0,0 +1,201 @@
+//AXPlayerLib/MediaCore/player/core/AXPcmFifo.cpp
+
+#include "AXPcmFifo.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#define AX_LOG_TAG "AXPcmFifo"
+#include "AXLog.h"
+
+bool AXPcmFifo::configure(int32_t capFrames, int32_t bytesPerFrame, int32_t sampleRate) {
+    if (capFrames <= 0 || bytesPerFrame <= 0 || sampleRate <= 0) return false;
+    int64_t cap = 1;
+    while (cap < capFrames) cap <<= 1;
+
+    rate_ = sampleRate;
+    // 规格不变：复用存储，只做一次 clear（此时生产者可能仍在跑，不能重置位置）
+    if (buf_ && cap == capFrames_ && bytesPerFrame == bpf_) {
+        clear();
+        return true;
+    }
+
+    buf_.reset(new (std::nothrow) uint8_t[(size_t) (cap * bytesPerFrame)]);
+    if (!buf_) {
+        AX_LOGE("alloc %lld frames x %d bytes failed", (long long) cap, bytesPerFrame);
+        capFrames_ = mask_ = 0;
+        bpf_ = 0;
+        return false;
+    }
+    capFrames_ = cap;
+    mask_ = cap - 1;
+    bpf_ = bytesPerFrame;
+    readPos_.store(0, std::memory_order_relaxed);
+    writePos_.store(0, std::memory_order_relaxed);
+    resvEnd_.store(0, std::memory_order_relaxed);
+    clearPos_.store(0, std::memory_order_relaxed);
+    mTail_.store(0, std::memory_order_relaxed);
+    mHead_.store(0, std::memory_order_relaxed);
+    mClear_.store(0, std::memory_order_release);
+    AX_LOGI("configured: %lld frames x %d bytes @%dHz", (long long) cap, bytesPerFrame, sampleRate);
+    return true;
+}
+
+void AXPcmFifo::clear() {
+    // 先推进 epoch：此后才 beginWrite 的写入属于 clear 之后，保留；此前已预留的写入由下面的清除点覆盖。
+    // 清除点取预留末端而不是 writePos：正在写的那段（可能在 clear 之后才提交）也一并作废。
+    // 先取标记头再取位置：两者之间推入的标记要么属于被覆盖的那段（pos < clearPos，读侧不用），
+    // 要么 pos == 新 clearPos，仍然有效
+    epoch_.fetch_add(1, std::memory_order_seq_cst);
+    const uint64_t h = mHead_.load(std::memory_order_seq_cst);
+    const int64_t w = std::max(writePos_.load(std::memory_order_seq_cst), resvEnd_.load(std::memory_order_seq_cst));
+
+    int64_t c = clearPos_.load(std::memory_order_relaxed);
+    while (c < w && !clearPos_.compare_exchange_weak(c, w, std::memory_order_acq_rel)) {}
+    uint64_t mc = mClear_.load(std::memory_order_relaxed);
+    while (mc < h && !mClear_.compare_exchange_weak(mc, h, std::memory_order_acq_rel)) {}
+}
+
+int64_t AXPcmFifo::effectiveRead_() const {
+    return std::max(readPos_.load(std::memory_order_acquire), clearPos_.load(std::memory_order_acquire));
+}
+
+// ======================= 生产者 =======================
+int32_t AXPcmFifo::writableFrames() const {
+    if (!buf_) return 0;
+    const int64_t used = writePos_.load(std::memory_order_acquire) - effectiveRead_();
+    return (int32_t) (capFrames_ - std::max<int64_t>(used, 0));
+}
+
+int32_t AXPcmFifo::beginWrite(Region& r, int32_t maxFrames) {
+    r = Region{};
+    if (!buf_ || maxFrames <= 0) return 0;
+    int64_t w = writePos_.load(std::memory_order_relaxed);
+    const int64_t eff = effectiveRead_();
+    if (w < eff) {
+        // 清除点越过了写位置（覆盖了未提交/被丢弃的预留段）：从清除点接着写
+        w = eff;
+        writePos_.store(w, std::memory_order_release);
+    }
+    const int64_t room = capFrames_ - (w - eff);
+    const int32_t n = (int32_t) std::min<int64_t>(room, maxFrames);
+    if (n <= 0) return 0;
+
+    // 先发布预留、再取 epoch（都是 seq_cst，与 clear 的顺序相反）：
+    // 与之并发的 clear 要么看到这次预留并把它覆盖，要么推进 epoch 在先、这段算 clear 之后的数据
+    resvEnd_.store(w + n, std::memory_order_seq_cst);
+    writeEpoch_ = epoch_.load(std::memory_order_seq_cst);
+
+    const int64_t idx = w & mask_;
+    const int32_t first = (int32_t) std::min<int64_t>(n, capFrames_ - idx);
+    r.ptr[0] = buf_.get() + idx * bpf_;
+    r.frames[0] = first;
+    if (n > first) {
+        r.ptr[1] = buf_.get();
+        r.frames[1] = n - first;
+    }
+    return n;
+}
+
+bool AXPcmFifo::commitWrite(int32_t frames, int64_t ptsUs, float speed) {
+    if (frames <= 0) return true;
+    if (epoch_.load(std::memory_order_acquire) != writeEpoch_) {
+        // beginWrite 之后被 clear：这段是 clear 之前的数据，清除点已覆盖预留区，不再发布
+        droppedWrites_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    const int64_t w = writePos_.load(std::memory_order_relaxed);
+    if (ptsUs >= 0) pushMarker_(w, ptsUs, speed > 0.f ? speed : 1.f);   // 标记先于数据发布
+    writePos_.store(w + frames, std::memory_order_release);
+    resvEnd_.store(w + frames, std::memory_order_release);   // 只提交了一部分：收回多预留的尾巴
+    return true;
+}
+
+int32_t AXPcmFifo::write(const void* src, int32_t frames, int64_t ptsUs, float speed) {
+    Region r;
+    const int32_t n = beginWrite(r, frames);
+    if (n <= 0) return 0;
+    const uint8_t* s = static_cast<const uint8_t*>(src);
+    std::memcpy(r.ptr[0], s, (size_t) r.frames[0] * bpf_);
+    if (r.frames[1] > 0) std::memcpy(r.ptr[1], s + (size_t) r.frames[0] * bpf_, (size_t) r.frames[1] * bpf_);
+    return commitWrite(n, ptsUs, speed) ? n : 0;
+}
+
+void AXPcmFifo::pushMarker_(int64_t pos, int64_t ptsUs, float speed) {
+    const uint64_t h = mHead_.load(std::memory_order_relaxed);
+    const uint64_t t = std::max(mTail_.load(std::memory_order_acquire), mClear_.load(std::memory_order_acquire));
+    if (h - t >= kMarkerCap) {
+        // 标记环满（消费者长期未运行）：丢标记，读侧按上一个标记外推
+        droppedMarkers_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    markers_[h & (kMarkerCap - 1)] = Marker{pos, ptsUs, speed};
+    mHead_.store(h + 1, std::memory_order_release);
+}
+
+// ======================= 消费者 =======================
+int64_t AXPcmFifo::ptsAt_(int64_t pos, float& speed) {
+    uint64_t t = std::max(mTail_.load(std::memory_order_relaxed), mClear_.load(std::memory_order_acquire));
+    const uint64_t h = mHead_.load(std::memory_order_acquire);
+    while (t + 1 < h && markers_[(t + 1) & (kMarkerCap - 1)].pos <= pos) ++t;
+    mTail_.store(t, std::memory_order_release);
+
+    if (t >= h) return -1;
+    const Marker& m = markers_[t & (kMarkerCap - 1)];
+    // clear 之前的旧标记不能用来外推 clear 之后的数据
+    if (m.pos > pos || m.pos < clearPos_.load(std::memory_order_acquire)) return -1;
+    speed = m.speed;
+    return m.ptsUs + (int64_t) ((double) (pos - m.pos) * 1e6 * m.speed / rate_);
+}
+
+int32_t AXPcmFifo::read(void* dst, int32_t frames, int64_t& firstPtsUs, float* speed) {
+    firstPtsUs = -1;
+    float markSpeed = 1.f;
+    if (frames <= 0) return 0;
+    uint8_t* out = static_cast<uint8_t*>(dst);
+    if (!buf_) {
+        std::memset(out, 0, (size_t) frames * (bpf_ > 0 ? bpf_ : 1));
+        return 0;
+    }
+
+    const int64_t clr = clearPos_.load(std::memory_order_acquire);
+    const int64_t r = std::max(readPos_.load(std::memory_order_relaxed), clr);
+    const int64_t w = writePos_.load(std::memory_order_acquire);
+    const int32_t n = (int32_t) std::min<int64_t>(frames, w - r);
+
+    if (n > 0) {
+        const int64_t idx = r & mask_;
+        const int32_t first = (int32_t) std::min<int64_t>(n, capFrames_ - idx);
+        std::memcpy(out, buf_.get() + idx * bpf_, (size_t) first * bpf_);
+        if (n > first) std::memcpy(out + (size_t) first * bpf_, buf_.get(), (size_t) (n - first) * bpf_);
+        firstPtsUs = ptsAt_(r, markSpeed);
+        if (speed) *speed = markSpeed;
+
+        // 拷贝期间被 clear：生产者可能已覆盖这段，整块作废（输出静音，不推进读位置）
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (clearPos_.load(std::memory_order_relaxed) != clr) {
+            std::memset(out, 0, (size_t) frames * bpf_);
+            firstPtsUs = -1;
+            return 0;
+        }
+        readPos_.store(r + n, std::memory_order_release);
+    }
+    if (n < frames) {
+        const int32_t done = n > 0 ? n : 0;
+        std::memset(out + (size_t) done * bpf_, 0, (size_t) (frames - done) * bpf_);
+    }
+    return n > 0 ? n : 0;
+}
+
+// ======================= 查询 =======================
+int64_t AXPcmFifo::framesAvailable() const {
+    if (!buf_) return 0;
+    const int64_t n = writePos_.load(std::memory_order_acquire) - effectiveRead_();
+    return n > 0 ? n : 0;
+}
+
+int64_t AXPcmFifo::durationUs() const {
+    if (rate_ <= 0) return 0;
+    return framesAvailable() * 1000000LL / rate_;
+}
@@ -1,21 +1,25 @@
 #include "AXPlayer.h"
-#include <android/log.h>
-#include <android/native_window.h>
-#include <jni.h>
 #include <chrono>
 #include <thread>
 #include <fcntl.h>
 #include <unistd.h>
 #include <sys/stat.h>
 #include <cstdlib>
+#include <algorithm>
 
 #include "AXDemuxer.h"
 #include "AXDecoder.h"
+#if defined(__ANDROID__)
 #include "AXVideoRenderer.h"
+#else
+#include "AXFrameDumpSink.h"
+#endif
 #include "AXAudioRenderer.h"
 #include "AXClock.h"
 #include "AXQueues.h"
+#include "AXAvPool.h"
 #include "AXErrors.h"
+#include "AXTrace.h"
 
 extern "C" {
 #include <libavformat/avformat.h>
@@ -38,6 +42,7 @@ void AXPlayer::SetJavaVM(JavaVM* vm) {
 }
 JavaVM* AXPlayer::GetJavaVM() { return AXPlayer::sVm; }
 
+#if defined(__ANDROID__)
 struct JniThreadScope {
     bool attached = false;
     JNIEnv* env = nullptr;
@@ -54,6 +59,13 @@ struct JniThreadScope {
         if (attached && vm) vm->DetachCurrentThread();
     }
 };
+#else
+// 主机构建没有 JVM
+struct JniThreadScope {
+    JniThreadScope() {}
+    ~JniThreadScope() {}
+};
+#endif
 
 AXPlayer::AXPlayer(std::shared_ptr<AXPlayerCallback> cb) : cb_(std::move(cb)) {
     AX_LOGI("AXPlayer ctor");
@@ -63,11 +75,17 @@ AXPlayer::~AXPlayer() {
     AX_LOGI("AXPlayer dtor: begin");
     playing_.store(false);
     abort_.store(true);
+    wakePlay_();
+    { std::lock_guard<std::mutex> lk(seekMtx_); }   // 与 seekLoop_ 的谓词检查同步，避免漏唤醒
+    seekCv_.notify_all();
 
     // 先停播放/IO 线程（防止它们再驱动渲染器）
     if (ioThread_.joinable())   ioThread_.join();
     if (playThread_.joinable()) playThread_.join();
 
+    // 拖动中释放：显式关掉只解关键帧与静音，不留给下一次 seek
+    endScrub_();
+
     // ★ 关键：停 demux/decoder，并让队列退出
     stopPipelines_();
 
@@ -85,6 +103,7 @@ AXPlayer::~AXPlayer() {
             window_ = nullptr;
         }
     }
+    AXAvPool::instance().logStats("dtor");
     AX_LOGI("AXPlayer dtor: done");
 }
 void AXPlayer::stopPipelines_() {
@@ -124,6 +143,8 @@ void AXPlayer::prepareAsync() {
         return;
     }
     changeState(State::PREPARING);
+    telemetry_.reset();
+    prepareStartUs_ = axStampNowUs();
     abort_.store(false);
     prepared_.store(false);
     ioThread_ = std::thread(&AXPlayer::ioThreadLoop, this);
@@ -131,33 +152,18 @@ void AXPlayer::prepareAsync() {
 
 void AXPlayer::start() {
     if (state_ == State::COMPLETED) {
-        AX_LOGI("restart from COMPLETED: seek to 0 and restart demux/dec");
-        // 1) flush
-        if (aDec_) aDec_->flush();
-        if (vDec_) vDec_->flush();
-        if (aPktQ_) aPktQ_->flush();
-        if (vPktQ_) vPktQ_->flush();
-        if (aFrmQ_) aFrmQ_->flush();
-        if (vFrmQ_) vFrmQ_->flush();
-
-        // 2) 选择一个可用流的 time_base
-        int targetStream = (vDec_ && vStreamIdx_ >= 0) ? vStreamIdx_ :
-                           (aDec_ && aStreamIdx_ >= 0) ? aStreamIdx_ : -1;
-        if (targetStream >= 0) {
-            demux_->seek(targetStream, 0);
-        }
-        // 3) 重新启动 demux/dec 线程（如果它们会在 EOF 退出）
-        demux_->start(aPktQ_.get(), vPktQ_.get());
-        if (aDec_) aDec_->start();
-        if (vDec_) vDec_->start();
-
-        // 4) 时钟归零
-        if (clock_) { clock_->reset(0); clock_->setSpeed(speed_); }
+        AX_LOGI("restart from COMPLETED: seek to 0");
+        // demux/decoder 线程停在 EOF 等 seek，seek 回 0 即从头再读（时钟随之归零）
+        doSeek_(0, SeekMode::Fast, -1);
         prepared_.store(true);
         changeState(State::PREPARED);
         return;
     }
     if (state_ == State::PREPARED || state_ == State::PAUSED || state_ == State::COMPLETED) {
+        // 拖动中起播：在预览位置精确 seek 一次，恢复完整解码与声音（覆盖尚未执行的拖动请求）
+        if (scrubbing_.load()) seekTo(positionMs_.load(), SeekMode::Accurate);
+        // 预滚结束：帧队列与音频 FIFO 已是满的，放行时钟与音频输出即出声出画
+        prerolling_.store(false);
         playing_.store(true);
         if (clock_) {
             clock_->setSpeed(speed_);
@@ -181,8 +187,46 @@ void AXPlayer::pause() {
     changeState(State::PAUSED);
 }
 
-void AXPlayer::seekTo(int64_t msec) {
-    AX_LOGI("seekTo: %lld ms", (long long)msec);
+void AXPlayer::seekTo(int64_t msec, SeekMode mode) {
+    {
+        std::lock_guard<std::mutex> lk(seekMtx_);
+        if (seekReqMs_ >= 0) ++seekCoalesced_;
+        seekReqMs_ = msec;
+        seekReqMode_ = mode;
+        seekReqUs_ = axStampNowUs();
+        scrubbing_.store(mode == SeekMode::Scrub);
+    }
+    positionMs_.store(msec);
+    seekCv_.notify_one();
+}
+
+// IO 线程：prepare 完成后常驻，逐个执行最新的 seek 请求（执行期间到达的请求合并成一个）
+void AXPlayer::seekLoop_() {
+    for (;;) {
+        int64_t msec, reqUs;
+        SeekMode mode;
+        int coalesced;
+        {
+            std::unique_lock<std::mutex> lk(seekMtx_);
+            seekCv_.wait(lk, [this] { return abort_.load() || seekReqMs_ >= 0; });
+            if (abort_.load()) return;
+            msec = seekReqMs_;
+            mode = seekReqMode_;
+            reqUs = seekReqUs_;
+            coalesced = seekCoalesced_;
+            seekReqMs_ = -1;
+            seekCoalesced_ = 0;
+        }
+        if (coalesced > 0) AX_LOGI("seek: %d stale request(s) coalesced", coalesced);
+        doSeek_(msec, mode, reqUs);
+    }
+}
+
+void AXPlayer::doSeek_(int64_t msec, SeekMode mode, int64_t reqUs) {
+    AX_TRACE_SCOPE("seek");
+    std::lock_guard<std::mutex> lk(seekExecMtx_);
+    static const char* const kModeNames[] = {"fast", "accurate", "scrub", "nearest"};
+    AX_LOGI("seekTo: %lld ms (%s)", (long long)msec, kModeNames[(int)mode]);
     if (!demux_) return;
 
     int targetStream = -1;
@@ -197,6 +241,7 @@ void AXPlayer::seekTo(int64_t msec) {
     if (targetStream < 0) return;
 
     int64_t pts = av_rescale_q(msec, AVRational{1,1000}, tb);
+    const bool scrub = mode == SeekMode::Scrub;
 
     if (aDec_) aDec_->flush();
     if (vDec_) vDec_->flush();
@@ -204,8 +249,19 @@ void AXPlayer::seekTo(int64_t msec) {
     if (vPktQ_) vPktQ_->flush();
     if (aFrmQ_) aFrmQ_->flush();
     if (vFrmQ_) vFrmQ_->flush();
+    // 拖动预览在暂停中也会呈现，首帧耗时照记；普通 seek 只在播放中记。
+    // 起播前（预滚中）的 seek：新位置的首帧同样作为海报直接上屏
+    if (vRen_)  vRen_->flush((scrub || playing_.load()) && reqUs > 0 ? reqUs : -1, scrub || prerolling_.load());
+
+    // 精确 seek：解码线程丢掉目标前的帧，音视频首帧都落在目标上（与下面按 msec 重置的时钟一致）
+    const int64_t discardUs = mode == SeekMode::Accurate ? msec * 1000 : -1;
+    if (aDec_) aDec_->setDiscardBefore(discardUs);
+    if (vDec_) {
+        vDec_->setDiscardBefore(discardUs);
+        vDec_->setKeyframeOnly(scrub);
+    }
 
-    demux_->seek(targetStream, pts);
+    demux_->seek(targetStream, pts, scrub || mode == SeekMode::NearestKey);
 
     if (clock_) {
         float sp = speed_;
@@ -214,12 +270,20 @@ void AXPlayer::seekTo(int64_t msec) {
         clock_->setSpeed(sp);
         clock_->pause(wasPaused);
     }
+    // 音频输出保持打开（不重建 Oboe 流）：清掉 FIFO 与播放头即可；拖动中静音
     if (aRen_) {
-        aRen_->release();
-        aRen_->init();
-        if (playing_.load()) aRen_->start();
+        aRen_->flush();
+        aRen_->setMuted(scrub);
     }
     positionMs_.store(msec);
+    wakePlay_();
+}
+
+// 结束拖动状态（seek 之外的收尾路径用；正常松手由下一次非 Scrub seek 关闭）
+void AXPlayer::endScrub_() {
+    if (!scrubbing_.exchange(false)) return;
+    if (vDec_) vDec_->setKeyframeOnly(false);
+    if (aRen_) aRen_->setMuted(false);
 }
 
 bool AXPlayer::isPlaying() { return playing_.load(); }
@@ -227,9 +291,59 @@ void AXPlayer::setSpeed(float speed) {
     speed_ = speed;
     if (clock_) clock_->setSpeed(speed);
     if (aRen_)       aRen_->setSpeed(speed);
+    if (vRen_)       vRen_->setSpeed(speed);
+    wakePlay_();   // 截止时间按新倍速重算
 }
 int64_t AXPlayer::getCurrentPositionMs() { return positionMs_.load(); }
 int64_t AXPlayer::getDurationMs() { return durationMs_; }
+int64_t AXPlayer::getBufferedDurationMs() { return bufferedDurationUs_() / 1000; }
+
+void AXPlayer::setBufferLimits(int64_t maxBytes, int64_t maxDurationMs) {
+    bufMaxBytes_.store(maxBytes);
+    bufMaxDurationUs_.store(maxDurationMs > 0 ? maxDurationMs * 1000 : 0);
+    applyBufferLimits_();
+}
+
+void AXPlayer::applyBufferLimits_() {
+    const bool both = aStreamIdx_ >= 0 && vStreamIdx_ >= 0;
+    const int64_t total = bufMaxBytes_.load();
+    const int64_t aBytes = (both && total > 0) ? total / 8 : total;
+    const int64_t vBytes = (both && total > 0) ? total - aBytes : total;
+    const int64_t durUs = bufMaxDurationUs_.load();
+    if (aPktQ_) aPktQ_->setLimits(aBytes, durUs, kBufMinPackets);
+    if (vPktQ_) vPktQ_->setLimits(vBytes, durUs, kBufMinPackets);
+}
+
+// 队列深度 gauge：由播放线程刷新（getStatistics 只读遥测，不碰可能被重建的队列）
+void AXPlayer::updateQueueGauges_() {
+    const auto st = [](std::atomic<int64_t>& g, int64_t v) { g.store(v, std::memory_order_relaxed); };
+    if (aPktQ_) {
+        st(telemetry_.aPktPackets, (int64_t) aPktQ_->size());
+        st(telemetry_.aPktBytes, aPktQ_->bytes());
+        st(telemetry_.aPktDurUs, aPktQ_->durationUs());
+    }
+    if (vPktQ_) {
+        st(telemetry_.vPktPackets, (int64_t) vPktQ_->size());
+        st(telemetry_.vPktBytes, vPktQ_->bytes());
+        st(telemetry_.vPktDurUs, vPktQ_->durationUs());
+    }
+    if (aFrmQ_) st(telemetry_.aFrames, (int64_t) aFrmQ_->size());
+    if (vFrmQ_) st(telemetry_.vFrames, (int64_t) vFrmQ_->size());
+}
+
+AXPlayerStats AXPlayer::getStatistics() const {
+    return AXPlayerStats::from(telemetry_);
+}
+
+int64_t AXPlayer::bufferedDurationUs_() const {
+    int64_t us = -1;
+    if (aPktQ_ && aStreamIdx_ >= 0) us = aPktQ_->durationUs();
+    if (vPktQ_ && vStreamIdx_ >= 0) {
+        const int64_t v = vPktQ_->durationUs();
+        us = (us < 0) ? v : std::min(us, v);
+    }
+    return us < 0 ? 0 : us;
+}
 void AXPlayer::setVolume(float l, float r) {
     volL_ = l; volR_ = r;
     if (aRen_) aRen_->setVolume(l, r);
@@ -248,9 +362,20 @@ void AXPlayer::setWindow(ANativeWindow* window) {
     }
     window_ = window;
     if (vRen_) vRen_->init(window_, videoW_, videoH_, sarNum_, sarDen_);
+    wakePlay_();
+}
+
+void AXPlayer::changeState(State s) {
+    state_.store(s);
+    wakePlay_();
 }
 
-void AXPlayer::changeState(State s) { state_.store(s); }
+void AXPlayer::wakePlay_() {
+    playEvent_.notifyAll();
+    prerollEvent_.notifyAll();
+    videoEvent_.notifyAll();
+    audioEvent_.notifyAll();
+}
 
 void AXPlayer::notifyError(int what, int extra, const std::string& msg) {
     changeState(State::ERROR);
@@ -261,21 +386,23 @@ void AXPlayer::notifyError(int what, int extra, const std::string& msg) {
 
 void AXPlayer::ioThreadLoop() {
     JniThreadScope jscope;
+    AX_TRACE_THREAD("AXPlayer-io");
     AX_LOGI("ioThread start");
 
     demux_.reset(new AXDemuxer());
-    aPktQ_.reset(new PacketQueue(256));
-    vPktQ_.reset(new PacketQueue(256));
+    demux_->setTelemetry(&telemetry_);
+    demux_->setOpenOptions(openOpts_);
+    // 包队列的条数上限只是兜底，真正的限容由字节/时长水位决定（见 applyBufferLimits_）
+    aPktQ_.reset(new PacketQueue(1024));
+    vPktQ_.reset(new PacketQueue(1024));
     aFrmQ_.reset(new FrameQueue(64));
     vFrmQ_.reset(new FrameQueue(32));
-    // 记录容量（BoundedQueue 无 capacity()）
-    aPktCap_ = 256;
-    vPktCap_ = 256;
-    aFrmCap_ = 64;
-    vFrmCap_ = 32;
+    aFrmQ_->setSerialSource(aPktQ_.get());
+    vFrmQ_->setSerialSource(vPktQ_.get());
 
     clock_.reset(new AXClock());
     clock_->setSpeed(speed_);
+    clock_->pause(true);   // start 前停在 0：预滚出来的帧不会因为等 start 而过期
 
     DemuxResult info;
     if (!demux_->open(source_, headers_, info)) {
@@ -298,6 +425,11 @@ void AXPlayer::ioThreadLoop() {
     aStreamIdx_ = info.audioStream;
     vStreamIdx_ = info.videoStream;
 
+    aPktQ_->setTimeBase(info.aTimeBase);
+    vPktQ_->setTimeBase(info.vTimeBase);
+    applyBufferLimits_();
+
+    const int64_t decOpenStartUs = axStampNowUs();
     bool audioOk = false, videoOk = false;
     if (info.audioStream >= 0) {
         aDec_.reset(new AXDecoder());
@@ -308,6 +440,7 @@ void AXPlayer::ioThreadLoop() {
         } else {
             aDec_->setPacketQueue(aPktQ_.get());
             aDec_->setFrameQueue(aFrmQ_.get());
+            aDec_->setTelemetry(&telemetry_);
             audioOk = true;
         }
     }
@@ -320,6 +453,7 @@ void AXPlayer::ioThreadLoop() {
         } else {
             vDec_->setPacketQueue(vPktQ_.get());
             vDec_->setFrameQueue(vFrmQ_.get());
+            vDec_->setTelemetry(&telemetry_);
             videoOk = true;
         }
     }
@@ -328,14 +462,32 @@ void AXPlayer::ioThreadLoop() {
         stopPipelines_();
         return;
     }
+    const AXOpenTiming& ot = demux_->openTiming();
+    AX_LOGI("prepare: open %.1f ms, probe %.1f ms (%s), decoders %.1f ms", ot.openInputUs / 1000.0,
+            ot.probeUs / 1000.0, AXDemuxer::probeName(ot.probe), (axStampNowUs() - decOpenStartUs) / 1000.0);
 
-    vRen_.reset(new AXVideoRenderer());
-    if (window_ && !vRen_->init(window_, videoW_, videoH_, sarNum_, sarDen_)) {
+    if (videoSinkFactory_) {
+        vRen_ = videoSinkFactory_();
+    } else {
+#if defined(__ANDROID__)
+        vRen_.reset(new AXVideoRenderer());
+#else
+        vRen_.reset(new AXFrameDumpSink());
+#endif
+    }
+    vRen_->setTelemetry(&telemetry_);
+    vRen_->setSpeed(speed_);
+    if (vDec_) vDec_->setRenderableCheck(vRen_->renderableCheck());
+    if (!window_ && !vRen_->needsWindow()) {
+        vRen_->init(nullptr, videoW_, videoH_, sarNum_, sarDen_);
+    } else if (window_ && !vRen_->init(window_, videoW_, videoH_, sarNum_, sarDen_)) {
 //        notifyError(AXERR_RENDER, -1, "video renderer init failed");
         AX_LOGE("video renderer init failed");
         // 不中断：允许纯音频播放
     }
     aRen_.reset(new AXAudioRenderer());
+    if (audioSinkFactory_) aRen_->setSinkFactory(audioSinkFactory_);
+    aRen_->setTelemetry(&telemetry_);
     if (aDec_) {
         aRen_->setFrameQueue(aFrmQ_.get());
         aRen_->setTimeBase(aDec_->timeBase());
@@ -349,26 +501,84 @@ void AXPlayer::ioThreadLoop() {
     // 视频时间基传给渲染器（即便当前无窗口也可先设置）
     if (vDec_ && vRen_) {
         vRen_->setTimeBase(vDec_->timeBase());
+        vRen_->setFrameQueue(vFrmQ_.get());
     }
 
-    if (cb_) {
-        cb_->onVideoSizeChanged(videoW_, videoH_, sarNum_, sarDen_);
-        cb_->onPrepared();
-    }
-    changeState(State::PREPARED);
+    // === 预滚：不等 start，open 之后立即起读包/解码与两个渲染线程 ===
+    // 视频线程把首帧当海报直接上屏（暂停中也画，没有 Surface 时等 Surface 到了再画），
+    // 音频线程把 FIFO 填到水位、输出流只写静音；start() 只需放行时钟与音频输出
+    prerolling_.store(true);
+    if (vDec_) vRen_->showPoster(prepareStartUs_);
+    if (aDec_) aRen_->hold();
+
+    // 帧队列有新帧时唤醒对应线程（仅在“饿”的时候武装，见 armReadyNotify）
+    vFrmQ_->setReadyNotifier(&videoEvent_);
+    aFrmQ_->setReadyNotifier(&audioEvent_);
 
     demux_->start(aPktQ_.get(), vPktQ_.get());
     if (aDec_) aDec_->start();
     if (vDec_) vDec_->start();
 
-    prepared_.store(true);
-    cvReady_.notify_all();
+    // 视频呈现与音频喂料各占一个线程，只通过主时钟 clock_ 同步：
+    // eglSwapBuffers 被 vsync 卡住不会饿到 PCM FIFO，等音频帧也不会拖住视频
+    if (vDec_) videoThread_ = std::thread(&AXPlayer::videoThreadLoop, this);
+    if (aDec_) audioThread_ = std::thread(&AXPlayer::audioThreadLoop, this);
+
+    const bool ready = waitPreroll_();
+    AX_LOGI("prepare: preroll %s, prepared %.1f ms after prepareAsync (vFrm=%d aFrm=%d)",
+            ready ? "ready" : "timed out", (axStampNowUs() - prepareStartUs_) / 1000.0,
+            (int)vFrmQ_->size(), (int)aFrmQ_->size());
+
+    if (!abort_.load()) {
+        if (cb_) {
+            cb_->onVideoSizeChanged(videoW_, videoH_, sarNum_, sarDen_);
+            cb_->onPrepared();
+        }
+        changeState(State::PREPARED);
+
+        prepared_.store(true);
+        cvReady_.notify_all();
+
+        AX_LOGI("ioThread prepared");
+        seekLoop_();
+    }
+
+    // 渲染线程由本线程拉起也由本线程回收（析构已置 abort_ 并唤醒它们）
+    if (videoThread_.joinable()) videoThread_.join();
+    if (audioThread_.joinable()) audioThread_.join();
+    vFrmQ_->setReadyNotifier(nullptr);
+    aFrmQ_->setReadyNotifier(nullptr);
+    AX_LOGI("ioThread exit");
+}
+
+// 视频：首帧已交给输出（海报），或没有 Surface 画不了、首帧已解出（Surface 到了由视频线程补画）；
+// 音频：FIFO 已到低水位，或输出不可用
+bool AXPlayer::prerollReady_() {
+    bool videoReady = !vDec_ || vRen_->framesPresented() > 0;
+    if (!videoReady && vRen_->needsWindow() && !vFrmQ_->empty()) {
+        std::lock_guard<std::mutex> lk(wmtx_);
+        videoReady = !window_;
+    }
+    const bool audioReady = !aDec_ || aRen_->feedDelayUs() != 0;
+    return videoReady && audioReady;
+}
 
-    AX_LOGI("ioThread prepared");
+bool AXPlayer::waitPreroll_() {
+    AX_TRACE_SCOPE("preroll");
+    const auto deadline = AXEventCount::Clock::now() + std::chrono::microseconds(kPrerollMaxWaitUs);
+    for (;;) {
+        const uint32_t key = prerollEvent_.prepareWait();
+        if (abort_.load() || prerollReady_()) {
+            prerollEvent_.cancelWait();
+            return !abort_.load();
+        }
+        if (!prerollEvent_.waitUntil(key, deadline)) return prerollReady_();
+    }
 }
 
 void AXPlayer::playThreadLoop() {
     JniThreadScope jscope;
+    AX_TRACE_THREAD("AXPlayer-play");
     AX_LOGI("playThread start");
 
     // === 等待 prepared：支持被 abort_ 打断 ===
@@ -381,77 +591,40 @@ void AXPlayer::playThreadLoop() {
         return;
     }
 
-    // === 渲染器一次性绑定帧队列/时间基（避免循环内重复设置） ===
-    if (vRen_) {
-        vRen_->setFrameQueue(vFrmQ_.get());             // ★ 必须给视频渲染器队列
-        if (vDec_) vRen_->setTimeBase(vDec_->timeBase());
-    }
-    if (aRen_) {
-        aRen_->setFrameQueue(aFrmQ_.get());
-        if (aDec_) aRen_->setTimeBase(aDec_->timeBase());
-    }
-
+    // 渲染器的帧队列/时间基与两个渲染线程已在 IO 线程预滚时就绪（见 ioThreadLoop）
     // 确保 clock_ 存在
     if (!clock_) {
         clock_.reset(new AXClock());
         clock_->setSpeed(speed_);
     }
 
+    // 本线程只负责：位置上报、缓冲进度、完成判定（都是百毫秒级的低频工作）
     bool    completedNotified = false;
     int64_t lastBufCbMs       = 0;  // 上次缓冲回调时间（ms）
 
     while (!abort_.load()) {
+        const uint32_t key = playEvent_.prepareWait();
         if (!playing_.load()) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            // 暂停：无限期等待状态变化（start/seek/abort 都会 wakePlay_）
+            if (abort_.load() || playing_.load()) { playEvent_.cancelWait(); continue; }
+            playEvent_.wait(key);
             continue;
         }
 
-        // ==== 主时钟选择：优先用“已到达DAC”的音频时钟 ====
-        int64_t masterUs = 0;
-        // 用 auto* 避免命名空间拼写问题
-        auto* aRen = aRen_.get();
-        auto* vRen = vRen_.get();
-
-        if (aRen) {
-            const int64_t audioPlayedUs = aRen->lastRenderedPtsUs();   // -1 表示还没基准
-            if (audioPlayedUs >= 0) {
-                const int64_t curUs = clock_->ptsUs();
-                // 对齐阈值 5ms，避免抖动
-                if (std::llabs(audioPlayedUs - curUs) > 5000) {
-                    const float sp       = speed_;
-                    const bool  wasPause = !playing_.load();
-                    clock_->reset(audioPlayedUs);
-                    clock_->setSpeed(sp);
-                    clock_->pause(wasPause);
-                }
-                masterUs = clock_->ptsUs();
-            } else {
-                // 音频未就绪：先用外部时钟
-                masterUs = clock_->ptsUs();
-            }
-        } else {
-            // 无音频：外部时钟
-            masterUs = clock_->ptsUs();
-        }
-
-        positionMs_.store(masterUs / 1000);
+        positionMs_.store(clock_->ptsUs() / 1000);
+        updateQueueGauges_();
 
-        // ==== 渲染 ====
-        if (vRen) vRen->drawLoopOnce(masterUs);
-        if (aRen) aRen->renderOnce(masterUs);
-
-        // ==== 缓冲进度：每 500ms 回调一次 ====
+        // ==== 缓冲进度：每 500ms 回调一次（已缓冲时长 / 时长水位；EOF 后恒为 100） ====
         const int64_t now = nowMs();
         if (cb_ && (now - lastBufCbMs >= 500)) {
-            int cap = 0, sz = 0;
-            if (aPktQ_) { cap += aPktCap_; sz += (int)aPktQ_->size(); }
-            if (vPktQ_) { cap += vPktCap_; sz += (int)vPktQ_->size(); }
-            if (cap > 0) {
-                int percent = (int)((100LL * sz) / cap);
+            const int64_t targetUs = bufMaxDurationUs_.load();
+            int percent = 100;
+            if (targetUs > 0 && !(demux_ && demux_->isEof())) {
+                percent = (int)((100LL * bufferedDurationUs_()) / targetUs);
                 if (percent < 0)   percent = 0;
                 if (percent > 100) percent = 100;
-                cb_->onBuffering(percent);
             }
+            cb_->onBuffering(percent);
             lastBufCbMs = now;
         }
 
@@ -460,16 +633,123 @@ void AXPlayer::playThreadLoop() {
                 (!vFrmQ_ || vFrmQ_->size() == 0) &&
                 (!aFrmQ_ || aFrmQ_->size() == 0);
 
+        // seek 离开 EOF 后重新允许完成回调
+        if (completedNotified && demux_ && !demux_->isEof()) completedNotified = false;
         if (!completedNotified && framesEmpty && demux_ && demux_->isEof()) {
             completedNotified = true;
             playing_.store(false);
             changeState(State::COMPLETED);
             if (cb_) cb_->onCompletion();
             AX_LOGI("onCompletion notified");
+            playEvent_.cancelWait();
+            continue;
         }
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        playEvent_.waitUntil(key, AXEventCount::Clock::now() + std::chrono::microseconds(kPlayMaxWaitUs));
     }
 
     AX_LOGI("playThread exit");
+}
+
+// 主时钟：音频活跃时以“已到达 DAC”的音频 PTS 校正外部时钟（对齐阈值 5ms，避免抖动）
+int64_t AXPlayer::syncClockToAudio_() {
+    const int64_t audioPlayedUs = aRen_ ? aRen_->lastRenderedPtsUs() : -1;   // -1 表示还没基准
+    if (audioPlayedUs >= 0 && std::llabs(audioPlayedUs - clock_->ptsUs()) > 5000) {
+        const float sp       = speed_;
+        const bool  wasPause = !playing_.load();
+        clock_->reset(audioPlayedUs);
+        clock_->setSpeed(sp);
+        clock_->pause(wasPause);
+    }
+    return clock_->ptsUs();
+}
+
+// 在 ev 上等待：暂停时无限期等状态变化；播放时等到 waitUs 或被提前唤醒。
+// key 需在本轮处理开始前 prepareWait 得到，处理期间的事件不会丢
+void AXPlayer::waitMediaEvent_(AXEventCount& ev, uint32_t key, int64_t waitUs) {
+    if (abort_.load() || (playing_.load() && waitUs <= 0)) {
+        ev.cancelWait();
+        return;
+    }
+    if (!playing_.load()) {
+        ev.wait(key);
+        return;
+    }
+    ev.waitUntil(key, AXEventCount::Clock::now() + std::chrono::microseconds(waitUs));
+}
+
+void AXPlayer::videoThreadLoop() {
+    AX_TRACE_THREAD("AXPlayer-video");
+    AX_LOGI("videoThread start");
+    int64_t wakeups = 0;  // 循环次数（≈ 唤醒次数），退出时打印
+    const int64_t startMs = nowMs();
+
+    while (!abort_.load()) {
+        ++wakeups;
+        // 先登记等待：本轮处理期间发生的任何事件都会让后面的 wait 立即返回
+        const uint32_t key = videoEvent_.prepareWait();
+        int64_t waitUs = kPlayMaxWaitUs;
+        // 暂停中仍要呈现拖动预览帧与起播海报
+        if (playing_.load() || vRen_->previewPending()) {
+            const int64_t dueUs = vRen_->drawLoopOnce(clock_->ptsUs());
+            if (dueUs == AXVideoSink::kNoFrame) {
+                if (vFrmQ_) {
+                    vFrmQ_->armReadyNotify();
+                    if (!vFrmQ_->empty()) waitUs = 0;   // 武装前刚好入队：不睡
+                }
+            } else {
+                const float sp = speed_ > 0.f ? speed_ : 1.0f;
+                waitUs = std::min(waitUs, (int64_t)(dueUs / sp));
+            }
+        }
+        if (prerolling_.load()) prerollEvent_.notifyAll();
+        waitMediaEvent_(videoEvent_, key, waitUs);
+    }
+    vRen_->detachThread();
+
+    const int64_t aliveMs = nowMs() - startMs;
+    AX_LOGI("videoThread exit: wakeups=%lld in %lld ms (%.1f/s)", (long long)wakeups, (long long)aliveMs,
+            aliveMs > 0 ? wakeups * 1000.0 / aliveMs : 0.0);
+}
+
+void AXPlayer::audioThreadLoop() {
+    AX_TRACE_THREAD("AXPlayer-audio");
+    AX_LOGI("audioThread start");
+    int64_t wakeups = 0;
+    const int64_t startMs = nowMs();
+
+    while (!abort_.load()) {
+        ++wakeups;
+        const uint32_t key = audioEvent_.prepareWait();
+        int64_t waitUs = kPlayMaxWaitUs;
+        // 预滚中也喂：输出只写静音，FIFO 填到水位后停下等 start
+        const bool feeding = playing_.load() || prerolling_.load();
+        if (feeding) {
+            aRen_->renderOnce(clock_->ptsUs());
+            syncClockToAudio_();
+
+            const int64_t feedUs = aRen_->feedDelayUs();
+            if (feedUs == 0) {
+                // 渲染器已把帧队列取空仍低于水位：等新帧
+                if (aFrmQ_) {
+                    aFrmQ_->armReadyNotify();
+                    if (!aFrmQ_->empty()) waitUs = 0;
+                }
+            } else if (feedUs > 0) {
+                waitUs = std::min(waitUs, feedUs);
+            }
+        }
+        if (prerolling_.load()) {
+            prerollEvent_.notifyAll();
+            if (feeding && waitUs == 0 && !playing_.load()) {   // 预填中新帧已到：不睡（暂停时 waitMediaEvent_ 会无限期等）
+                audioEvent_.cancelWait();
+                continue;
+            }
+        }
+        waitMediaEvent_(audioEvent_, key, waitUs);
+    }
+
+    const int64_t aliveMs = nowMs() - startMs;
+    AX_LOGI("audioThread exit: wakeups=%lld in %lld ms (%.1f/s)", (long long)wakeups, (long long)aliveMs,
+            aliveMs > 0 ? wakeups * 1000.0 / aliveMs : 0.0);
 }
\ No newline at end of file
@@ -0,0 +1,294 @@
+//AXPlayerLib/MediaCore/player/core/AXStreamInfoCache.cpp
+#include "AXStreamInfoCache.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <sys/stat.h>
+#include <unistd.h>
+
+extern "C" {
+#include <libavformat/avformat.h>
+#include <libavutil/channel_layout.h>
+#include <libavutil/mem.h>
+}
+
+#define AX_LOG_TAG "AXStreamInfoCache"
+#include "AXLog.h"
+
+namespace {
+
+constexpr const char* kMagic = "axsi 1";
+constexpr unsigned kMaxStreams = 1000;   // 与 AVFormatContext::max_streams 默认值一致；文件里的条数不可信
+
+// 缓存里的一条流：只存解码器与上层会用到、而容器头里可能缺的字段
+struct CachedStream {
+    int type{-1};
+    int codecId{0};
+    uint32_t codecTag{0};
+    int format{-1};
+    int64_t bitRate{0};
+    int profile{-99}, level{-99};
+    int width{0}, height{0};
+    int sarNum{0}, sarDen{1};
+    int fieldOrder{0};
+    int colorRange{0}, colorPrimaries{2}, colorTrc{2}, colorSpace{2}, chromaLocation{0};
+    int sampleRate{0};
+    int channels{0};
+    uint64_t channelMask{0};
+    int frameSize{0};
+    int afrNum{0}, afrDen{1};
+    int rfrNum{0}, rfrDen{1};
+    int64_t duration{AV_NOPTS_VALUE};
+    int64_t startTime{AV_NOPTS_VALUE};
+    std::string extradata;   // 十六进制，空 = 无
+};
+
+uint64_t fnv1a(const std::string& s) {
+    uint64_t h = 1469598103934665603ULL;
+    for (unsigned char c : s) {
+        h ^= c;
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+std::string toHex(const uint8_t* p, int n) {
+    static const char* const kDigits = "0123456789abcdef";
+    std::string out;
+    out.reserve((size_t) n * 2);
+    for (int i = 0; i < n; ++i) {
+        out.push_back(kDigits[p[i] >> 4]);
+        out.push_back(kDigits[p[i] & 15]);
+    }
+    return out;
+}
+
+bool fromHex(const std::string& s, std::vector<uint8_t>& out) {
+    auto nibble = [](char c) -> int {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        return -1;
+    };
+    if (s.size() % 2) return false;
+    out.resize(s.size() / 2);
+    for (size_t i = 0; i < out.size(); ++i) {
+        const int hi = nibble(s[2 * i]), lo = nibble(s[2 * i + 1]);
+        if (hi < 0 || lo < 0) return false;
+        out[i] = (uint8_t) (hi << 4 | lo);
+    }
+    return true;
+}
+
+// 源签名：本地文件 大小 + mtime；其它协议只有 avio_size；都拿不到返回 false（不缓存）
+bool signatureOf(const std::string& url, const AVFormatContext* fmt, std::string& out) {
+    std::string path;
+    if (url.rfind("file:", 0) == 0) path = url.substr(5);
+    else if (url.find(':') == std::string::npos) path = url;   // 不带协议前缀即本地路径
+    struct stat sb{};
+    if (!path.empty() && ::stat(path.c_str(), &sb) == 0) {
+        out = "file " + std::to_string((long long) sb.st_size) + " " + std::to_string((long long) sb.st_mtime);
+        return true;
+    }
+    const int64_t size = fmt->pb ? avio_size(fmt->pb) : -1;
+    if (size <= 0) return false;
+    out = "size " + std::to_string((long long) size);
+    return true;
+}
+
+CachedStream capture(const AVStream* st) {
+    const AVCodecParameters* p = st->codecpar;
+    CachedStream c;
+    c.type = p->codec_type;
+    c.codecId = p->codec_id;
+    c.codecTag = p->codec_tag;
+    c.format = p->format;
+    c.bitRate = p->bit_rate;
+    c.profile = p->profile;
+    c.level = p->level;
+    c.width = p->width;
+    c.height = p->height;
+    c.sarNum = p->sample_aspect_ratio.num;
+    c.sarDen = p->sample_aspect_ratio.den;
+    c.fieldOrder = p->field_order;
+    c.colorRange = p->color_range;
+    c.colorPrimaries = p->color_primaries;
+    c.colorTrc = p->color_trc;
+    c.colorSpace = p->color_space;
+    c.chromaLocation = p->chroma_location;
+    c.sampleRate = p->sample_rate;
+    c.channels = p->ch_layout.nb_channels;
+    c.channelMask = p->ch_layout.order == AV_CHANNEL_ORDER_NATIVE ? p->ch_layout.u.mask : 0;
+    c.frameSize = p->frame_size;
+    c.afrNum = st->avg_frame_rate.num;
+    c.afrDen = st->avg_frame_rate.den;
+    c.rfrNum = st->r_frame_rate.num;
+    c.rfrDen = st->r_frame_rate.den;
+    c.duration = st->duration;
+    c.startTime = st->start_time;
+    if (p->extradata && p->extradata_size > 0) c.extradata = toHex(p->extradata, p->extradata_size);
+    return c;
+}
+
+void writeStream(std::ostream& os, const CachedStream& c) {
+    os << "s " << c.type << ' ' << c.codecId << ' ' << c.codecTag << ' ' << c.format << ' ' << c.bitRate << ' '
+       << c.profile << ' ' << c.level << ' ' << c.width << ' ' << c.height << ' ' << c.sarNum << ' ' << c.sarDen << ' '
+       << c.fieldOrder << ' ' << c.colorRange << ' ' << c.colorPrimaries << ' ' << c.colorTrc << ' ' << c.colorSpace << ' '
+       << c.chromaLocation << ' ' << c.sampleRate << ' ' << c.channels << ' ' << c.channelMask << ' ' << c.frameSize << ' '
+       << c.afrNum << ' ' << c.afrDen << ' ' << c.rfrNum << ' ' << c.rfrDen << ' ' << c.duration << ' ' << c.startTime << ' '
+       << (c.extradata.empty() ? "-" : c.extradata) << '\n';
+}
+
+bool readStream(const std::string& line, CachedStream& c) {
+    std::istringstream is(line);
+    std::string tag;
+    is >> tag >> c.type >> c.codecId >> c.codecTag >> c.format >> c.bitRate >> c.profile >> c.level >> c.width >> c.height
+       >> c.sarNum >> c.sarDen >> c.fieldOrder >> c.colorRange >> c.colorPrimaries >> c.colorTrc >> c.colorSpace
+       >> c.chromaLocation >> c.sampleRate >> c.channels >> c.channelMask >> c.frameSize >> c.afrNum >> c.afrDen
+       >> c.rfrNum >> c.rfrDen >> c.duration >> c.startTime >> c.extradata;
+    if (!is || tag != "s") return false;
+    if (c.extradata == "-") c.extradata.clear();
+    return true;
+}
+
+// 应用前的校验：类型/编码须与打开时建出的流一致；容器头没给 extradata 时解码缓存里的那份
+// （可能失败的步骤都在这里做完，apply 本身不会失败，不会出现只改了一半流的情况）
+struct PendingStream {
+    uint8_t* extradata{nullptr};   // av_mallocz 分配（含 padding），apply 后归 codecpar 所有
+    int extradataSize{0};
+};
+
+bool validate(const CachedStream& c, const AVStream* st, PendingStream& out) {
+    const AVCodecParameters* p = st->codecpar;
+    if (p->codec_type != c.type || (p->codec_id != AV_CODEC_ID_NONE && p->codec_id != c.codecId)) return false;
+    if (!p->extradata_size && !c.extradata.empty()) {
+        std::vector<uint8_t> bytes;
+        if (!fromHex(c.extradata, bytes)) return false;
+        out.extradata = (uint8_t*) av_mallocz(bytes.size() + AV_INPUT_BUFFER_PADDING_SIZE);
+        if (!out.extradata) return false;
+        std::copy(bytes.begin(), bytes.end(), out.extradata);
+        out.extradataSize = (int) bytes.size();
+    }
+    return true;
+}
+
+// 只补容器头里没给的字段
+void apply(const CachedStream& c, AVStream* st, PendingStream& pending) {
+    AVCodecParameters* p = st->codecpar;
+    if (p->codec_id == AV_CODEC_ID_NONE) p->codec_id = (AVCodecID) c.codecId;
+    if (pending.extradata) {
+        p->extradata = pending.extradata;
+        p->extradata_size = pending.extradataSize;
+        pending.extradata = nullptr;
+    }
+    if (!p->codec_tag) p->codec_tag = c.codecTag;
+    if (p->format < 0) p->format = c.format;
+    if (p->bit_rate <= 0) p->bit_rate = c.bitRate;
+    if (p->profile < 0) p->profile = c.profile;
+    if (p->level < 0) p->level = c.level;
+    if (p->width <= 0 || p->height <= 0) {
+        p->width = c.width;
+        p->height = c.height;
+    }
+    if (p->sample_aspect_ratio.num <= 0) p->sample_aspect_ratio = AVRational{c.sarNum, c.sarDen};
+    if (p->field_order == AV_FIELD_UNKNOWN) p->field_order = (AVFieldOrder) c.fieldOrder;
+    if (p->color_range == AVCOL_RANGE_UNSPECIFIED) p->color_range = (AVColorRange) c.colorRange;
+    if (p->color_primaries == AVCOL_PRI_UNSPECIFIED) p->color_primaries = (AVColorPrimaries) c.colorPrimaries;
+    if (p->color_trc == AVCOL_TRC_UNSPECIFIED) p->color_trc = (AVColorTransferCharacteristic) c.colorTrc;
+    if (p->color_space == AVCOL_SPC_UNSPECIFIED) p->color_space = (AVColorSpace) c.colorSpace;
+    if (p->chroma_location == AVCHROMA_LOC_UNSPECIFIED) p->chroma_location = (AVChromaLocation) c.chromaLocation;
+    if (p->sample_rate <= 0) p->sample_rate = c.sampleRate;
+    if (p->ch_layout.nb_channels <= 0 && c.channels > 0) {
+        av_channel_layout_uninit(&p->ch_layout);
+        if (c.channelMask) av_channel_layout_from_mask(&p->ch_layout, c.channelMask);
+        else av_channel_layout_default(&p->ch_layout, c.channels);
+    }
+    if (p->frame_size <= 0) p->frame_size = c.frameSize;
+    if (st->avg_frame_rate.num <= 0) st->avg_frame_rate = AVRational{c.afrNum, c.afrDen};
+    if (st->r_frame_rate.num <= 0) st->r_frame_rate = AVRational{c.rfrNum, c.rfrDen};
+    if (st->duration == AV_NOPTS_VALUE) st->duration = c.duration;
+    if (st->start_time == AV_NOPTS_VALUE) st->start_time = c.startTime;
+}
+
+} // namespace
+
+std::string AXStreamInfoCache::pathFor_(const std::string& url) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016" PRIx64 ".axsi", fnv1a(url));
+    return dir_ + "/" + name;
+}
+
+bool AXStreamInfoCache::load(const std::string& url, AVFormatContext* fmt) const {
+    if (!enabled() || !fmt) return false;
+    std::string sig;
+    if (!signatureOf(url, fmt, sig)) return false;
+    std::ifstream in(pathFor_(url));
+    if (!in) return false;
+
+    std::string line;
+    int64_t duration = AV_NOPTS_VALUE, startTime = AV_NOPTS_VALUE;
+    unsigned count = 0;
+    if (!std::getline(in, line) || line != kMagic) return false;
+    if (!std::getline(in, line) || line != "url " + url) return false;     // 哈希碰撞
+    if (!std::getline(in, line) || line != "sig " + sig) {
+        AX_LOGI("stream info cache stale: %s", url.c_str());
+        return false;
+    }
+    if (!std::getline(in, line) || std::sscanf(line.c_str(), "duration %" SCNd64, &duration) != 1) return false;
+    if (!std::getline(in, line) || std::sscanf(line.c_str(), "start %" SCNd64, &startTime) != 1) return false;
+    if (!std::getline(in, line) || std::sscanf(line.c_str(), "streams %u", &count) != 1) return false;
+
+    // 打开时建出的流须与缓存一一对应，否则（容器变了 / 无头容器还没建流）回退完整探测；
+    // 先比条数再按条数分配，损坏的缓存文件不会触发超大分配
+    if (count > kMaxStreams || fmt->nb_streams != count) return false;
+    std::vector<CachedStream> streams(count);
+    for (CachedStream& c : streams) {
+        if (!std::getline(in, line) || !readStream(line, c)) return false;
+    }
+    // 全部流校验通过后才动 codecpar：任何一条不合格都原样回退完整探测
+    std::vector<PendingStream> pending(count);
+    for (unsigned i = 0; i < count; ++i) {
+        if (!validate(streams[i], fmt->streams[i], pending[i])) {
+            for (PendingStream& ps : pending) av_freep(&ps.extradata);
+            return false;
+        }
+    }
+    for (unsigned i = 0; i < count; ++i) apply(streams[i], fmt->streams[i], pending[i]);
+    if (fmt->duration == AV_NOPTS_VALUE || fmt->duration <= 0) fmt->duration = duration;
+    if (fmt->start_time == AV_NOPTS_VALUE) fmt->start_time = startTime;
+    return true;
+}
+
+bool AXStreamInfoCache::store(const std::string& url, const AVFormatContext* fmt) const {
+    if (!enabled() || !fmt) return false;
+    std::string sig;
+    if (!signatureOf(url, fmt, sig)) return false;
+
+    std::ostringstream os;
+    os << kMagic << '\n' << "url " << url << '\n' << "sig " << sig << '\n'
+       << "duration " << fmt->duration << '\n' << "start " << fmt->start_time << '\n'
+       << "streams " << fmt->nb_streams << '\n';
+    for (unsigned i = 0; i < fmt->nb_streams; ++i) writeStream(os, capture(fmt->streams[i]));
+
+    // 先写临时文件再 rename：并发写同一源时读者只会看到完整的某一版
+    const std::string path = pathFor_(url);
+    const std::string tmp = path + "." + std::to_string((long long) ::getpid()) + "." +
+                            std::to_string((unsigned long long) (uintptr_t) this) + ".tmp";
+    std::ofstream out(tmp, std::ios::trunc);
+    out << os.str();
+    out.close();
+    if (!out) {
+        AX_LOGW("stream info cache write fail: %s", tmp.c_str());
+        std::remove(tmp.c_str());
+        return false;
+    }
+    if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+        AX_LOGW("stream info cache rename fail: %s", path.c_str());
+        std::remove(tmp.c_str());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,121 @@
+//AXPlayerLib/MediaCore/player/core/AXTelemetry.cpp
+#include "AXTelemetry.h"
+
+#include <algorithm>
+#include <initializer_list>
+
+// 0~7 各占一桶；之后每个 [2^k, 2^(k+1)) 按次高两位再分 4 桶
+int AXHistogram::bucketOf(int64_t v) {
+    if (v < 8) return (int) v;
+    const int msb = 63 - __builtin_clzll((uint64_t) v);
+    const int sub = (int) ((v >> (msb - 2)) & 3);
+    return std::min(kBuckets - 1, (msb - 1) * 4 + sub);
+}
+
+int64_t AXHistogram::bucketUpper(int idx) {
+    if (idx < 8) return idx;
+    const int msb = idx / 4 + 1;
+    const int sub = idx % 4;
+    return ((int64_t) (4 + sub + 1) << (msb - 2)) - 1;
+}
+
+int64_t AXHistogram::Snapshot::percentile(double q) const {
+    if (count <= 0) return 0;
+    const uint64_t rank = (uint64_t) (q * (double) (count - 1)) + 1;
+    uint64_t acc = 0;
+    for (int i = 0; i < kBuckets; ++i) {
+        acc += buckets[i];
+        if (acc >= rank) return std::min(bucketUpper(i), max);
+    }
+    return max;
+}
+
+AXHistogram::Snapshot AXHistogram::snapshot() const {
+    Snapshot s;
+    for (int i = 0; i < kBuckets; ++i) {
+        s.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+        s.count += (int64_t) s.buckets[i];
+    }
+    s.sum = sum_.load(std::memory_order_relaxed);
+    s.max = max_.load(std::memory_order_relaxed);
+    return s;
+}
+
+void AXHistogram::reset() {
+    for (auto &b: buckets_) b.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+void AXTelemetry::reset() {
+    for (AXHistogram *h: {&demuxReadUs, &videoDecodeUs, &audioDecodeUs, &presentLateUs, &presentEarlyUs,
+                          &uploadUs, &audioFifoUs, &seekFirstFrameUs,
+                          &firstFrameUs}) {
+        h->reset();
+    }
+    for (std::atomic<int64_t> *c: {&framesPresented, &framesDropped, &audioUnderruns, &audioFifoNowUs,
+                                   &aPktPackets, &aPktBytes, &aPktDurUs, &vPktPackets, &vPktBytes, &vPktDurUs,
+                                   &aFrames, &vFrames}) {
+        c->store(0, std::memory_order_relaxed);
+    }
+}
+
+static AXHistogramStats statsOf(const AXHistogram &h) {
+    const AXHistogram::Snapshot s = h.snapshot();
+    AXHistogramStats r;
+    r.count = s.count;
+    r.mean = s.mean();
+    r.p50 = s.percentile(0.50);
+    r.p90 = s.percentile(0.90);
+    r.p99 = s.percentile(0.99);
+    r.max = s.max;
+    return r;
+}
+
+AXPlayerStats AXPlayerStats::from(const AXTelemetry &t) {
+    const auto ld = [](const std::atomic<int64_t> &a) { return a.load(std::memory_order_relaxed); };
+    AXPlayerStats s;
+    s.demuxReadUs = statsOf(t.demuxReadUs);
+    s.videoDecodeUs = statsOf(t.videoDecodeUs);
+    s.audioDecodeUs = statsOf(t.audioDecodeUs);
+    s.presentLateUs = statsOf(t.presentLateUs);
+    s.presentEarlyUs = statsOf(t.presentEarlyUs);
+    s.uploadUs = statsOf(t.uploadUs);
+    s.audioFifoUs = statsOf(t.audioFifoUs);
+    s.seekFirstFrameUs = statsOf(t.seekFirstFrameUs);
+    s.firstFrameUs = statsOf(t.firstFrameUs);
+    s.framesPresented = ld(t.framesPresented);
+    s.framesDropped = ld(t.framesDropped);
+    s.audioUnderruns = ld(t.audioUnderruns);
+    s.audioFifoNowUs = ld(t.audioFifoNowUs);
+    s.aPktPackets = ld(t.aPktPackets);
+    s.aPktBytes = ld(t.aPktBytes);
+    s.aPktDurUs = ld(t.aPktDurUs);
+    s.vPktPackets = ld(t.vPktPackets);
+    s.vPktBytes = ld(t.vPktBytes);
+    s.vPktDurUs = ld(t.vPktDurUs);
+    s.aFrames = ld(t.aFrames);
+    s.vFrames = ld(t.vFrames);
+    return s;
+}
+
+int AXPlayerStats::flatten(int64_t *out, int n) const {
+    if (!out || n < kFlatSize) return 0;
+    int i = 0;
+    for (const AXHistogramStats *h: {&demuxReadUs, &videoDecodeUs, &audioDecodeUs, &presentLateUs,
+                                     &presentEarlyUs, &uploadUs, &audioFifoUs, &seekFirstFrameUs,
+                                     &firstFrameUs}) {
+        out[i++] = h->count;
+        out[i++] = h->mean;
+        out[i++] = h->p50;
+        out[i++] = h->p90;
+        out[i++] = h->p99;
+        out[i++] = h->max;
+    }
+    for (int64_t v: {framesPresented, framesDropped, audioUnderruns,
+                     audioFifoNowUs, aPktPackets, aPktBytes, aPktDurUs, vPktPackets, vPktBytes, vPktDurUs,
+                     aFrames, vFrames}) {
+        out[i++] = v;
+    }
+    return i;
+}
@@ -0,0 +1,359 @@
+//AXPlayerLib/MediaCore/player/core/AXThumbnailer.cpp
+#include "AXThumbnailer.h"
+#include "AXAvPool.h"
+#include "AXColorMatrix.h"
+#include "AXDemuxer.h"
+
+#include <algorithm>
+#include <iterator>
+#include <thread>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libswscale/swscale.h>
+}
+
+#if __has_include(<libyuv.h>)
+#include <libyuv.h>
+#define AX_HAS_LIBYUV 1
+#endif
+
+#define AX_LOG_TAG "AXThumbnailer"
+#include "AXLog.h"
+
+namespace {
+
+constexpr AVRational kUs{1, 1000000};
+// seek 后最多读这么多视频包仍解不出帧就放弃这个位置（坏流 / seek 落在非关键帧后一直等不到关键帧）
+constexpr int kMaxPacketsPerSeek = 600;
+
+int64_t packetPts(const AVPacket* pkt) {
+    return pkt->pts != AV_NOPTS_VALUE ? pkt->pts : pkt->dts;
+}
+
+// 一个工作线程的私有解码管线：自己的 demux 上下文 + 单线程软解（并行在工作线程这一层做）
+class Worker {
+public:
+    ~Worker() {
+        axFrameFree(&frm_);
+        if (ctx_) avcodec_free_context(&ctx_);
+        if (sws_) sws_freeContext(sws_);
+        sws_ = nullptr;
+    }
+
+    bool open(const std::string& url, const std::map<std::string, std::string>& headers, bool exact) {
+        DemuxResult r;
+        if (!demux_.open(url, headers, r) || r.videoStream < 0) return false;
+        vIdx_ = r.videoStream;
+        AVFormatContext* fmt = demux_.fmt();
+        // 只要视频包：其余流在 demux 层直接丢，不拷贝负载
+        for (unsigned i = 0; i < fmt->nb_streams; ++i) {
+            if ((int) i != vIdx_) fmt->streams[i]->discard = AVDISCARD_ALL;
+        }
+        AVStream* st = fmt->streams[vIdx_];
+        tb_ = st->time_base;
+
+        const AVCodec* codec = avcodec_find_decoder(st->codecpar->codec_id);
+        if (!codec) { AX_LOGE("no decoder for codec_id=%d", st->codecpar->codec_id); return false; }
+        ctx_ = avcodec_alloc_context3(codec);
+        if (!ctx_ || avcodec_parameters_to_context(ctx_, st->codecpar) < 0) return false;
+        ctx_->pkt_timebase = tb_;
+        // 每次只解一帧，帧线程只会增加出帧延迟；多核靠多个工作线程并行
+        ctx_->thread_count = 1;
+        exact_ = exact;
+        if (!exact) {
+            ctx_->skip_frame = AVDISCARD_NONKEY;
+            ctx_->skip_loop_filter = AVDISCARD_ALL;
+        }
+        int ret = avcodec_open2(ctx_, codec, nullptr);
+        if (ret < 0) {
+            AX_LOGE("avcodec_open2 fail: %d", ret);
+            return false;
+        }
+        frm_ = axFrameAlloc();
+        return frm_ != nullptr;
+    }
+
+    // 失败时 out 为空（ptsUs = -1、无尺寸、无像素）；成功才整体写入
+    bool grab(int64_t targetUs, int w, int h, AXThumbnail& out) {
+        out.ptsUs = -1;
+        out.width = out.height = 0;
+        out.rgba.clear();
+        if (!demux_.seek(vIdx_, av_rescale_q(targetUs, kUs, tb_))) return false;
+        avcodec_flush_buffers(ctx_);
+        const bool ok = exact_ ? decodeAt_(targetUs) : decodeKeyframe_();
+        avcodec_flush_buffers(ctx_);
+        if (!ok) return false;
+
+        const int64_t pts = frm_->best_effort_timestamp != AV_NOPTS_VALUE ? frm_->best_effort_timestamp : frm_->pts;
+        std::vector<uint8_t> rgba;
+        const bool scaled = scale_(frm_, w, h, rgba);
+        av_frame_unref(frm_);
+        if (!scaled) return false;
+        out.width = w;
+        out.height = h;
+        out.rgba = std::move(rgba);
+        out.ptsUs = pts != AV_NOPTS_VALUE ? av_rescale_q(pts, tb_, kUs) : targetUs;
+        return true;
+    }
+
+private:
+    // 跳到 seek 点后的第一个关键包，单独送进去并立刻冲刷出帧（不等后续包）
+    bool decodeKeyframe_() {
+        AVPacket* pkt = axPacketAlloc();
+        if (!pkt) return false;
+        bool got = false;
+        for (int n = 0; n < kMaxPacketsPerSeek && !got;) {
+            if (av_read_frame(demux_.fmt(), pkt) < 0) break;
+            if (pkt->stream_index != vIdx_) {
+                av_packet_unref(pkt);
+                continue;
+            }
+            ++n;
+            if (!(pkt->flags & AV_PKT_FLAG_KEY)) {
+                av_packet_unref(pkt);
+                continue;
+            }
+            if (avcodec_send_packet(ctx_, pkt) >= 0 && avcodec_send_packet(ctx_, nullptr) >= 0) {
+                got = avcodec_receive_frame(ctx_, frm_) >= 0;
+            }
+            av_packet_unref(pkt);
+            if (!got) avcodec_flush_buffers(ctx_);
+        }
+        axPacketFree(&pkt);
+        return got;
+    }
+
+    // 对照路径：从关键帧正常解到覆盖 targetUs 的那一帧；到文件尾就取最后一帧
+    bool decodeAt_(int64_t targetUs) {
+        AVPacket* pkt = axPacketAlloc();
+        AVFrame* f = axFrameAlloc();
+        bool have = false;
+        bool done = !pkt || !f;
+        bool draining = false;
+        while (!done) {
+            if (!draining) {
+                int ret = av_read_frame(demux_.fmt(), pkt);
+                if (ret < 0) {
+                    draining = true;
+                    avcodec_send_packet(ctx_, nullptr);
+                } else if (pkt->stream_index != vIdx_) {
+                    av_packet_unref(pkt);
+                    continue;
+                } else {
+                    avcodec_send_packet(ctx_, pkt);
+                    av_packet_unref(pkt);
+                }
+            }
+            while (avcodec_receive_frame(ctx_, f) >= 0) {
+                av_frame_unref(frm_);
+                av_frame_move_ref(frm_, f);
+                have = true;
+                const int64_t pts = frm_->best_effort_timestamp != AV_NOPTS_VALUE ? frm_->best_effort_timestamp : frm_->pts;
+                const int64_t endUs = pts != AV_NOPTS_VALUE ? av_rescale_q(pts + std::max<int64_t>(frm_->duration, 1), tb_, kUs) : targetUs + 1;
+                if (endUs > targetUs) { done = true; break; }
+            }
+            // 排空时上面已把剩余帧全部取完
+            if (draining) done = true;
+        }
+        axFrameFree(&f);
+        axPacketFree(&pkt);
+        return have;
+    }
+
+    bool scale_(const AVFrame* src, int w, int h, std::vector<uint8_t>& rgba) {
+        rgba.resize((size_t) w * h * 4);
+#if defined(AX_HAS_LIBYUV)
+        // 4:2:0 平面（绝大多数 H.264/HEVC 8 位流）：先在 YUV 上盒式缩小（只动 1.5 字节/像素），再转小图的 RGBA
+        if (src->format == AV_PIX_FMT_YUV420P || src->format == AV_PIX_FMT_YUVJ420P) {
+            const int cw = (w + 1) / 2, ch = (h + 1) / 2;
+            i420_.resize((size_t) w * h + (size_t) cw * ch * 2);
+            uint8_t* dy = i420_.data();
+            uint8_t* du = dy + (size_t) w * h;
+            uint8_t* dv = du + (size_t) cw * ch;
+            if (libyuv::I420Scale(src->data[0], src->linesize[0], src->data[1], src->linesize[1],
+                                  src->data[2], src->linesize[2], src->width, src->height,
+                                  dy, w, du, cw, dv, cw, w, h, libyuv::kFilterBox) != 0) {
+                return false;
+            }
+            // libyuv 的 ABGR 即内存字节序 R,G,B,A；矩阵只有 601 有限 / 601 全范围 / 709 有限三种，2020 按 709 近似
+            const int range = axResolveColorRange(src->color_range, src->format == AV_PIX_FMT_YUVJ420P);
+            const int space = axResolveColorSpace(src->colorspace, src->height);
+            auto toRgba = libyuv::I420ToABGR;
+            if (range == AVCOL_RANGE_JPEG) {
+                toRgba = libyuv::J420ToABGR;
+            } else if (space == AVCOL_SPC_BT709 || space == AVCOL_SPC_BT2020_NCL || space == AVCOL_SPC_BT2020_CL) {
+                toRgba = libyuv::H420ToABGR;
+            }
+            return toRgba(dy, w, du, cw, dv, cw, rgba.data(), w * 4, w, h) == 0;
+        }
+#endif
+        sws_ = sws_getCachedContext(sws_, src->width, src->height, (AVPixelFormat) src->format,
+                                    w, h, AV_PIX_FMT_RGBA, SWS_AREA, nullptr, nullptr, nullptr);
+        if (!sws_) {
+            AX_LOGE("sws_getCachedContext fail: fmt=%d %dx%d", src->format, src->width, src->height);
+            return false;
+        }
+        uint8_t* dst[4] = {rgba.data(), nullptr, nullptr, nullptr};
+        int dstStride[4] = {w * 4, 0, 0, 0};
+        return sws_scale(sws_, src->data, src->linesize, 0, src->height, dst, dstStride) == h;
+    }
+
+    AXDemuxer demux_;
+    int vIdx_{-1};
+    AVRational tb_{1, 1000};
+    AVCodecContext* ctx_{nullptr};
+    AVFrame* frm_{nullptr};
+    bool exact_{false};
+    SwsContext* sws_{nullptr};
+    std::vector<uint8_t> i420_;
+};
+
+} // namespace
+
+AXThumbnailer::AXThumbnailer(std::string url, std::map<std::string, std::string> headers)
+        : url_(std::move(url)), headers_(std::move(headers)) {}
+
+bool AXThumbnailer::open() {
+    AXDemuxer demux;
+    DemuxResult r;
+    if (!demux.open(url_, headers_, r)) return false;
+    if (r.videoStream < 0) {
+        AX_LOGE("no video stream: %s", url_.c_str());
+        return false;
+    }
+    durationUs_ = r.durationUs;
+    width_ = r.width;
+    height_ = r.height;
+    sarNum_ = r.sarNum;
+    sarDen_ = r.sarDen;
+    index_.clear();
+    opened_ = true;
+    return true;
+}
+
+bool AXThumbnailer::buildIndex(std::vector<AXKeyframe>& out, bool* fromContainer) {
+    out.clear();
+    AXDemuxer demux;
+    DemuxResult r;
+    if (!demux.open(url_, headers_, r) || r.videoStream < 0) return false;
+    AVFormatContext* fmt = demux.fmt();
+    AVStream* st = fmt->streams[r.videoStream];
+
+    // 1) 容器索引：MP4 的 stss、MKV 的 Cues、AVI 的 idx1 等在打开时已读入
+    const int n = avformat_index_get_entries_count(st);
+    for (int i = 0; i < n; ++i) {
+        const AVIndexEntry* e = avformat_index_get_entry(st, i);
+        if (e && (e->flags & AVINDEX_KEYFRAME)) out.push_back({av_rescale_q(e->timestamp, st->time_base, kUs), e->pos});
+    }
+    const bool container = !out.empty();
+
+    // 2) 没有索引（TS、裸流等）：只读视频包头扫一遍，不解码
+    if (!container) {
+        for (unsigned i = 0; i < fmt->nb_streams; ++i) {
+            if ((int) i != r.videoStream) fmt->streams[i]->discard = AVDISCARD_ALL;
+        }
+        AVPacket* pkt = axPacketAlloc();
+        if (!pkt) return false;
+        while (av_read_frame(fmt, pkt) >= 0) {
+            const int64_t pts = packetPts(pkt);
+            if (pkt->stream_index == r.videoStream && (pkt->flags & AV_PKT_FLAG_KEY) && pts != AV_NOPTS_VALUE) {
+                out.push_back({av_rescale_q(pts, st->time_base, kUs), pkt->pos});
+            }
+            av_packet_unref(pkt);
+        }
+        axPacketFree(&pkt);
+    }
+
+    std::sort(out.begin(), out.end(), [](const AXKeyframe& a, const AXKeyframe& b) { return a.ptsUs < b.ptsUs; });
+    out.erase(std::unique(out.begin(), out.end(),
+                          [](const AXKeyframe& a, const AXKeyframe& b) { return a.ptsUs == b.ptsUs; }), out.end());
+    if (fromContainer) *fromContainer = container;
+    index_ = out;
+    AX_LOGI("keyframe index: %zu entries (%s)", out.size(), container ? "container" : "scan");
+    return !out.empty();
+}
+
+// 按显示宽高比（SAR 修正后）等比缩进 maxW x maxH，宽高取偶数（4:2:0 色度整除）
+void AXThumbnailer::fitSize_(int maxW, int maxH, int& w, int& h) const {
+    const double dispW = (double) width_ * sarNum_ / std::max(1, sarDen_);
+    const double dispH = (double) height_;
+    double s = std::min(maxW / std::max(1.0, dispW), maxH / std::max(1.0, dispH));
+    s = std::min(s, 1.0);
+    w = std::max(2, ((int) (dispW * s)) & ~1);
+    h = std::max(2, ((int) (dispH * s)) & ~1);
+}
+
+bool AXThumbnailer::extract(const Options& opts, std::vector<AXThumbnail>& out) {
+    out.clear();
+    if (!opened_ && !open()) return false;
+    if (opts.count <= 0 || width_ <= 0 || height_ <= 0) return false;
+
+    int w, h;
+    fitSize_(opts.maxWidth, opts.maxHeight, w, h);
+
+    // 目标位置取每段中点（避开片头黑场和文件尾）；时长未知时都取 0
+    out.resize(opts.count);
+    for (int i = 0; i < opts.count; ++i) {
+        out[i].targetUs = durationUs_ > 0 ? (int64_t) ((i + 0.5) * durationUs_ / opts.count) : 0;
+    }
+
+    // 有关键帧索引时，落在同一关键帧上的位置只解一次（关键帧模式下结果本来就一样）
+    struct Job {
+        int64_t seekUs;
+        std::vector<int> slots;
+    };
+    std::vector<Job> jobs;
+    for (int i = 0; i < opts.count; ++i) {
+        int64_t seekUs = out[i].targetUs;
+        if (!opts.exact && !index_.empty()) {
+            auto it = std::upper_bound(index_.begin(), index_.end(), seekUs,
+                                       [](int64_t t, const AXKeyframe& k) { return t < k.ptsUs; });
+            seekUs = it == index_.begin() ? index_.front().ptsUs : std::prev(it)->ptsUs;
+        }
+        if (!jobs.empty() && jobs.back().seekUs == seekUs) {
+            jobs.back().slots.push_back(i);
+        } else {
+            jobs.push_back({seekUs, {i}});
+        }
+    }
+
+    int workers = opts.workers > 0 ? opts.workers
+                                   : std::min(4, std::max(1, (int) std::thread::hardware_concurrency()));
+    workers = std::min<int>(workers, (int) jobs.size());
+
+    // 每个线程拿连续一段位置：段内 seek 单调向后，网络源上也多是顺序读
+    auto runRange = [&](size_t begin, size_t end) {
+        Worker wk;
+        if (!wk.open(url_, headers_, opts.exact)) {
+            AX_LOGE("worker open fail: %s", url_.c_str());
+            return;
+        }
+        for (size_t j = begin; j < end; ++j) {
+            AXThumbnail& first = out[jobs[j].slots.front()];
+            if (!wk.grab(jobs[j].seekUs, w, h, first)) {
+                AX_LOGW("thumbnail at %lld us failed", (long long) first.targetUs);
+            }
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int k = 1; k < workers; ++k) {
+        threads.emplace_back(runRange, jobs.size() * k / workers, jobs.size() * (k + 1) / workers);
+    }
+    runRange(0, jobs.size() / workers);
+    for (auto& t : threads) t.join();
+
+    int ok = 0;
+    for (const Job& job : jobs) {
+        const AXThumbnail& src = out[job.slots.front()];
+        for (size_t s = 1; s < job.slots.size(); ++s) {
+            AXThumbnail& dst = out[job.slots[s]];
+            const int64_t targetUs = dst.targetUs;
+            dst = src;
+            dst.targetUs = targetUs;
+        }
+        if (src.ptsUs >= 0) ok += (int) job.slots.size();
+    }
+    AX_LOGI("thumbnails: %d/%d ok, %zu decodes, %d workers, %dx%d", ok, opts.count, jobs.size(), workers, w, h);
+    return ok > 0;
+}
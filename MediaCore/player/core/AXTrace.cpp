@@ -0,0 +1,219 @@
+//AXPlayerLib/MediaCore/player/core/AXTrace.cpp
+#include "AXTrace.h"
+
+#if AX_ENABLE_TRACE
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#define AX_LOG_TAG "AXTrace"
+#include "AXLog.h"
+
+// 每线程环容量（2 的幂）：每事件 24B，约 384KB/线程，仅在录制时首次写事件的线程上分配（或由 createRing 预先分配）
+constexpr uint64_t kRingCap = 1u << 14;
+
+/**
+ * 单写者环：写者先写槽位再 release 发布 head；槽位字段本身也用 release/acquire，
+ * 读者读完一段后重读 head，凡是可能已被写者追上覆盖的槽位（idx + cap <= head）都丢弃，
+ * 因此不会导出撕裂的事件，也不需要任何锁。
+ */
+struct AXTraceRing {
+    struct Slot {
+        std::atomic<const char *> name{nullptr};
+        std::atomic<int64_t> beginNs{0};
+        std::atomic<int64_t> endNs{0};
+    };
+
+    std::atomic<long> tid{0};   // 预建的环在 attachRing 时才知道写者线程
+    char name[32]{};
+    std::atomic<uint64_t> head{0};
+    Slot slots[kRingCap];
+};
+
+namespace {
+
+struct Registry {
+    std::mutex mtx;
+    std::vector<std::shared_ptr<AXTraceRing>> rings;
+    std::atomic<int64_t> startNs{0};
+};
+
+Registry &registry() {
+    static Registry r;
+    return r;
+}
+
+void registerRing(const std::shared_ptr<AXTraceRing> &ring) {
+    Registry &r = registry();
+    std::lock_guard<std::mutex> _l(r.mtx);
+    r.rings.push_back(ring);
+}
+
+thread_local char tlsName[32] = {};
+thread_local std::shared_ptr<AXTraceRing> tlsRing;
+
+AXTraceRing *ringForThisThread() {
+    if (tlsRing) return tlsRing.get();
+    auto ring = std::make_shared<AXTraceRing>();
+    ring->tid.store((long) syscall(SYS_gettid), std::memory_order_relaxed);
+    std::memcpy(ring->name, tlsName, sizeof(ring->name));
+    registerRing(ring);
+    tlsRing = std::move(ring);
+    return tlsRing.get();
+}
+
+// 线程名只来自本库代码，这里仅防御性地跳过会破坏 JSON 的字符
+void writeJsonString(FILE *fp, const char *s) {
+    std::fputc('"', fp);
+    for (; s && *s; ++s) {
+        if (*s == '"' || *s == '\\' || (unsigned char) *s < 0x20) continue;
+        std::fputc(*s, fp);
+    }
+    std::fputc('"', fp);
+}
+
+} // namespace
+
+std::atomic<bool> AXTrace::recording_{false};
+
+int64_t AXTrace::nowNs() {
+    timespec ts{};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t) ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+void AXTrace::start() {
+    Registry &r = registry();
+    {
+        // 已退出线程的环只剩注册表这一个引用，顺手回收
+        std::lock_guard<std::mutex> _l(r.mtx);
+        auto &v = r.rings;
+        for (size_t i = 0; i < v.size();) {
+            if (v[i].use_count() == 1) {
+                v[i] = std::move(v.back());
+                v.pop_back();
+            } else {
+                ++i;
+            }
+        }
+    }
+    r.startNs.store(nowNs(), std::memory_order_relaxed);
+    recording_.store(true, std::memory_order_release);
+    AX_LOGI("trace recording started");
+}
+
+void AXTrace::stop() {
+    recording_.store(false, std::memory_order_release);
+    AX_LOGI("trace recording stopped");
+}
+
+void AXTrace::setThreadName(const char *name) {
+    if (!name) return;
+    std::strncpy(tlsName, name, sizeof(tlsName) - 1);
+    tlsName[sizeof(tlsName) - 1] = '\0';
+}
+
+std::shared_ptr<AXTraceRing> AXTrace::createRing(const char *name) {
+    auto ring = std::make_shared<AXTraceRing>();
+    if (name) {
+        std::strncpy(ring->name, name, sizeof(ring->name) - 1);
+        ring->name[sizeof(ring->name) - 1] = '\0';
+    }
+    registerRing(ring);
+    return ring;
+}
+
+void AXTrace::attachRing(AXTraceRing *ring) {
+    if (ring) ring->tid.store((long) syscall(SYS_gettid), std::memory_order_relaxed);
+}
+
+void AXTrace::record(const char *name, int64_t beginNs, int64_t endNs) {
+    recordTo(ringForThisThread(), name, beginNs, endNs);
+}
+
+void AXTrace::recordTo(AXTraceRing *ring, const char *name, int64_t beginNs, int64_t endNs) {
+    const uint64_t idx = ring->head.load(std::memory_order_relaxed);
+    AXTraceRing::Slot &s = ring->slots[idx & (kRingCap - 1)];
+    s.name.store(name, std::memory_order_release);
+    s.beginNs.store(beginNs, std::memory_order_release);
+    s.endNs.store(endNs, std::memory_order_release);
+    ring->head.store(idx + 1, std::memory_order_release);
+}
+
+bool AXTrace::dump(const char *path) {
+    if (!path || !*path) return false;
+
+    struct Event {
+        const char *name;
+        int64_t beginNs;
+        int64_t endNs;
+    };
+
+    Registry &r = registry();
+    std::vector<std::shared_ptr<AXTraceRing>> rings;
+    {
+        std::lock_guard<std::mutex> _l(r.mtx);
+        rings = r.rings;
+    }
+    const int64_t startNs = r.startNs.load(std::memory_order_relaxed);
+
+    FILE *fp = std::fopen(path, "w");
+    if (!fp) {
+        AX_LOGE("open trace file failed: %s", path);
+        return false;
+    }
+
+    const long pid = (long) getpid();
+    size_t total = 0;
+    bool first = true;
+    std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", fp);
+
+    std::vector<Event> evs;
+    evs.reserve(kRingCap);
+    for (const auto &ring: rings) {
+        const long tid = ring->tid.load(std::memory_order_relaxed);
+        const uint64_t head = ring->head.load(std::memory_order_acquire);
+        const uint64_t lo = head > kRingCap ? head - kRingCap : 0;
+        evs.clear();
+        for (uint64_t i = lo; i < head; ++i) {
+            const AXTraceRing::Slot &s = ring->slots[i & (kRingCap - 1)];
+            evs.push_back({s.name.load(std::memory_order_acquire),
+                           s.beginNs.load(std::memory_order_acquire),
+                           s.endNs.load(std::memory_order_acquire)});
+        }
+        // 读的过程中写者可能已经绕回：丢掉可能被覆盖的前段
+        const uint64_t head2 = ring->head.load(std::memory_order_acquire);
+        const uint64_t safeLo = head2 >= kRingCap ? head2 - kRingCap + 1 : 0;
+        const size_t skip = safeLo > lo ? (size_t) std::min<uint64_t>(safeLo - lo, evs.size()) : 0;
+
+        std::fprintf(fp, "%s{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":%ld,\"tid\":%ld,\"args\":{\"name\":",
+                     first ? "" : ",\n", pid, tid);
+        writeJsonString(fp, ring->name[0] ? ring->name : "thread");
+        std::fputs("}}", fp);
+        first = false;
+
+        for (size_t i = skip; i < evs.size(); ++i) {
+            const Event &e = evs[i];
+            if (!e.name || e.beginNs < startNs) continue;
+            std::fprintf(fp, ",\n{\"ph\":\"X\",\"cat\":\"ax\",\"name\":");
+            writeJsonString(fp, e.name);
+            std::fprintf(fp, ",\"pid\":%ld,\"tid\":%ld,\"ts\":%.3f,\"dur\":%.3f}",
+                         pid, tid, (double) e.beginNs / 1000.0, (double) (e.endNs - e.beginNs) / 1000.0);
+            ++total;
+        }
+    }
+
+    std::fputs("\n]}\n", fp);
+    const bool ok = std::fclose(fp) == 0;
+    AX_LOGI("trace dumped: %zu events, %zu threads -> %s", total, rings.size(), path);
+    return ok;
+}
+
+#endif // AX_ENABLE_TRACE
@@ -1,5 +1,11 @@
 #include "AXVideoRenderer.h"
-#include <android/log.h>
+#include "AXTrace.h"
+
+#include <cstring>
+#include <string>
+
+// 等上传槽的 fence：三槽轮转下正常早已 signaled；超时说明 GPU 严重落后，本帧改走直接上传，fence 保留到 signaled 为止
+static constexpr GLuint64 kUploadFenceWaitNs = 4'000'000;
 
 
 // =================== 着色器源码 ===================
@@ -13,30 +19,70 @@ void main(){
 }
 )";
 
-// YUV420P/I420 => RGB
-static const char* kFS = R"(#version 310 es
-precision mediump float;
+// YUV => RGB：同一份源码按布局拼上不同的宏，编出 AXYuvKind 的 4 个变体（见 fragmentSource）
+//   AX_SEMI    ：U/V 交错在 uTexU 的 rg 分量（NV12/NV21/P010），uSwapUV 处理 VU 顺序
+//   AX_HIGHBIT ：16 位整数纹理（R16UI/RG16UI 不能线性过滤），texelFetch 手动双线性后乘 uScale 归一化
+static const char* kFSBody = R"(
+precision highp float;
+precision highp int;
 in vec2 vTex;
 out vec4 fragColor;
 
+#if AX_HIGHBIT
+precision highp usampler2D;
+uniform usampler2D uTexY;
+uniform usampler2D uTexU;
+uniform usampler2D uTexV;
+uniform float uScale;
+
+vec4 sampleTex(usampler2D t, vec2 uv) {
+    ivec2 size = textureSize(t, 0);
+    vec2 p = uv * vec2(size) - 0.5;
+    vec2 f = fract(p);
+    ivec2 i0 = ivec2(floor(p));
+    ivec2 hi = size - 1;
+    vec4 a = vec4(texelFetch(t, clamp(i0,               ivec2(0), hi), 0));
+    vec4 b = vec4(texelFetch(t, clamp(i0 + ivec2(1, 0), ivec2(0), hi), 0));
+    vec4 c = vec4(texelFetch(t, clamp(i0 + ivec2(0, 1), ivec2(0), hi), 0));
+    vec4 d = vec4(texelFetch(t, clamp(i0 + ivec2(1, 1), ivec2(0), hi), 0));
+    return mix(mix(a, b, f.x), mix(c, d, f.x), f.y) * uScale;
+}
+#else
 uniform sampler2D uTexY;
 uniform sampler2D uTexU;
 uniform sampler2D uTexV;
 
-void main(){
-    float y = texture(uTexY, vTex).r;
-    float u = texture(uTexU, vTex).r - 0.5;
-    float v = texture(uTexV, vTex).r - 0.5;
+vec4 sampleTex(sampler2D t, vec2 uv) { return texture(t, uv); }
+#endif
 
-    // BT.601
-    float r = y + 1.402 * v;
-    float g = y - 0.344136 * u - 0.714136 * v;
-    float b = y + 1.772 * u;
+uniform int uSwapUV;
+// rgb = uColorMat * (yuv - uColorOff)：系数/零点按帧的 colorspace、range、位深选（AXColorMatrix）
+uniform mat3 uColorMat;
+uniform vec3 uColorOff;
 
-    fragColor = vec4(r, g, b, 1.0);
+void main(){
+    float y = sampleTex(uTexY, vTex).r;
+#if AX_SEMI
+    vec2 uv = sampleTex(uTexU, vTex).rg;
+    if (uSwapUV != 0) uv = uv.yx;
+#else
+    vec2 uv = vec2(sampleTex(uTexU, vTex).r, sampleTex(uTexV, vTex).r);
+#endif
+    vec3 rgb = uColorMat * (vec3(y, uv) - uColorOff);
+    fragColor = vec4(clamp(rgb, 0.0, 1.0), 1.0);
 }
 )";
 
+static std::string fragmentSource(AXYuvKind kind) {
+    const bool semi = kind == AXYuvKind::Semi8 || kind == AXYuvKind::Semi16;
+    const bool high = kind == AXYuvKind::Planar16 || kind == AXYuvKind::Semi16;
+    std::string src = "#version 310 es\n";
+    src += semi ? "#define AX_SEMI 1\n" : "#define AX_SEMI 0\n";
+    src += high ? "#define AX_HIGHBIT 1\n" : "#define AX_HIGHBIT 0\n";
+    src += kFSBody;
+    return src;
+}
+
 // =================== 小工具 ===================
 static GLuint compileShader(GLenum type, const char* src) {
     GLuint sh = glCreateShader(type);
@@ -79,9 +125,10 @@ AXVideoRenderer::~AXVideoRenderer() { release(); }
 // =================== EGL/GLES 生命周期 ===================
 bool AXVideoRenderer::init(ANativeWindow* win, int w, int h, int sarNum, int sarDen) {
     std::lock_guard<std::mutex> lk(wMtx_);
-    // 释放旧窗口的 Surface（保留 Context/Display）
+    // 释放旧窗口的 Surface（保留 Context/Display）。
+    // 调用方不是渲染线程：这里不 makeCurrent；若 surface 仍在渲染线程上 current，
+    // EGL 会推迟到渲染线程切走（见 ensureEGL_/releaseCurrent_）后再真正销毁
     if (surface_ != EGL_NO_SURFACE) {
-        eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
         eglDestroySurface(display_, surface_);
         surface_ = EGL_NO_SURFACE;
     }
@@ -102,22 +149,26 @@ bool AXVideoRenderer::init(ANativeWindow* win, int w, int h, int sarNum, int sar
     sarNum_ = (sarNum > 0) ? sarNum : 1;
     sarDen_ = (sarDen > 0) ? sarDen : 1;
 
-    if (!ensureEGL_()) {
-        AX_LOGE("ensureEGL_ failed");
-        return false;
-    }
-    if (!ensureGLObjects_()) {
-        AX_LOGE("ensureGLObjects_ failed");
-        return false;
-    }
+    // EGL/GL 对象统一在渲染线程首次 drawLoopOnce 时创建（context 只在渲染线程 current）
     AX_LOGI("init ok: w=%d h=%d sar=%d/%d", videoW_, videoH_, sarNum_, sarDen_);
     return true;
 }
 
+void AXVideoRenderer::releaseCurrent_() {
+    if (display_ != EGL_NO_DISPLAY && eglGetCurrentContext() == context_ && context_ != EGL_NO_CONTEXT) {
+        eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    }
+}
+
+void AXVideoRenderer::detachThread() {
+    std::lock_guard<std::mutex> lk(wMtx_);
+    releaseCurrent_();
+}
+
 void AXVideoRenderer::release() {
     std::lock_guard<std::mutex> lk(wMtx_);
 
-    if (pending_) { av_frame_free(&pending_); pending_ = nullptr; }
+    dropPending_();
 
     if (display_ != EGL_NO_DISPLAY) {
         EGLSurface target = surface_;
@@ -157,7 +208,12 @@ void AXVideoRenderer::release() {
     context_ = EGL_NO_CONTEXT;
     config_  = nullptr;
 
-    prog_ = texY_ = texU_ = texV_ = vao_ = vbo_ = 0;
+    for (auto& p : progs_) p = YuvProgram{};
+    texY_ = texU_ = texV_ = vao_ = vbo_ = 0;
+    texW_ = texH_ = 0;
+    texFmt_ = -1;
+    for (auto& s : slots_) s = UploadSlot{};   // context 已销毁：句柄随之失效
+    slotIdx_ = 0;
     lastWinW_ = lastWinH_ = 0;
     win_ = nullptr;
 }
@@ -213,6 +269,8 @@ bool AXVideoRenderer::ensureEGL_() {
         }
     }
 
+    // 渲染线程上已 current 时不重复切换
+    if (eglGetCurrentContext() == context_ && eglGetCurrentSurface(EGL_DRAW) == surface_) return true;
     if (!eglMakeCurrent(display_, surface_, surface_, context_)) {
         AX_LOGE("eglMakeCurrent failed");
         return false;
@@ -241,31 +299,11 @@ void AXVideoRenderer::destroyEGL_() {
 
 // =================== GL 资源 ===================
 bool AXVideoRenderer::ensureGLObjects_() {
-    if (prog_ != 0) return true;
-
-    GLuint vs = compileShader(GL_VERTEX_SHADER,   kVS);
-    GLuint fs = compileShader(GL_FRAGMENT_SHADER, kFS);
-    if (!vs || !fs) {
-        if (vs) glDeleteShader(vs);
-        if (fs) glDeleteShader(fs);
-        return false;
-    }
-    prog_ = linkProgram(vs, fs);
-    glDeleteShader(vs);
-    glDeleteShader(fs);
-    if (!prog_) return false;
+    if (vao_ != 0) return true;
 
     aPosLoc_ = 0; // layout(location=0)
     aTexLoc_ = 1; // layout(location=1)
 
-    glUseProgram(prog_);
-    uTexY_ = glGetUniformLocation(prog_, "uTexY");
-    uTexU_ = glGetUniformLocation(prog_, "uTexU");
-    uTexV_ = glGetUniformLocation(prog_, "uTexV");
-    glUniform1i(uTexY_, 0);
-    glUniform1i(uTexU_, 1);
-    glUniform1i(uTexV_, 2);
-
     // 顶点数据：两个三角形的全屏矩形
     const GLfloat verts[] = {
             // pos     // uv(翻转 v)
@@ -286,28 +324,115 @@ bool AXVideoRenderer::ensureGLObjects_() {
     glVertexAttribPointer(aTexLoc_, 2, GL_FLOAT, GL_FALSE, sizeof(float)*4, (void*)(sizeof(float)*2));
     glBindVertexArray(0);
 
-    // 3 个 LUMA/CHROMA 纹理（GL_R8）
-    glGenTextures(1, &texY_);
-    glGenTextures(1, &texU_);
-    glGenTextures(1, &texV_);
+    // program 按布局在 ensureProgram_ 里编译；纹理与上传环按首帧尺寸/格式在 ensureTextures_ 里创建
+    return true;
+}
+
+bool AXVideoRenderer::ensureProgram_(AXYuvKind kind) {
+    YuvProgram& p = progs_[(int)kind];
+    if (p.id != 0) return true;
 
-    auto setupTex = [](GLuint tex){
-        glBindTexture(GL_TEXTURE_2D, tex);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    GLuint vs = compileShader(GL_VERTEX_SHADER,   kVS);
+    GLuint fs = compileShader(GL_FRAGMENT_SHADER, fragmentSource(kind).c_str());
+    if (!vs || !fs) {
+        if (vs) glDeleteShader(vs);
+        if (fs) glDeleteShader(fs);
+        return false;
+    }
+    p.id = linkProgram(vs, fs);
+    glDeleteShader(vs);
+    glDeleteShader(fs);
+    if (!p.id) return false;
+
+    glUseProgram(p.id);
+    glUniform1i(glGetUniformLocation(p.id, "uTexY"), 0);
+    glUniform1i(glGetUniformLocation(p.id, "uTexU"), 1);
+    glUniform1i(glGetUniformLocation(p.id, "uTexV"), 2);   // 交错布局里被优化掉，location=-1 时调用无效果
+    p.uSwapUV = glGetUniformLocation(p.id, "uSwapUV");
+    p.uScale  = glGetUniformLocation(p.id, "uScale");
+    p.uColorMat = glGetUniformLocation(p.id, "uColorMat");
+    p.uColorOff = glGetUniformLocation(p.id, "uColorOff");
+    p.colorKey = 0;
+    glUseProgram(0);
+    AX_LOGI("yuv program %d ready", (int)kind);
+    return true;
+}
+
+// 各平面纹理格式：8 位用可线性过滤的 R8/RG8；16 位容器用整数纹理（GLES3 核心不保证 R16 归一化格式）
+struct PlaneTexFormat {
+    GLenum internal;
+    GLenum format;
+    GLenum type;
+    bool integer;
+};
+
+static PlaneTexFormat planeTexFormat(const AXYuvFormat& yf, int p) {
+    const bool rg = yf.components(p) == 2;
+    if (yf.bytesPerSample == 2) {
+        return {rg ? (GLenum)GL_RG16UI : (GLenum)GL_R16UI, rg ? (GLenum)GL_RG_INTEGER : (GLenum)GL_RED_INTEGER,
+                GL_UNSIGNED_SHORT, true};
+    }
+    return {rg ? (GLenum)GL_RG8 : (GLenum)GL_R8, rg ? (GLenum)GL_RG : (GLenum)GL_RED, GL_UNSIGNED_BYTE, false};
+}
+
+// 帧尺寸或像素格式变化（含首帧）时重建：不可变纹理不能改尺寸/格式，只能删了重建；上传环随之重新分配
+bool AXVideoRenderer::ensureTextures_(const AVFrame* frm, const AXYuvFormat& yf) {
+    const int w = frm->width, h = frm->height;
+    if (w <= 0 || h <= 0) return false;
+    if (texY_ && w == texW_ && h == texH_ && frm->format == texFmt_) return true;
+    while (glGetError() != GL_NO_ERROR) {}   // 清掉旧错误，下面据此判断分配是否成功
+
+    if (texV_) { glDeleteTextures(1, &texV_); texV_ = 0; }
+    if (texU_) { glDeleteTextures(1, &texU_); texU_ = 0; }
+    if (texY_) { glDeleteTextures(1, &texY_); texY_ = 0; }
+    destroyUploadRing_();
+
+    GLuint* tex[3] = {&texY_, &texU_, &texV_};
+    for (int p = 0; p < yf.planes; ++p) {
+        const PlaneTexFormat tf = planeTexFormat(yf, p);
+        // 整数纹理不支持线性过滤，必须 NEAREST（双线性在着色器里做）
+        const GLint filter = tf.integer ? GL_NEAREST : GL_LINEAR;
+        glGenTextures(1, tex[p]);
+        glBindTexture(GL_TEXTURE_2D, *tex[p]);
+        // 色度向上取整：奇数宽高时最后一列/行也有对应色度样本
+        glTexStorage2D(GL_TEXTURE_2D, 1, tf.internal, yf.planeWidth(p, w), yf.planeHeight(p, h));
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S,     GL_CLAMP_TO_EDGE);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T,     GL_CLAMP_TO_EDGE);
-        glBindTexture(GL_TEXTURE_2D, 0);
-    };
-    setupTex(texY_);
-    setupTex(texU_);
-    setupTex(texV_);
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
 
-    glUseProgram(0);
+    // 存储大小取决于解码器的 linesize，首次上传时按需分配
+    for (auto& s : slots_) glGenBuffers(1, &s.pbo);
+    slotIdx_ = 0;
+
+    const GLenum err = glGetError();
+    if (err != GL_NO_ERROR) {
+        AX_LOGE("texture storage %dx%d fmt=%d failed: 0x%x", w, h, frm->format, err);
+        return false;
+    }
+    texW_ = w;
+    texH_ = h;
+    texFmt_ = frm->format;
+    AX_LOGI("texture storage %dx%d fmt=%d (%d planes, %d-byte samples), upload ring x%d",
+            w, h, frm->format, yf.planes, yf.bytesPerSample, kUploadSlots);
     return true;
 }
 
+void AXVideoRenderer::destroyUploadRing_() {
+    for (auto& s : slots_) {
+        if (s.fence) { glDeleteSync(s.fence); s.fence = nullptr; }
+        if (s.pbo) { glDeleteBuffers(1, &s.pbo); s.pbo = 0; }
+        s.bytes = 0;
+    }
+    slotIdx_ = 0;
+    texW_ = texH_ = 0;
+    texFmt_ = -1;
+}
+
 void AXVideoRenderer::destroyGLObjects_() {
+    destroyUploadRing_();
     if (texV_) { glDeleteTextures(1, &texV_); texV_ = 0; }
     if (texU_) { glDeleteTextures(1, &texU_); texU_ = 0; }
     if (texY_) { glDeleteTextures(1, &texY_); texY_ = 0; }
@@ -315,73 +440,208 @@ void AXVideoRenderer::destroyGLObjects_() {
     if (vbo_)  { glDeleteBuffers(1, &vbo_); vbo_ = 0; }
     if (vao_)  { glDeleteVertexArrays(1, &vao_); vao_ = 0; }
 
-    if (prog_) { glDeleteProgram(prog_); prog_ = 0; }
+    for (auto& p : progs_) {
+        if (p.id) glDeleteProgram(p.id);
+        p = YuvProgram{};
+    }
 }
 
 // =================== 渲染节流与绘制 ===================
-void AXVideoRenderer::drawLoopOnce(int64_t masterPtsUs) {
+int64_t AXVideoRenderer::drawLoopOnce(int64_t masterPtsUs) {
     std::lock_guard<std::mutex> lk(wMtx_);
-    if (!win_ || !ensureEGL_() || !ensureGLObjects_()) return;
-
-    // 取/保持一个待渲染帧
-    if (!pending_) {
-        if (!fQ_) return;
-        if (!fQ_->pop(pending_) || !pending_) return;
+    if (!win_) {
+        releaseCurrent_();   // 让已被 init(null) 销毁的旧 surface 真正释放
+        return kNoFrame;
     }
+    if (!ensureEGL_() || !ensureGLObjects_()) return kNoFrame;
+
+    // 一次调用内：丢掉所有已过期的帧，最多显示一帧（同步判定与像素格式无关）
+    int64_t waitUs = kNoFrame;
+    AVFrame* frm = takeDueFrame_(masterPtsUs, waitUs);
+    if (!frm) return waitUs;
 
-    // 只处理 YUV420P/I420
-    if (pending_->format != AV_PIX_FMT_YUV420P) {
-        // TODO: sws/libyuv 转换；当前直接“尽量显示”，避免卡在队列
-        drawFrame_(pending_);
-        av_frame_free(&pending_);
+    const bool drawn = drawFrame_(frm);
+    axFrameFree(&frm);
+    if (!drawn) return 0;   // 格式不支持或 GL 资源失败：帧已消费，保留上一画面
+
+//    AX_LOGI("render frame; swap, masterUs=%lld", (long long)masterPtsUs);
+    {
+        AX_TRACE_SCOPE("eglSwapBuffers");
         eglSwapBuffers(display_, surface_);
-        return;
     }
+    // 交换按 vsync 节拍返回（队列满时阻塞到下一次翻页）：返回时刻即刷新相位样本
+    onPresented_(axStampNowUs());
+    return 0;
+}
+
+// 单个平面的上传几何：stride 为源 linesize（字节），负值表示倒序行
+namespace {
+struct PlaneGeom {
+    const uint8_t* src;
+    int w, h;      // 像素
+    int bpp;       // 每像素字节数
+    int stride;
+
+    size_t rowBytes() const { return (size_t)w * bpp; }
+    // 正 stride（且为整像素）：整块按原 linesize 拷/传，交给 GL_UNPACK_ROW_LENGTH 跳过填充，不逐行重排
+    bool rowLengthOk() const { return stride >= (int)rowBytes() && stride % bpp == 0; }
+    GLint rowLength() const { return rowLengthOk() ? stride / bpp : 0; }
+    size_t bytes() const { return rowLengthOk() ? (size_t)stride * (h - 1) + rowBytes() : rowBytes() * h; }
+};
+
+// 逐行重排为紧排（只在负 linesize 时走到；memcpy 自带 SIMD，单遍完成）
+void repackPlane(uint8_t* dst, const PlaneGeom& g) {
+    const size_t rb = g.rowBytes();
+    for (int y = 0; y < g.h; ++y) {
+        std::memcpy(dst + (size_t)y * rb, g.src + (ptrdiff_t)y * g.stride, rb);
+    }
+}
+
+int planesOf(const AVFrame* frm, const AXYuvFormat& yf, int w, int h, PlaneGeom out[3]) {
+    for (int p = 0; p < yf.planes; ++p) {
+        out[p] = {frm->data[p], yf.planeWidth(p, w), yf.planeHeight(p, h), yf.bytesPerPixel(p), frm->linesize[p]};
+    }
+    return yf.planes;
+}
 
-    const int64_t ptsUs = framePtsUs_(pending_, tb_);
-    if (ptsUs >= 0) {
-        const int64_t diff = ptsUs - masterPtsUs;
-        if (diff > +20000) {
-            // 提前太多：等下次
+constexpr size_t kPlaneAlign = 64;   // PBO 内各平面起点对齐，利于 memcpy / DMA
+} // namespace
+
+// 经 PBO 上传：拷进当前槽（映射时不同步，由该槽上次的 fence 保证 GPU 已读完），
+// glTexSubImage2D 从 PBO 偏移取数，驱动可以异步 DMA，渲染线程不等拷贝完成。
+// 平面按源 linesize 原样拷入（每平面一次 memcpy），行尾填充由 GL_UNPACK_ROW_LENGTH 跳过
+void AXVideoRenderer::uploadPlanes_(const AVFrame* frm, const AXYuvFormat& yf) {
+    UploadSlot& slot = slots_[slotIdx_];
+    if (slot.fence) {
+        const GLenum st = glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, kUploadFenceWaitNs);
+        if (st == GL_TIMEOUT_EXPIRED) {
+            // 当前槽是环里最早提交的，它没完成其余槽也不会完成：保留 fence（下一帧接着等），本帧直接上传。
+            // fence 未 signaled 前绝不能不同步映射这个槽
+            AX_LOGW("upload slot %d busy, direct upload", slotIdx_);
+            uploadPlanesDirect_(frm, yf);
             return;
         }
-        if (diff < -120000) {
-            // 落后太多：丢帧追时钟
-            av_frame_free(&pending_);
-            return;
+        if (st == GL_WAIT_FAILED) {
+            // fence 本身不可用：glFinish 之后 GPU 必然已读完该槽，可以安全复用
+            AX_LOGW("upload slot %d wait failed: 0x%x", slotIdx_, glGetError());
+            glFinish();
         }
+        glDeleteSync(slot.fence);
+        slot.fence = nullptr;
     }
-    // 未知 PTS 或在窗口内：渲染
-    drawFrame_(pending_);
-    av_frame_free(&pending_);
 
-//    AX_LOGI("render frame; swap, masterUs=%lld", (long long)masterPtsUs);
-    eglSwapBuffers(display_, surface_);
-}
+    PlaneGeom pl[3];
+    const int n = planesOf(frm, yf, texW_, texH_, pl);
+    size_t off[3];
+    size_t need = 0;
+    for (int p = 0; p < n; ++p) {
+        off[p] = need;
+        need += (pl[p].bytes() + kPlaneAlign - 1) & ~(kPlaneAlign - 1);
+    }
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.pbo);
+    if (slot.bytes < (GLsizeiptr)need) {
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, (GLsizeiptr)need, nullptr, GL_STREAM_DRAW);
+        slot.bytes = (GLsizeiptr)need;
+    }
+    auto* dst = (uint8_t*)glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, (GLsizeiptr)need,
+                                           GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    if (!dst) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        AX_LOGW("glMapBufferRange failed: 0x%x, direct upload", glGetError());
+        uploadPlanesDirect_(frm, yf);
+        return;
+    }
+    for (int p = 0; p < n; ++p) {
+        if (pl[p].rowLengthOk()) std::memcpy(dst + off[p], pl[p].src, pl[p].bytes());
+        else repackPlane(dst + off[p], pl[p]);
+    }
+    if (glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) != GL_TRUE) {
+        // 映射期间存储被破坏（如显存被回收）：本帧内容不可信
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        uploadPlanesDirect_(frm, yf);
+        return;
+    }
+
+    const GLuint tex[3] = {texY_, texU_, texV_};
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    for (int p = 0; p < n; ++p) {
+        const PlaneTexFormat tf = planeTexFormat(yf, p);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, pl[p].rowLength());
+        glActiveTexture(GL_TEXTURE0 + p);
+        glBindTexture(GL_TEXTURE_2D, tex[p]);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, pl[p].w, pl[p].h, tf.format, tf.type,
+                        (const void*)(uintptr_t)off[p]);
+    }
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
 
-void AXVideoRenderer::drawFrame_(AVFrame* frm) {
-    if (!frm) return;
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slotIdx_ = (slotIdx_ + 1) % kUploadSlots;
+}
 
-    // 更新纹理（假设 YUV420P）
-    const int w = frm->width;
-    const int h = frm->height;
+// 兜底：从客户端内存同步上传到同一组不可变纹理（同样用 ROW_LENGTH 跳过填充，负 linesize 先重排）
+void AXVideoRenderer::uploadPlanesDirect_(const AVFrame* frm, const AXYuvFormat& yf) {
+    PlaneGeom pl[3];
+    const int n = planesOf(frm, yf, texW_, texH_, pl);
+    const GLuint tex[3] = {texY_, texU_, texV_};
 
     glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    for (int p = 0; p < n; ++p) {
+        const PlaneTexFormat tf = planeTexFormat(yf, p);
+        const uint8_t* src = pl[p].src;
+        if (!pl[p].rowLengthOk()) {
+            repack_.resize(pl[p].bytes());
+            repackPlane(repack_.data(), pl[p]);
+            src = repack_.data();
+        }
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, pl[p].rowLength());
+        glActiveTexture(GL_TEXTURE0 + p);
+        glBindTexture(GL_TEXTURE_2D, tex[p]);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, pl[p].w, pl[p].h, tf.format, tf.type, src);
+    }
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+}
+
+// uniform 是 program 状态：每个 program 记住上次上传的矩阵，只有 colorspace/range/位深变化时才重传
+void AXVideoRenderer::applyColorMatrix_(YuvProgram& prog, const AVFrame* frm, const AXYuvFormat& yf) {
+    const int cs = axResolveColorSpace(frm->colorspace, frm->height);
+    const int range = axResolveColorRange(frm->color_range, yf.jpegRange);
+    const uint32_t key = axColorMatrixKey(cs, range, yf.bitDepth);
+    if (key == prog.colorKey) return;
+
+    AXColorMatrix m;
+    axColorMatrixFor(cs, range, yf.bitDepth, m);
+    glUniformMatrix3fv(prog.uColorMat, 1, GL_FALSE, m.mat);
+    glUniform3fv(prog.uColorOff, 1, m.offset);
+    if (key != colorKey_) {
+        AX_LOGI("color matrix: colorspace=%d(frame %d) range=%d(frame %d) depth=%d",
+                cs, (int) frm->colorspace, range, (int) frm->color_range, yf.bitDepth);
+        colorKey_ = key;
+    }
+    prog.colorKey = key;
+}
 
-    // Y
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, texY_);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, w, h, 0, GL_RED, GL_UNSIGNED_BYTE, frm->data[0]);
+bool AXVideoRenderer::drawFrame_(AVFrame* frm) {
+    if (!frm) return false;
 
-    // U
-    glActiveTexture(GL_TEXTURE1);
-    glBindTexture(GL_TEXTURE_2D, texU_);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, w/2, h/2, 0, GL_RED, GL_UNSIGNED_BYTE, frm->data[1]);
+    AXYuvFormat yf;
+    if (!axYuvFormatOf(frm->format, yf)) {
+        if (unsupportedFmt_ != frm->format) {
+            unsupportedFmt_ = frm->format;
+            AX_LOGW("unsupported pixel format %d, frame skipped", frm->format);
+        }
+        return false;
+    }
+    if (!ensureProgram_(yf.kind) || !ensureTextures_(frm, yf)) return false;
 
-    // V
-    glActiveTexture(GL_TEXTURE2);
-    glBindTexture(GL_TEXTURE_2D, texV_);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, w/2, h/2, 0, GL_RED, GL_UNSIGNED_BYTE, frm->data[2]);
+    const int64_t uploadStartUs = tel_ ? axStampNowUs() : 0;
+    {
+        AX_TRACE_SCOPE("glTexSubImage2D");
+        uploadPlanes_(frm, yf);
+    }
+    // CPU 侧提交耗时（PBO 填充 + 提交；GPU 侧 DMA 不计）
+    if (tel_) tel_->uploadUs.record(axStampNowUs() - uploadStartUs);
 
     // 计算 viewport（保持比例 + letterbox）
     EGLint winW = 0, winH = 0;
@@ -400,11 +660,16 @@ void AXVideoRenderer::drawFrame_(AVFrame* frm) {
     glClearColor(0.f, 0.f, 0.f, 1.f);
     glClear(GL_COLOR_BUFFER_BIT);
 
-    glUseProgram(prog_);
+    YuvProgram& prog = progs_[(int)yf.kind];
+    glUseProgram(prog.id);
+    glUniform1i(prog.uSwapUV, yf.swapUV ? 1 : 0);
+    glUniform1f(prog.uScale, yf.sampleScale);
+    applyColorMatrix_(prog, frm, yf);
     glBindVertexArray(vao_);
     glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
     glBindVertexArray(0);
     glUseProgram(0);
+    return true;
 }
 
 void AXVideoRenderer::computeViewport_(int winW, int winH, int& vx, int& vy, int& vw, int& vh) {
@@ -0,0 +1,91 @@
+//AXPlayerLib/MediaCore/player/core/AXVideoSink.cpp
+#include "AXVideoSink.h"
+
+#include "AXAvPool.h"
+#include "AXStageStamp.h"
+
+AXVideoSink::~AXVideoSink() {
+    dropPending_();
+}
+
+void AXVideoSink::dropPending_() {
+    if (pending_) axFrameFree(&pending_);
+    if (next_) axFrameFree(&next_);
+    pending_ = nullptr;
+    next_ = nullptr;
+}
+
+bool AXVideoSink::popFrame_(AVFrame *&out) {
+    out = nullptr;
+    if (!fQ_ || !fQ_->tryPop(out, std::chrono::milliseconds(0)) || !out) {
+        out = nullptr;
+        return false;
+    }
+    sched_.onFrame(framePtsUs_(out, tb_));
+    return true;
+}
+
+AVFrame *AXVideoSink::takeDueFrame_(int64_t masterPtsUs, int64_t &waitUs) {
+    if (flushReq_.exchange(false, std::memory_order_acq_rel)) {
+        dropPending_();
+        sched_.reset();
+        firstFrameFromUs_ = seekReqUs_.exchange(-1, std::memory_order_relaxed);
+        previewArmed_.store(previewReq_.exchange(false, std::memory_order_acq_rel), std::memory_order_release);
+    }
+    sched_.setSpeed(speed_.load(std::memory_order_relaxed));
+    const int64_t nowUs = axStampNowUs();
+
+    for (;;) {
+        // 取/保持一个待渲染帧（非阻塞：没有就交给上层等队列就绪）
+        if (!pending_) {
+            pending_ = next_;
+            next_ = nullptr;
+            if (!pending_ && !popFrame_(pending_)) {
+                waitUs = kNoFrame;
+                return nullptr;
+            }
+        }
+
+        const int64_t ptsUs = framePtsUs_(pending_, tb_);
+        if (previewArmed_.exchange(false, std::memory_order_acq_rel)) {
+            // 拖动预览：seek 后首帧（最近的关键帧）立即上屏，不参与时钟调度
+        } else if (ptsUs >= 0) {
+            // 预取下一帧（可能还没解出来）：它若也赶得上同一个 vsync，当前帧就不必上屏
+            if (!next_) popFrame_(next_);
+            const int64_t nextPtsUs = next_ ? framePtsUs_(next_, tb_) : -1;
+
+            const AXFrameScheduler::Decision d = sched_.decide(ptsUs, nextPtsUs, masterPtsUs, nowUs);
+            if (d.action == AXFrameScheduler::Action::Wait) {
+                waitUs = d.waitUs;
+                return nullptr;
+            }
+            if (d.action == AXFrameScheduler::Action::Drop) {
+                axFrameFree(&pending_);
+                pending_ = nullptr;
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                if (tel_) tel_->framesDropped.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            if (tel_) {
+                const int64_t diff = ptsUs - masterPtsUs;
+                if (diff >= 0) tel_->presentEarlyUs.record(diff);
+                else tel_->presentLateUs.record(-diff);
+            }
+        }
+        // 未知 PTS 或已到点：交给实现呈现
+        AVFrame *due = pending_;
+        pending_ = nullptr;
+        presented_.fetch_add(1, std::memory_order_relaxed);
+        if (tel_) tel_->framesPresented.fetch_add(1, std::memory_order_relaxed);
+        if (firstFrameFromUs_ >= 0) {
+            if (tel_) tel_->seekFirstFrameUs.record(nowUs - firstFrameFromUs_);
+            firstFrameFromUs_ = -1;
+        }
+        if (ttffFromUs_.load(std::memory_order_relaxed) >= 0) {
+            const int64_t fromUs = ttffFromUs_.exchange(-1, std::memory_order_relaxed);
+            if (fromUs >= 0 && tel_) tel_->firstFrameUs.record(nowUs - fromUs);
+        }
+        waitUs = 0;
+        return due;
+    }
+}
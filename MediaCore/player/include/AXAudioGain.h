@@ -0,0 +1,81 @@
+// AXPlayerLib/MediaCore/player/include/AXAudioGain.h
+#ifndef AXPLAYERLIB_AXAUDIOGAIN_H
+#define AXPLAYERLIB_AXAUDIOGAIN_H
+
+#pragma once
+#include <cstdint>
+
+/**
+ * 交织 PCM 的逐通道增益（软件音量）。
+ * - 每个通道一个增益，预先展开成与 SIMD 寄存器对齐的“增益图样”（交织周期 = 通道数），
+ *   稳态只做一次乘法：F32 直接乘，S16 用 Q15 定点（NEON vqrdmulh / SSSE3·AVX2 mulhrs）
+ * - 全部增益为 1 时直接返回（不碰数据）
+ * - 增益变化时在 kRampMs 内逐帧线性过渡，避免“拉链噪声”；过渡结束后回到向量稳态
+ * 线程约束：configure/setGains/process 须在同一线程（音频喂料线程）调用。
+ */
+class AXAudioGain {
+public:
+    enum class Format { F32, S16 };
+
+    static constexpr int kMaxChannels = 8;
+    static constexpr int kRampMs = 10;
+
+    // 通道数超过 kMaxChannels 时返回 false（process 变为直通）
+    bool configure(Format fmt, int channels, int sampleRate);
+
+    // 设置目标增益（0~1）；n 少于通道数时其余通道取已给出增益的最大值
+    void setGains(const float *gains, int n);
+
+    // 左右声道音量；其余通道（中置/环绕/LFE）取 max(l, r)
+    void setStereoVolume(float left, float right);
+
+    // 原地处理 frames 帧
+    void process(void *data, int frames);
+
+    bool isUnity() const { return unity_ && rampLeft_ == 0; }
+
+    // 当前生效的 SIMD 实现名（日志用）
+    static const char *isaName();
+
+private:
+    void rebuildPatterns_();
+    void rampFrames_(uint8_t *data, int frames);
+
+    Format fmt_{Format::F32};
+    int ch_{0};
+    int rampLen_{0};
+
+    float cur_[kMaxChannels]{1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f};
+    float target_[kMaxChannels]{1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f};
+    float step_[kMaxChannels]{};
+    int rampLeft_{0};
+    bool unity_{true};
+
+    // 稳态增益图样：F32 覆盖 8 帧（AVX2 一个周期），S16 覆盖 16 帧
+    alignas(32) float patF32_[kMaxChannels * 8]{};
+    alignas(32) int16_t patQ15_[kMaxChannels * 16]{};
+};
+
+// 稳态内核（供 AXAudioGain 与基准程序使用）。n 为样本总数（帧数 × 通道数），
+// pat 为上面的增益图样：pat[i] = gain[i % ch]
+namespace axgain {
+    enum class Isa { Scalar, Neon, Sse, Avx2 };
+
+    struct Kernels {
+        Isa isa;
+        const char *name;
+        void (*f32)(float *p, int64_t n, int ch, const float *pat);
+        void (*s16)(int16_t *p, int64_t n, int ch, const int16_t *pat);
+    };
+
+    // 指定实现；当前 CPU/编译目标不支持时返回 nullptr
+    const Kernels *kernelsFor(Isa isa);
+
+    // 运行时选出的最快实现（首次调用时探测）
+    const Kernels &best();
+
+    // Q15 增益：round(g * 32768)，上限 32767
+    int16_t toQ15(float g);
+}
+
+#endif //AXPLAYERLIB_AXAUDIOGAIN_H
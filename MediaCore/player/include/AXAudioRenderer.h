@@ -6,10 +6,15 @@
 
 #include <atomic>
 #include <cstdint>
-#include <jni.h>
-#include <android/native_window.h>
+#include <memory>
+#include <vector>
 
+#include "AXPlatform.h"
 #include "AXQueues.h"  // PacketQueue/FrameQueue、BoundedQueue
+#include "AXPcmFifo.h"
+#include "AXAudioGain.h"
+#include "AXAudioSink.h"
+#include "AXTelemetry.h"
 
 #define AX_LOG_TAG "AXAudioRenderer"
 
@@ -25,14 +30,14 @@ extern "C" {
 
 
 /**
- * 音频渲染器（Oboe 后端，AAudio 优先）。
+ * 音频渲染器（输出经 AXAudioSink：Android 默认 Oboe，主机默认假 DAC）。
  * - 从 FrameQueue 取 AVFrame
  * - libswresample 统一到设备支持的 PCM（优先 F32、否则 S16；采样率用设备 nativeRate）
  * - 可选 SoundTouch 做倍速时伸不变调
- * - Oboe 数据回调从 FIFO 取样本送声卡
+ * - sink 线程经 onPull 从 FIFO 取样本送声卡
  * - 以音频播放头为“主时钟”（若音频活跃）
  */
-class AXAudioRenderer {
+class AXAudioRenderer : private AXAudioSink::Source {
 public:
     AXAudioRenderer();
 
@@ -47,14 +52,31 @@ public:
 
     void pause(bool on);
 
+    // 起播前预填（prepare 阶段，init 之后）：输出流保持运行但只写静音，FIFO 照常由 renderOnce 填到水位；
+    // start 时 pause(false) 放行，第一次回调就拿到真实样本（不等设备重启、不等首轮喂料）
+    void hold();
+
     void stop();     // 停止并释放底层输出
     void release();  // 等价 stop + 释放一切缓存
 
+    // seek 后调用（任意线程）：清空 FIFO 与播放头，输出流保持打开；
+    // swr/SoundTouch 的内部残留由喂料线程在下次 renderOnce 时丢弃
+    void flush();
+
+    // 静音（任意线程）：输出流不停，回调只写静音；喂料线程把取到的帧直接丢掉，不推进音频时钟。拖动预览时使用
+    void setMuted(bool on);
+
     // ------- 输入与配置 -------
+    // 输出设备工厂（init 前设置；为空时用 axCreateDefaultAudioSink）
+    void setSinkFactory(AXAudioSinkFactory f) { sinkFactory_ = std::move(f); }
+
     void setFrameQueue(FrameQueue *q) { frmQ_ = q; }
 
     void setTimeBase(AVRational tb) { tb_ = tb; }
 
+    // 遥测（可为空）：欠载次数、FIFO 深度
+    void setTelemetry(AXTelemetry *t) { tel_ = t; }
+
     void setSpeed(float spd);   // 0.25~4.0（SoundTouch）
     void setVolume(float left, float right); // 0.0~1.0
 
@@ -63,6 +85,10 @@ public:
     // 返回：本次是否实际写入了数据（用于缓冲状态估算）
     bool renderOnce(int64_t /*masterClockUs*/);
 
+    // FIFO 还能撑多久才跌破低水位（微秒，按设备实时）：0 表示现在就需要喂数据，
+    // -1 表示输出未启动（无需调度）
+    int64_t feedDelayUs() const;
+
     // ------- 时钟/状态 -------
     // 若音频活跃，返回播放头对应的媒体 PTS（微秒）；否则返回 <0
     int64_t lastRenderedPtsUs() const;
@@ -81,45 +107,32 @@ public:
 
 private:
     // ============ 内部类型 ============
-    struct PcmChunk {
-        // 交织 PCM 数据（F32 或 S16）
-        std::vector<uint8_t> bytes;
-        int32_t frames = 0;  // 帧数（每帧 = channels 样本）
-        int64_t ptsUs = -1; // 此块首样本对应的媒体 PTS（用于建立基准）
-    };
-
-    // 单生产者/单消费者安全队列（供 Oboe 回调线程消费）
-    class PcmFifo {
-    public:
-        explicit PcmFifo(size_t maxFrames = 48000 * 2); // 默认~2秒上限（按48k、单声道计）
-        void clear();
+    // SoundTouch 时伸（倍速不变调）
+    class TimeStretch;
 
-        // 写入全部拷贝；当 FIFO 满时丢尾部并告警（防止阻塞）
-        void push(const PcmChunk &c);
+    // 目标 FIFO 水位（AAudio 60~120ms；OpenSL 100~200ms）
+    static constexpr int64_t kFifoLowUs = 80'000;
+    static constexpr int64_t kFifoHighUs = 160'000;
 
-        // 读出指定帧数到目标缓冲，不足则填 0；返回实际填充帧数与对齐的首帧 PTS
-        int32_t popInterleaved(void *dst, int32_t frames, int32_t bytesPerFrame, int64_t &outPtsUs);
+    // ============ 内部方法 ============
+    // AXAudioSink::Source（sink 线程）
+    int32_t onPull(void *dst, int32_t frames, int64_t devPos) override;
 
-        // 当前累计帧数
-        int64_t framesAvailable() const;
+    void onSinkError() override;
 
-        // 估算 FIFO 对应时长（微秒）
-        int64_t durationUs(int sampleRate) const;
+    // 播放头 → 媒体 PTS（微秒）；gen 带回计算时的锚点代次（交给 publishClock_ 复查）
+    bool getClockUs_(int64_t &outPtsUs, uint32_t &gen);
 
-    private:
-        mutable std::mutex m_;
-        std::deque<PcmChunk> q_;
-        size_t capFrames_;
-        int64_t framesSum_ = 0;
-    };
+    // 写 lastPtsUs_/active_；写完发现代次已变则撤回
+    void publishClock_(int64_t clkUs, uint32_t gen);
 
-    // Oboe 后端（数据回调从 FIFO 拉取）
-    class OboeSink;
+    // 仅 sink 线程
+    void publishAnchor_(int64_t devPos, int64_t ptsUs, float speed, uint32_t gen);
 
-    // ============ 内部方法 ============
-    bool openSink_();
+    bool loadAnchor_(int64_t &devPos, int64_t &ptsUs, float &speed, uint32_t &gen) const;
 
-    void closeSink_();
+    // 任意线程：作废当前锚点，由下次回调按新数据重建
+    void requestAnchorReset_() { anchorResetReq_.fetch_add(1, std::memory_order_seq_cst); }
 
     // 准备/复用 swresample：源->目标（outFormat_/outRate_/outChannels_/layout）
     bool ensureSwrForFrame_(const AVFrame *frm);
@@ -127,14 +140,27 @@ private:
     // 源 AVFrame → 目标 PCM（交织），并写入 FIFO（必要时走 SoundTouch）
     bool convertAndQueue_(const AVFrame *frm);
 
+    bool stretchAndQueue_(const AVFrame *frm, int64_t ptsUs, float speed);
+
+    int drainStretch_();
+
+    void applyGain_(const AXPcmFifo::Region &r, int frames);
+
+    void logCopyStats_();
+
     // 统计/状态维护
     void resetClock_();
 
+    // 喂料线程：丢掉 swr / SoundTouch 内部尚未输出的样本
+    void dropConverterState_();
+
 private:
     // 输入
     FrameQueue *frmQ_{nullptr};
     AVRational tb_{1, 1000};
     std::atomic<bool> paused_{false};
+    std::atomic<bool> muted_{false};
+    std::atomic<bool> flushReq_{false};   // 喂料线程侧的残留待丢弃
     // 输出协商结果（打开设备后确定）
     int outRate_{48000};
     int outChannels_{2};
@@ -147,29 +173,44 @@ private:
     AVChannelLayout inChLayout_{};
     int inRate_{0};
 
-    // 倍速
-    float speed_{1.0f};
-    bool stInited_{false};
+    // 倍速（任意线程写目标值，喂料线程切换 tempo）
+    std::atomic<float> speed_{1.0f};
     // 为减少依赖震荡，这里不直接包含 soundtouch 头；在 cpp 里做可选集成
-
-    // FIFO & Sink
-    PcmFifo fifo_;
-    std::unique_ptr<OboeSink> sink_;
+    std::unique_ptr<TimeStretch> stretch_;
+    std::vector<uint8_t> stretchIn_;   // swr → SoundTouch 的输入暂存（只增不减）
+    int64_t stInEndUs_{-1};            // 已送入 SoundTouch 的输入末端媒体时间
+
+    // FIFO & Sink（FIFO 在 sink 打开后、启动前按设备参数分配）
+    AXPcmFifo fifo_;
+    AXAudioSinkFactory sinkFactory_;
+    std::unique_ptr<AXAudioSink> sink_;
+    std::atomic<bool> sinkStarted_{false};
+
+    // 播放头锚点（seqlock：只有 sink 线程写，喂料/查询线程读）
+    std::atomic<uint32_t> anchorSeq_{0};
+    std::atomic<int64_t> anchorPos_{0};
+    std::atomic<int64_t> anchorPts_{-1};
+    std::atomic<float> anchorSpeed_{1.f};
+    std::atomic<uint32_t> anchorGen_{0};       // 发布时的作废代次
+    std::atomic<uint32_t> anchorResetReq_{0};  // 作废代次（任意线程 requestAnchorReset_ 推进）
 
     // 音频主时钟（来自 sink 的播放头）
     std::atomic<bool> active_{false};
     std::atomic<int64_t> lastPtsUs_{-1};
 
-    // 基准：第一帧播放的媒体 PTS 与设备 framePos 对齐
-    std::atomic<int64_t> basePtsUs_{-1};
-
-    // 音量
-    float volL_{1.0f}, volR_{1.0f};
+    // 音量（任意线程写目标值，喂料线程经 gain_ 应用）
+    std::atomic<float> volL_{1.0f}, volR_{1.0f};
+    AXAudioGain gain_;
 
     // 日志辅助
+    AXTelemetry *tel_{nullptr};
     std::atomic<int> underrunCnt_{0};
     std::atomic<int> overflowCnt_{0};
 
+    // 拷贝统计（release 时按“每秒音频”打印）
+    std::atomic<int64_t> pcmFramesQueued_{0};   // 写入 FIFO 的帧数
+    std::atomic<int64_t> pcmBytesToDevice_{0};  // 回调从 FIFO 拷给设备的字节
+
     // 全局 JavaVM
     static JavaVM *sVm;
 };
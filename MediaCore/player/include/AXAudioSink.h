@@ -0,0 +1,80 @@
+// AXPlayerLib/MediaCore/player/include/AXAudioSink.h
+#ifndef AXPLAYERLIB_AXAUDIOSINK_H
+#define AXPLAYERLIB_AXAUDIOSINK_H
+
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+/**
+ * 音频输出设备抽象（拉模式）。
+ * - open() 协商最终参数但不启动数据回调；上层据 params() 分配 FIFO 后再 start()
+ * - 设备在自己的线程（Oboe 实时回调 / 主机 sink 的输出线程）里调用 Source::onPull 取数据，
+ *   onPull 必须无锁、无分配
+ * - getTimestamp 给出“已呈现到第几帧 + 对应的 CLOCK_MONOTONIC 时间”，音频时钟据此外推
+ * 实现：Oboe（Android）、null / WAV 文件 / 按墙钟节拍的假 DAC（主机构建与 CI 基准）。
+ */
+class AXAudioSink {
+public:
+    struct Params {
+        int sampleRate{48000};
+        int channels{2};
+        bool isFloat{true};       // F32，否则 S16
+        int framesPerBurst{192};
+    };
+
+    class Source {
+    public:
+        virtual ~Source() = default;
+
+        // 填满 dst 的 frames 帧（不足补静音），返回其中真实数据的帧数。
+        // devPos：本批首帧的设备帧序号（与 getTimestamp 的 framePos 同一计数）
+        virtual int32_t onPull(void *dst, int32_t frames, int64_t devPos) = 0;
+
+        // 设备异常断开（耳机拔出、路由变化等）
+        virtual void onSinkError() {}
+    };
+
+    virtual ~AXAudioSink() = default;
+
+    virtual const char *name() const = 0;
+
+    // 打开设备并协商参数（不启动回调）
+    virtual bool open(Source *src) = 0;
+
+    virtual const Params &params() const = 0;
+
+    // 开始/暂停拉数据（可反复调用）
+    virtual bool start() = 0;
+
+    virtual void stop() = 0;
+
+    virtual void close() = 0;
+
+    // 设备播放头：framePos 帧在 timeNs（CLOCK_MONOTONIC）时被呈现
+    virtual bool getTimestamp(int64_t &framePos, int64_t &timeNs) = 0;
+};
+
+using AXAudioSinkFactory = std::function<std::unique_ptr<AXAudioSink>()>;
+
+// ---------------- 工厂 ----------------
+// 平台默认：Android 为 Oboe（未启用 AX_WITH_OBOE 时返回空），主机为假 DAC
+std::unique_ptr<AXAudioSink> axCreateDefaultAudioSink();
+
+#if defined(AX_WITH_OBOE)
+std::unique_ptr<AXAudioSink> axCreateOboeSink();
+#endif
+
+// 丢弃数据、不限速：有数据就取（流水线吞吐基准）
+std::unique_ptr<AXAudioSink> axCreateNullAudioSink(const AXAudioSink::Params &p = {});
+
+// 写 WAV 文件；paced=false 时不限速
+std::unique_ptr<AXAudioSink> axCreateWavAudioSink(const std::string &path, const AXAudioSink::Params &p = {},
+                                                  bool paced = false);
+
+// 丢弃数据，按墙钟每 framesPerBurst 帧拉一次（模拟真实设备节拍）
+std::unique_ptr<AXAudioSink> axCreateFakeDacAudioSink(const AXAudioSink::Params &p = {});
+
+#endif //AXPLAYERLIB_AXAUDIOSINK_H
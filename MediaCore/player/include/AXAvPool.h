@@ -0,0 +1,107 @@
+// AXPlayerLib/MediaCore/player/include/AXAvPool.h
+#ifndef AXPLAYERLIB_AXAVPOOL_H
+#define AXPLAYERLIB_AXAVPOOL_H
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavutil/frame.h>
+#include <libavutil/buffer.h>
+#include <libavutil/pixfmt.h>
+}
+
+/**
+ * AVFrame / AVPacket “壳对象”回收池（进程级）。
+ * - 播放稳态下，解码线程取壳、渲染线程还壳，壳本身不再反复 malloc/free
+ * - 还回来的壳先 unref（数据缓冲回到各自的 AVBufferPool），超过上限才真正释放
+ * - 计数器用于证明稳态零分配：allocs 只在启动/扩容阶段增长，之后只有 reuses 增长
+ */
+class AXAvPool {
+public:
+    struct Stats {
+        int64_t frameAllocs{0};
+        int64_t frameReuses{0};
+        int64_t packetAllocs{0};
+        int64_t packetReuses{0};
+        int64_t imageBufAllocs{0};  // AXVideoBufferPool 实际分配的平面缓冲数
+        int64_t imageBufGets{0};    // AXVideoBufferPool 出借次数
+    };
+
+    static AXAvPool& instance();
+
+    AVFrame*  acquireFrame();
+    void      releaseFrame(AVFrame* f);
+    AVPacket* acquirePacket();
+    void      releasePacket(AVPacket* p);
+
+    Stats stats() const;
+    void  logStats(const char* where) const;
+
+    void countImageBufAlloc() { imageBufAllocs_.fetch_add(1, std::memory_order_relaxed); }
+    void countImageBufGet()   { imageBufGets_.fetch_add(1, std::memory_order_relaxed); }
+
+private:
+    AXAvPool();
+    ~AXAvPool();
+    AXAvPool(const AXAvPool&) = delete;
+    AXAvPool& operator=(const AXAvPool&) = delete;
+
+    static constexpr size_t kMaxKeep = 512;   // 每类最多缓存的空壳数
+
+    std::mutex fm_;
+    std::vector<AVFrame*> frames_;
+    std::mutex pm_;
+    std::vector<AVPacket*> packets_;
+
+    std::atomic<int64_t> frameAllocs_{0}, frameReuses_{0};
+    std::atomic<int64_t> packetAllocs_{0}, packetReuses_{0};
+    std::atomic<int64_t> imageBufAllocs_{0}, imageBufGets_{0};
+};
+
+// 与 av_frame_alloc/av_frame_free、av_packet_alloc/av_packet_free 对应的池化版本
+inline AVFrame* axFrameAlloc() { return AXAvPool::instance().acquireFrame(); }
+inline void axFrameFree(AVFrame** f) {
+    if (f && *f) { AXAvPool::instance().releaseFrame(*f); *f = nullptr; }
+}
+inline AVPacket* axPacketAlloc() { return AXAvPool::instance().acquirePacket(); }
+inline void axPacketFree(AVPacket** p) {
+    if (p && *p) { AXAvPool::instance().releasePacket(*p); *p = nullptr; }
+}
+
+/**
+ * 视频图像缓冲池：接管 AVCodecContext::get_buffer2。
+ * 按“分辨率 + 像素格式”为每个平面建一个 AVBufferPool，尺寸变化时重建；
+ * 旧池在最后一个缓冲归还后由 FFmpeg 自行销毁。硬解/调色板等格式回退默认实现。
+ */
+class AXVideoBufferPool {
+public:
+    AXVideoBufferPool() = default;
+    ~AXVideoBufferPool();
+
+    // 设置 ctx->opaque / ctx->get_buffer2，须在 avcodec_open2 之前调用
+    void install(AVCodecContext* ctx);
+
+    // 直接为 frm 从池中分配 w*h/fmt 的图像（frm 需为空帧）；alignCtx 可为空
+    bool allocFrame(AVFrame* frm, int w, int h, AVPixelFormat fmt, AVCodecContext* alignCtx);
+
+    static int getBuffer2(AVCodecContext* ctx, AVFrame* frm, int flags);
+
+private:
+    bool ensurePools_(int w, int h, AVPixelFormat fmt, AVCodecContext* alignCtx);
+    void releasePools_();
+    static AVBufferRef* poolAlloc_(void* opaque, size_t size);
+
+    std::mutex m_;
+    int w_{0}, h_{0};
+    AVPixelFormat fmt_{AV_PIX_FMT_NONE};
+    int planes_{0};
+    int linesize_[4]{};
+    AVBufferPool* pools_[4]{};
+};
+
+#endif //AXPLAYERLIB_AXAVPOOL_H
@@ -0,0 +1,44 @@
+// AXPlayerLib/MediaCore/player/include/AXColorMatrix.h
+#ifndef AXPLAYERLIB_AXCOLORMATRIX_H
+#define AXPLAYERLIB_AXCOLORMATRIX_H
+
+#pragma once
+#include <cstdint>
+
+/**
+ * YUV → RGB 矩阵：按帧的 colorspace / color_range / 位深选系数与偏移。
+ * 输入是归一化到 [0,1] 的样本（8 位纹理 v/255，10 位 v/1023），输出 RGB [0,1]：
+ *     rgb = mat * (yuv - offset)
+ * mat 为列主序 3x3，可直接交给 glUniformMatrix3fv；渲染器与 CPU 参考实现共用同一组数。
+ */
+struct AXColorMatrix {
+    float mat[9]{};      // 列主序：mat[col * 3 + row]
+    float offset[3]{};   // Y、Cb、Cr 的零点（归一化）
+
+    // 解析后的参数（AVColorSpace / AVColorRange / 位深），便于日志与比对
+    int colorspace{0};
+    int range{0};
+    int bitDepth{8};
+
+    // CPU 参考：归一化样本 → RGB（未截断）
+    void apply(float y, float u, float v, float rgb[3]) const;
+
+    // CPU 参考：bitDepth 位整数样本 → 8 位 RGB（四舍五入并截断到 [0,255]）
+    void toRgb8(int y, int u, int v, uint8_t rgb[3]) const;
+};
+
+// 未指定/不适用的 colorspace 按画面高度推断（>= 720 行按 BT.709，否则 BT.601），返回 AVColorSpace
+int axResolveColorSpace(int colorspace, int height);
+
+// 未指定的 range：YUVJ 像素格式为全范围，其余按有限范围，返回 AVColorRange
+int axResolveColorRange(int range, bool jpegPixFmt);
+
+// 由已解析的参数构造矩阵；colorspace 不认识时按 BT.601 并返回 false
+bool axColorMatrixFor(int colorspace, int range, int bitDepth, AXColorMatrix& out);
+
+// 三元组的紧凑键：渲染器据此判断是否需要重传 uniform
+static inline uint32_t axColorMatrixKey(int colorspace, int range, int bitDepth) {
+    return ((uint32_t) colorspace & 0xffu) | (((uint32_t) range & 0xffu) << 8) | (((uint32_t) bitDepth & 0xffu) << 16);
+}
+
+#endif //AXPLAYERLIB_AXCOLORMATRIX_H
@@ -6,6 +6,10 @@
 
 #pragma once
 #include "AXQueues.h"
+#include "AXAvPool.h"
+#include "AXTelemetry.h"
+#include "AXFrameConverter.h"
+#include <memory>
 #include <thread>
 
 #include "AXLog.h"
@@ -25,24 +29,58 @@ public:
     bool open(AVCodecParameters* par, AVRational timeBase, bool isVideo);
     void setPacketQueue(PacketQueue* q) { pktQ_ = q; }
     void setFrameQueue(FrameQueue* q) { frmQ_ = q; }
+    void setTelemetry(AXTelemetry* t) { tel_ = t; }
+    // 视频输出能直接呈现的像素格式判定（nullptr = 全部直通）；其余格式在本线程转成 I420 再入队。须在 start 前设置
+    void setRenderableCheck(bool (*renderable)(int pixFmt));
+    // 精确 seek：丢弃结束时刻不晚于 targetUs 的帧（不转换、不入队），直到第一帧越过目标后自动关闭；
+    // targetUs < 0 关闭。任意线程，在 flush 之后、demux seek 之前调用：目标绑定在调用时的包序号上，
+    // 只有 demux seek 推进序号之后解出的帧才可能关闭它
+    void setDiscardBefore(int64_t targetUs);
+    // 只解关键帧（拖动预览）：非关键包在送解码器前丢弃，并设 skip_frame = AVDISCARD_NONKEY；
+    // 每个关键帧单独冲刷输出，不受帧线程的出帧延迟影响。任意线程，下一个包生效
+    void setKeyframeOnly(bool on) { keyOnly_.store(on, std::memory_order_release); }
     void start();
     void stop();
+    // 任意线程：清空包/帧队列并推进包序号。解码器内部缓冲不在这里动（与解码线程的 send/receive 并发不安全），
+    // 由解码线程取到新序号的首包时自行冲刷
     void flush();
 
     AVRational timeBase() const { return tb_; }
     AVCodecContext* ctx() const { return ctx_; }
     bool isVideo() const { return isVideo_; }
+    // 已收到 EOF 空包并把剩余帧全部送入帧队列（解码线程停下等 seek 之后的新包）
+    bool isEof() const { return eof_.load(std::memory_order_acquire); }
 
 private:
     void loop_();
+    bool receiveFrames_(AVFrame* frame, bool draining);
     bool safePushFrame_(AVFrame* frm);
+    AVFrame* convertIfNeeded_(AVFrame* frm);
+    bool discardForSeek_(const AVFrame* frm);
+    void applyKeyframeOnly_();
+    bool decodeKeyframe_(AVPacket* pkt, AVFrame* frame);
+    int64_t frameDurationUs_(const AVFrame* frm) const;
 
     AVCodecContext* ctx_{nullptr};
+    std::unique_ptr<AXVideoBufferPool> bufPool_;   // 须晚于 ctx_ 释放（ctx_->opaque 指向它）
     AVRational tb_{1,1000};
     PacketQueue* pktQ_{nullptr};
     FrameQueue*  frmQ_{nullptr};
+    AXTelemetry* tel_{nullptr};
+    bool (*renderable_)(int){nullptr};
+    std::unique_ptr<AXFrameConverter> conv_;   // 按需创建，仅解码线程使用
+    int lastConvFmt_{-1};                      // 只在格式变化时打一次日志
+    std::atomic<int64_t> discardBeforeUs_{-1};   // 精确 seek 目标（微秒），-1 = 不丢
+    std::atomic<int64_t> discardArmedUs_{0};     // 设目标的时刻，只用于日志
+    std::atomic<uint32_t> discardSerial_{0};     // 设目标时的包序号：不比它新的帧都属于 seek 之前
+    int64_t discarded_{0};                       // 本次 seek 已丢弃的帧数（仅解码线程）
+    std::atomic<bool> keyOnly_{false};
+    bool keyOnlyApplied_{false};                 // 已同步到 ctx_ 的状态（仅解码线程）
+    int64_t codecUs_{0};   // 本包 send + receive 的解码器耗时（仅解码线程）
+    uint32_t serial_{0};   // 当前送进解码器的包序号，输出帧带上它（仅解码线程）
     std::thread th_;
     std::atomic<bool> abort_{false};
+    std::atomic<bool> eof_{false};
     bool isVideo_{false};
 
 };
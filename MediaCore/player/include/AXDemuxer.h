@@ -6,7 +6,10 @@
 #include <map>
 #include <thread>
 #include <atomic>
+#include <mutex>
+#include <condition_variable>
 #include "AXQueues.h"
+#include "AXTelemetry.h"
 
 #define AX_LOG_TAG "AXDemuxer"
 #include "AXLog.h"
@@ -15,6 +18,26 @@ extern "C" {
 #include <libavformat/avformat.h>
 }
 
+// 打开/探测参数（open 之前设置），全部缺省即 FFmpeg 默认行为
+struct AXOpenOptions {
+    int64_t probeSize{0};           // 探测最多读多少字节（probesize），<=0 用 FFmpeg 默认 5MB
+    int64_t analyzeDurationUs{0};   // find_stream_info 最多分析多长媒体时间（analyzeduration），<=0 默认 5s
+    bool fastOpen{false};           // MP4/MKV 等容器头已给全编解码参数时跳过 find_stream_info
+    std::string cacheDir;           // 探测结果磁盘缓存目录（见 AXStreamInfoCache），空 = 不缓存
+};
+
+// open 的耗时拆分（微秒）
+struct AXOpenTiming {
+    enum class Probe {
+        Full,     // avformat_find_stream_info
+        Fast,     // 容器头已够用，跳过探测
+        Cached,   // 从磁盘缓存回填
+    };
+    int64_t openInputUs{0};   // avformat_open_input（连接 + 读容器头）
+    int64_t probeUs{0};       // find_stream_info 或缓存回填
+    Probe probe{Probe::Full};
+};
+
 struct DemuxResult {
     int audioStream{-1};
     int videoStream{-1};
@@ -30,29 +53,61 @@ public:
     AXDemuxer();
     ~AXDemuxer();
 
+    // 须在 open 之前设置
+    void setOpenOptions(const AXOpenOptions& o) { openOpts_ = o; }
     bool open(const std::string& url, const std::map<std::string, std::string>& headers, DemuxResult& out);
+    // 最近一次 open 的耗时拆分
+    const AXOpenTiming& openTiming() const { return timing_; }
+    static const char* probeName(AXOpenTiming::Probe p);
     void start(PacketQueue* aQ, PacketQueue* vQ);
     void stop();
 
-    // pts: 以该 stream 的 time_base 表示
-    bool seek(int streamIndex, int64_t pts);
+    // pts: 以该 stream 的 time_base 表示。默认落在 pts 之前的关键帧；
+    // nearestKey 时取前后最近的关键帧（拖动预览用，容器不支持时退回向前找）。
+    // 任意线程：与读包互斥，推进包队列序号，seek 前读出的包即使晚到队列也会被解码线程丢弃；
+    // 读到 EOF 后停住的读包线程会被唤醒继续读
+    bool seek(int streamIndex, int64_t pts, bool nearestKey = false);
 
     AVFormatContext* fmt() const { return fmt_; }
     AVRational tb(int idx) const { return fmt_ ? fmt_->streams[idx]->time_base : AVRational{1,1000}; }
 
+    // 已读到文件尾（读包线程停在 EOF 等 seek 或 stop，不退出）
     bool isEof() const { return eof_.load(); }
 
+    // 给每个包挂分段时间戳（见 AXStageStamp.h），须在 start 之前设置
+    void setStageStamps(bool on) { stamps_ = on; }
+
+    // 遥测（可为空），须在 start 之前设置
+    void setTelemetry(AXTelemetry* t) { tel_ = t; }
+
+    // 累计读到的包数 / 负载字节（含丢弃流的包）
+    int64_t packetsRead() const { return packetsRead_.load(std::memory_order_relaxed); }
+    int64_t bytesRead() const { return bytesRead_.load(std::memory_order_relaxed); }
+
 private:
+    bool headerSufficient_() const;
     void loop_();
+    void stampPacket_(AVPacket* pkt);
 
     AVFormatContext* fmt_{nullptr};
+    AXOpenOptions openOpts_;
+    AXOpenTiming timing_;
     std::thread th_;
     std::atomic<bool> abort_{false};
     std::atomic<bool> eof_{false};
+    std::mutex ioMtx_;                  // fmt_ 上的读包与 seek 互斥
+    std::condition_variable eofCv_;     // EOF 后等 seek / stop（配 ioMtx_）
+    std::atomic<uint32_t> seekGen_{0};  // 每次 seek +1：跨 seek 读出的包入队前先丢
 
     PacketQueue* aQ_{nullptr};
     PacketQueue* vQ_{nullptr};
     int aIdx_{-1}, vIdx_{-1};
+
+    AXTelemetry* tel_{nullptr};
+    bool stamps_{false};
+    AVBufferPool* stampPool_{nullptr};
+    std::atomic<int64_t> packetsRead_{0};
+    std::atomic<int64_t> bytesRead_{0};
 };
 
 #endif //AXPLAYERLIB_AXDEMUXER_H
\ No newline at end of file
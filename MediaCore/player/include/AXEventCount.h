@@ -0,0 +1,121 @@
+// AXPlayerLib/MediaCore/player/include/AXEventCount.h
+#ifndef AXPLAYERLIB_AXEVENTCOUNT_H
+#define AXPLAYERLIB_AXEVENTCOUNT_H
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#include <thread>
+
+// 自旋等待时让出流水线（x86: pause / ARM: yield）
+static inline void axCpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+// 自旋预算：单核上自旋只会拖慢对端，直接停车
+static inline int axSpinBudget() {
+    static const int kBudget = std::thread::hardware_concurrency() > 1 ? 256 : 0;
+    return kBudget;
+}
+
+/**
+ * 事件计数器（eventcount）：无锁快路径 + futex 停车。
+ * - 通知方：先发布状态，再 notifyAll()；无人等待时只有一次 fence + 一次原子读，不进内核
+ * - 等待方：
+ *     uint32_t key = ec.prepareWait();
+ *     if (条件已满足) { ec.cancelWait(); ... }
+ *     else ec.wait(key);               // 或 waitUntil(key, deadline)
+ *   prepareWait 之后发生的任何 notifyAll 都会让 wait 立即返回，不会丢唤醒。
+ */
+class AXEventCount {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    uint32_t prepareWait() {
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return seq_.load(std::memory_order_seq_cst);
+    }
+
+    void cancelWait() {
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // 阻塞直到被通知（可能虚假唤醒，调用方需循环检查条件）
+    void wait(uint32_t key) {
+        if (seq_.load(std::memory_order_acquire) == key) futexWait_(key, nullptr);
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // 返回 false 表示到达 deadline 仍未收到通知
+    bool waitUntil(uint32_t key, Clock::time_point deadline) {
+        bool notified = true;
+        if (seq_.load(std::memory_order_acquire) == key) {
+            const auto left = deadline - Clock::now();
+            if (left <= Clock::duration::zero()) {
+                notified = false;
+            } else {
+                const int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(left).count();
+                futexWait_(key, &ns);
+                notified = seq_.load(std::memory_order_acquire) != key;
+            }
+        }
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+        return notified;
+    }
+
+    void notifyAll() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters_.load(std::memory_order_relaxed) == 0) return;
+        seq_.fetch_add(1, std::memory_order_seq_cst);
+        futexWake_();
+    }
+
+private:
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word must be 32-bit");
+
+#if defined(__linux__)
+    void futexWait_(uint32_t key, const int64_t* relNs) {
+        timespec ts{};
+        if (relNs) {
+            ts.tv_sec  = (time_t) (*relNs / 1000000000LL);
+            ts.tv_nsec = (long) (*relNs % 1000000000LL);
+        }
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&seq_), FUTEX_WAIT_PRIVATE,
+                key, relNs ? &ts : nullptr, nullptr, 0);
+    }
+
+    void futexWake_() {
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&seq_), FUTEX_WAKE_PRIVATE,
+                INT_MAX, nullptr, nullptr, 0);
+    }
+#else
+    // 非 Linux（仅主机调试用）：短睡眠轮询兜底
+    void futexWait_(uint32_t key, const int64_t* relNs) {
+        const auto until = Clock::now() + std::chrono::nanoseconds(relNs ? *relNs : INT64_MAX / 2);
+        while (seq_.load(std::memory_order_acquire) == key && Clock::now() < until)
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+
+    void futexWake_() {}
+#endif
+
+    std::atomic<uint32_t> seq_{0};
+    std::atomic<uint32_t> waiters_{0};
+};
+
+#endif //AXPLAYERLIB_AXEVENTCOUNT_H
@@ -0,0 +1,51 @@
+// AXPlayerLib/MediaCore/player/include/AXFrameConverter.h
+#ifndef AXPLAYERLIB_AXFRAMECONVERTER_H
+#define AXPLAYERLIB_AXFRAMECONVERTER_H
+
+#pragma once
+#include "AXAvPool.h"
+
+struct SwsContext;
+
+/**
+ * 渲染端不能直接采样的像素格式 → I420 的 CPU 转换（在解码线程上执行，渲染线程只看到 I420）。
+ * 优先走 libyuv（NEON/SSE/AVX2 内核，编译期有 libyuv.h 时启用），libyuv 不认识的格式退回 swscale。
+ * 目标帧的平面缓冲来自自带的 AXVideoBufferPool，稳态下不分配内存。
+ * 非线程安全：一个解码线程一个实例。
+ */
+class AXFrameConverter {
+public:
+    enum class Backend {
+        None = 0,   // 未转换
+        LibYuv,
+        Swscale,
+    };
+
+    AXFrameConverter() = default;
+    ~AXFrameConverter();
+
+    AXFrameConverter(const AXFrameConverter&) = delete;
+    AXFrameConverter& operator=(const AXFrameConverter&) = delete;
+
+    // src → I420 写入空帧壳 dst（同时拷贝时间戳/色彩等属性）；返回所用后端，失败返回 None
+    Backend convert(const AVFrame* src, AVFrame* dst);
+
+    // 指定后端（基准/对比用）；该后端不支持时返回 None
+    Backend convertWith(Backend backend, const AVFrame* src, AVFrame* dst);
+
+    static bool hasLibYuv();
+
+    static bool libyuvSupports(int pixFmt);
+
+    static const char* backendName(Backend b);
+
+private:
+    bool allocI420_(const AVFrame* src, AVFrame* dst);
+    bool libyuv_(const AVFrame* src, AVFrame* dst);
+    bool swscale_(const AVFrame* src, AVFrame* dst);
+
+    AXVideoBufferPool pool_;
+    SwsContext* sws_{nullptr};
+};
+
+#endif //AXPLAYERLIB_AXFRAMECONVERTER_H
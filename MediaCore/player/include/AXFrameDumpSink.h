@@ -0,0 +1,61 @@
+// AXPlayerLib/MediaCore/player/include/AXFrameDumpSink.h
+#ifndef AXPLAYERLIB_AXFRAMEDUMPSINK_H
+#define AXPLAYERLIB_AXFRAMEDUMPSINK_H
+
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+
+#include "AXVideoSink.h"
+
+/**
+ * 离屏视频输出（主机构建 / CI）：不需要窗口，按与 GLES 渲染器相同的时钟窗口“呈现”帧，
+ * 每帧对可见区域的平面数据做 FNV-1a 64 位哈希，并滚动出整段序列哈希，用于回归比对；
+ * 可选把可见平面原样追加写入文件（YUV420P 即 I420，可直接用 ffplay -f rawvideo 查看）。
+ */
+class AXFrameDumpSink : public AXVideoSink {
+public:
+    struct Stats {
+        int64_t frames{0};
+        int64_t dropped{0};
+        int64_t firstPtsUs{-1};
+        int64_t lastPtsUs{-1};
+        uint64_t lastHash{0};
+        uint64_t seqHash{0};
+        int width{0}, height{0};
+        int format{-1};           // AVPixelFormat
+    };
+
+    // yuvPath 为空时只做哈希
+    explicit AXFrameDumpSink(std::string yuvPath = {});
+
+    ~AXFrameDumpSink() override;
+
+    const char *name() const override { return "framedump"; }
+
+    bool init(ANativeWindow *win, int w, int h, int sarNum, int sarDen) override;
+
+    bool needsWindow() const override { return false; }
+
+    int64_t drawLoopOnce(int64_t masterPtsUs) override;
+
+    void release() override;
+
+    Stats stats() const;
+
+    // 单帧可见区域哈希（linesize 对齐填充不计入）；硬件帧返回 0
+    static uint64_t hashFrame(const AVFrame *frm);
+
+private:
+    void present_(const AVFrame *frm);
+
+    std::string yuvPath_;
+    FILE *yuv_{nullptr};
+
+    mutable std::mutex mtx_;
+    Stats st_;
+};
+
+#endif //AXPLAYERLIB_AXFRAMEDUMPSINK_H
@@ -0,0 +1,76 @@
+// AXPlayerLib/MediaCore/player/include/AXFrameScheduler.h
+#ifndef AXPLAYERLIB_AXFRAMESCHEDULER_H
+#define AXPLAYERLIB_AXFRAMESCHEDULER_H
+
+#pragma once
+#include <cstdint>
+
+/**
+ * 视频呈现调度：决定手上的帧“现在呈现 / 再等 / 丢弃”。
+ *   - 从交换完成时刻（eglSwapBuffers 返回）估计显示刷新周期与相位，预测下一个 vsync；
+ *   - 每帧对准离其 PTS 最近的 vsync：PTS 落在“下一 vsync 时的主时钟 ± 半个刷新周期”内即呈现；
+ *   - 下一帧也赶得上同一个 vsync 时当前帧直接丢（一次调用内把一串过期帧丢完）；
+ *   - 各窗口按帧率与倍速自适应（媒体时间 = 墙钟 × 倍速）。
+ * 纯逻辑、不依赖 FFmpeg/GL，时间全部由调用方传入（便于无头模拟，见 bench/bench_present.cpp）。
+ * 非线程安全：只在视频线程使用。
+ */
+class AXFrameScheduler {
+public:
+    enum class Action {
+        Present,   // 现在提交，会在下一个 vsync 上屏
+        Wait,      // 还早：waitUs（媒体时长）后再来
+        Drop,      // 已被更新的帧取代或落后太多
+    };
+
+    struct Decision {
+        Action action{Action::Present};
+        int64_t waitUs{0};
+    };
+
+    static constexpr int64_t kDefaultVsyncUs = 16'667;   // 尚无交换样本时按 60Hz
+    static constexpr int64_t kDefaultFrameUs = 33'333;   // 尚无 PTS 间隔时按 30fps
+
+    // seek / 切换源后调用：PTS 不再连续，只断开帧间隔的相邻关系（两个估计都保留）
+    void reset();
+
+    void setSpeed(float speed) { speed_ = speed > 0.f ? speed : 1.f; }
+
+    // 已知的名义刷新周期（可选）；之后仍由交换时刻细化
+    void setNominalVsyncUs(int64_t us);
+
+    // 每帧从队列取出时调用一次：由相邻 PTS 估计帧间隔
+    void onFrame(int64_t ptsUs);
+
+    // 一次交换完成（墙钟，单调时钟微秒）：更新刷新周期与相位
+    void onPresented(int64_t swapDoneUs);
+
+    // ptsUs / nextPtsUs（未知为 -1）/ masterUs 为媒体时间，nowUs 为墙钟
+    Decision decide(int64_t ptsUs, int64_t nextPtsUs, int64_t masterUs, int64_t nowUs) const;
+
+    // 现在提交能赶上的下一个预测 vsync；没有交换样本时就是 nowUs
+    int64_t nextVsyncUs(int64_t nowUs) const;
+
+    int64_t vsyncUs() const { return vsyncUs_; }
+
+    int64_t frameUs() const { return frameUs_; }
+
+    // 落后超过此值（媒体时长）且没有更新帧可换时也丢：max(4 帧, 6 个 vsync × 倍速)，限制在 [80, 500]ms
+    int64_t lateLimitUs() const;
+
+private:
+    void refineVsync_();
+    int64_t submitLeadUs_() const;
+
+    float speed_{1.f};
+    int64_t vsyncUs_{kDefaultVsyncUs};
+    int64_t lastSwapUs_{-1};
+    // 最近的交换间隔（墙钟微秒），用于求刷新周期
+    static constexpr int kDeltaWindow = 16;
+    int64_t deltas_[kDeltaWindow]{};
+    int deltaIdx_{0};
+    int deltaCount_{0};
+    int64_t frameUs_{kDefaultFrameUs};
+    int64_t lastPtsUs_{-1};
+};
+
+#endif //AXPLAYERLIB_AXFRAMESCHEDULER_H
@@ -2,15 +2,54 @@
 #ifndef AXPLAYERLIB_AXLOG_H
 #define AXPLAYERLIB_AXLOG_H
 
-#include <android/log.h>
-
 // 模块名可以统一用 "AXPlayer"，也可以在不同文件自己传 TAG
 #ifndef AX_LOG_TAG
 #define AX_LOG_TAG "AXPlayer"
 #endif
 
+#if defined(__ANDROID__)
+#include <android/log.h>
+
 #define AX_LOGI(...)  __android_log_print(ANDROID_LOG_INFO,  AX_LOG_TAG, __VA_ARGS__)
 #define AX_LOGW(...)  __android_log_print(ANDROID_LOG_WARN,  AX_LOG_TAG, __VA_ARGS__)
 #define AX_LOGE(...)  __android_log_print(ANDROID_LOG_ERROR, AX_LOG_TAG, __VA_ARGS__)
 
-#endif // AXPLAYERLIB_AXLOG_H
\ No newline at end of file
+#else
+// 主机构建：输出到 stderr（"I/Tag: msg"，一行一次写入）。
+// 环境变量 AX_LOG_LEVEL=I|W|E|N 控制最低级别（默认 I；N 关闭），跑基准时可静音
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+
+inline int axHostLogLevel() {
+    static const int level = [] {
+        const char *e = std::getenv("AX_LOG_LEVEL");
+        if (!e || !*e) return 0;
+        switch (*e) {
+            case 'W': case 'w': return 1;
+            case 'E': case 'e': return 2;
+            case 'N': case 'n': return 3;
+            default: return 0;
+        }
+    }();
+    return level;
+}
+
+__attribute__((format(printf, 3, 4)))
+inline void axHostLog(int level, const char *tag, const char *fmt, ...) {
+    if (level < axHostLogLevel()) return;
+    char msg[1024];
+    va_list ap;
+    va_start(ap, fmt);
+    std::vsnprintf(msg, sizeof(msg), fmt, ap);
+    va_end(ap);
+    std::fprintf(stderr, "%c/%s: %s\n", "IWE"[level], tag, msg);
+}
+
+#define AX_LOGI(...)  axHostLog(0, AX_LOG_TAG, __VA_ARGS__)
+#define AX_LOGW(...)  axHostLog(1, AX_LOG_TAG, __VA_ARGS__)
+#define AX_LOGE(...)  axHostLog(2, AX_LOG_TAG, __VA_ARGS__)
+
+#endif
+
+#endif // AXPLAYERLIB_AXLOG_H
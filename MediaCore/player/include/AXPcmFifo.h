@@ -0,0 +1,109 @@
+// AXPlayerLib/MediaCore/player/include/AXPcmFifo.h
+#ifndef AXPLAYERLIB_AXPCMFIFO_H
+#define AXPLAYERLIB_AXPCMFIFO_H
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+/**
+ * 交织 PCM 的单生产者/单消费者无锁字节环（供 Oboe 实时回调消费）。
+ * - 容量在 configure() 时一次性分配（帧数向上取 2 的幂），读写路径不加锁、不分配
+ * - 读写位置是单调递增的绝对帧号；旁路一条 PTS 标记环 {帧号, PTS, 倍速}，
+ *   消费者读到任意位置都能精确插值出该帧的媒体 PTS（时伸输出每帧对应 speed 帧的媒体时长）
+ * - clear() 可由任意第三方线程调用：只记录“清除点”（clearPos），读写两侧都把
+ *   max(readPos, clearPos) 当作有效读位置，因此不需要与回调线程互斥。
+ *   清除点取“已预留的写入末端”（beginWrite 先发布预留再写），跨过 clear 的那次写入即使随后提交也落在清除点之前，
+ *   读不到；commitWrite 发现 clear 时代（epoch）已变则直接丢弃这段，连 PTS 标记也不发布
+ * 线程约束：configure() 须在两侧都未运行时调用；生产者 begin/commitWrite、write 只能在一个线程；
+ * read 只能在一个线程（实时回调）。
+ */
+class AXPcmFifo {
+public:
+    // 可写区域（环尾回绕时分两段）
+    struct Region {
+        uint8_t* ptr[2]{nullptr, nullptr};
+        int32_t  frames[2]{0, 0};
+    };
+
+    AXPcmFifo() = default;
+    AXPcmFifo(const AXPcmFifo&) = delete;
+    AXPcmFifo& operator=(const AXPcmFifo&) = delete;
+
+    // 非实时线程调用：分配存储并清空。capFrames 至少为 1 个回调周期的数倍
+    bool configure(int32_t capFrames, int32_t bytesPerFrame, int32_t sampleRate);
+
+    // 丢弃全部已写入数据与 PTS 标记，以及正在写入、尚未提交的那一段（任意线程）
+    void clear();
+
+    // clear 次数（生产者据此判断两次写入之间是否被清过）
+    uint64_t epoch() const { return epoch_.load(std::memory_order_acquire); }
+
+    // ---------------- 生产者 ----------------
+    int32_t writableFrames() const;
+
+    // 取最多 maxFrames 帧的可写区域；返回两段帧数之和（0 表示满）
+    int32_t beginWrite(Region& r, int32_t maxFrames);
+
+    // 提交 frames 帧；ptsUs >= 0 时在本段首帧处打一个 PTS 标记。
+    // speed：本段每个输出帧代表的媒体时长倍数（SoundTouch 时伸后的数据为当时的 tempo）。
+    // 返回 false：beginWrite 之后发生过 clear，本段已丢弃
+    bool commitWrite(int32_t frames, int64_t ptsUs, float speed = 1.f);
+
+    // 拷贝写入（放不下时只写能放下的部分）；返回实际写入帧数
+    int32_t write(const void* src, int32_t frames, int64_t ptsUs, float speed = 1.f);
+
+    // ---------------- 消费者（实时回调：无锁、无分配） ----------------
+    // 读 frames 帧到 dst，不足部分补零；返回实际读到的帧数。
+    // firstPtsUs：dst 首帧对应的媒体 PTS（无标记时为 -1）；speed 非空时带回该处标记的倍速
+    int32_t read(void* dst, int32_t frames, int64_t& firstPtsUs, float* speed = nullptr);
+
+    // ---------------- 查询（任意线程） ----------------
+    int64_t framesAvailable() const;
+    int64_t durationUs() const;
+    int32_t bytesPerFrame() const { return bpf_; }
+    int32_t sampleRate() const { return rate_; }
+    int64_t droppedMarkers() const { return droppedMarkers_.load(std::memory_order_relaxed); }
+    int64_t droppedWrites() const { return droppedWrites_.load(std::memory_order_relaxed); }
+
+private:
+    struct Marker {
+        int64_t pos;     // 绝对帧号（该标记对应的首帧）
+        int64_t ptsUs;   // 该帧的媒体 PTS
+        float   speed;   // 之后每帧推进 speed / rate 秒媒体时间
+    };
+    static constexpr size_t kMarkerCap = 512;   // 2 的幂
+
+    int64_t effectiveRead_() const;
+    int64_t ptsAt_(int64_t pos, float& speed);   // 仅消费者
+    void    pushMarker_(int64_t pos, int64_t ptsUs, float speed);
+
+    std::unique_ptr<uint8_t[]> buf_;
+    int64_t capFrames_{0};
+    int64_t mask_{0};
+    int32_t bpf_{0};
+    int32_t rate_{0};
+
+    Marker markers_[kMarkerCap]{};
+
+    // 消费者侧
+    alignas(64) std::atomic<int64_t> readPos_{0};
+    std::atomic<uint64_t> mTail_{0};        // 当前生效的标记下标
+
+    // 生产者侧
+    alignas(64) std::atomic<int64_t> writePos_{0};
+    std::atomic<int64_t> resvEnd_{0};       // 最近一次 beginWrite 预留的末端（>= writePos）
+    std::atomic<uint64_t> mHead_{0};
+    uint64_t writeEpoch_{0};                // beginWrite 时的 epoch（仅生产者）
+
+    // 第三方 clear
+    alignas(64) std::atomic<int64_t> clearPos_{0};
+    std::atomic<uint64_t> mClear_{0};
+    std::atomic<uint64_t> epoch_{0};
+
+    std::atomic<int64_t> droppedMarkers_{0};
+    std::atomic<int64_t> droppedWrites_{0};
+};
+
+#endif //AXPLAYERLIB_AXPCMFIFO_H
@@ -0,0 +1,24 @@
+// AXPlayerLib/MediaCore/player/include/AXPlatform.h
+#ifndef AXPLAYERLIB_AXPLATFORM_H
+#define AXPLAYERLIB_AXPLATFORM_H
+
+#pragma once
+
+/**
+ * 平台差异集中处：Android 直接用 NDK 的 JNI / ANativeWindow；
+ * 主机（Linux）构建只把窗口与 JavaVM 当作不透明指针，窗口引用计数为空操作，
+ * 这样 AXPlayer 及其组件不需要到处写条件编译。
+ */
+#if defined(__ANDROID__)
+#include <jni.h>
+#include <android/native_window.h>
+#else
+struct ANativeWindow;
+struct _JavaVM;
+typedef _JavaVM JavaVM;
+
+static inline void ANativeWindow_acquire(ANativeWindow *) {}
+static inline void ANativeWindow_release(ANativeWindow *) {}
+#endif
+
+#endif //AXPLAYERLIB_AXPLATFORM_H
@@ -9,10 +9,12 @@
 #include <thread>
 #include <mutex>
 #include <condition_variable>
-#include <android/native_window.h>
-#include <jni.h>
+#include "AXPlatform.h"
 #include "AXQueues.h"
 #include "AXAudioRenderer.h"
+#include "AXVideoSink.h"
+#include "AXTelemetry.h"
+#include "AXDemuxer.h"
 
 #define AX_LOG_TAG "AXPlayer"
 #include "AXLog.h"
@@ -21,9 +23,7 @@ extern "C" {
 #include <libavutil/rational.h>
 }
 
-class AXDemuxer;
 class AXDecoder;
-class AXVideoRenderer;
 class AXClock;
 
 // 上层回调接口（与 AXMediaPlayer.java 对应）
@@ -47,21 +47,40 @@ public:
     void prepareAsync();
     void start();
     void pause();
-    void seekTo(int64_t msec);
+    // seek 方式：Accurate 从前一关键帧解码、在解码线程丢掉目标前的帧，首帧即目标位置；
+    // Fast 停在前一关键帧（首帧早于目标，由呈现端按过期帧丢弃）；
+    // Scrub 拖动预览：只解码离目标最近的关键帧并立即显示（暂停中也显示），音频输出不关、静音，
+    //       松手时再以 Accurate/Fast seek 一次恢复正常解码与声音；拖动中调 start() 会自动在当前位置精确 seek 一次；
+    // NearestKey 落在前后最近的关键帧（MediaPlayer 的 SEEK_CLOSEST_SYNC），其余与 Fast 相同
+    enum class SeekMode { Fast, Accurate, Scrub, NearestKey };
+    // 异步：只登记目标并立即返回，由 IO 线程执行；未执行的旧请求被新请求覆盖（只 seek 最后一个）
+    void seekTo(int64_t msec, SeekMode mode = SeekMode::Accurate);
     bool isPlaying();
     void setSpeed(float speed);
+    // 包缓冲水位：maxBytes 为整个播放器的负载字节上限（有音视频时按 1:7 拆给两条包队列），
+    // maxDurationMs 为每条包队列的最长缓冲时长；<=0 表示不限
+    void setBufferLimits(int64_t maxBytes, int64_t maxDurationMs);
+    // 打开/探测参数（探测上限、MP4/MKV 快速打开、探测结果缓存目录），prepareAsync 前设置
+    void setOpenOptions(const AXOpenOptions& o) { openOpts_ = o; }
 
     // 查询
     int64_t getCurrentPositionMs();
     int64_t getDurationMs();
+    int64_t getBufferedDurationMs();   // 已缓冲的可播时长（取音视频包队列中较短者）
     void setVolume(float left, float right);
     int getVideoWidth();
     int getVideoHeight();
     int getVideoSarNum();
     int getVideoSarDen();
     int getAudioSessionId();
+    // 分段遥测快照（任意线程；无锁读取，开销与 prepare 后的播放时长无关）
+    AXPlayerStats getStatistics() const;
     void setWindow(ANativeWindow *window);
 
+    // 输出替换（prepareAsync 前设置）：为空时 Android 用 Oboe + GLES，主机用假 DAC + 帧哈希
+    void setAudioSinkFactory(AXAudioSinkFactory f) { audioSinkFactory_ = std::move(f); }
+    void setVideoSinkFactory(AXVideoSinkFactory f) { videoSinkFactory_ = std::move(f); }
+
     // JavaVM 设置（JNI_OnLoad 中调用）
     static void SetJavaVM(JavaVM *vm);
     static JavaVM *GetJavaVM();
@@ -69,11 +88,24 @@ public:
 private:
     enum class State { IDLE, STOPPED, PREPARING, PREPARED, PLAYING, PAUSED, COMPLETED, ERROR };
 
-    void ioThreadLoop();   // 打开输入、启动 demuxer、创建 decoders
-    void playThreadLoop(); // 渲染驱动与时钟同步
+    void ioThreadLoop();   // 打开输入、创建 decoders、预滚（起读包/解码与渲染线程）；之后处理 seek 请求直到析构
+    bool waitPreroll_();   // 等起播海报上屏、音频 FIFO 预填（有上限），返回是否就绪
+    bool prerollReady_();
+    void seekLoop_();
+    void doSeek_(int64_t msec, SeekMode mode, int64_t reqUs);
+    void endScrub_();
+    void playThreadLoop(); // 位置/缓冲进度/完成判定
+    void videoThreadLoop(); // 视频呈现：按主时钟截止时间调度
+    void audioThreadLoop(); // 音频喂料：保持 PCM FIFO 水位，并用音频播放头校正主时钟
+    int64_t syncClockToAudio_();
+    void waitMediaEvent_(AXEventCount& ev, uint32_t key, int64_t waitUs);
     void changeState(State s);
+    void wakePlay_();      // 让播放线程立即重新调度（状态变化/seek/倍速/窗口）
     void notifyError(int what, int extra, const std::string &msg);
     void stopPipelines_();//有序关闭 demux/decoder/队列
+    void applyBufferLimits_();
+    int64_t bufferedDurationUs_() const;
+    void updateQueueGauges_();
 
 private:
     std::shared_ptr<AXPlayerCallback> cb_;
@@ -81,13 +113,39 @@ private:
 
     std::string source_;
     std::map<std::string, std::string> headers_;
+    AXOpenOptions openOpts_;
 
     // 线程 & 控制
     std::thread ioThread_;
     std::thread playThread_;
+    std::thread videoThread_;
+    std::thread audioThread_;
     std::atomic<bool> abort_{false};
     std::atomic<bool> playing_{false};
 
+    // 播放/视频/音频线程调度：睡到下一截止时间，或被各自的事件提前唤醒
+    AXEventCount playEvent_;
+    AXEventCount videoEvent_;
+    AXEventCount audioEvent_;
+    static constexpr int64_t kPlayMaxWaitUs = 100'000;   // 兜底：位置/时钟/完成判定最长 100ms 刷新一次
+
+    // 预滚：prepare 阶段就起读包/解码，视频线程把首帧画成海报，音频线程把 FIFO 预填到水位（输出只写静音）；
+    // 第一次 start() 时清掉，之后暂停中不再预填
+    std::atomic<bool> prerolling_{false};
+    AXEventCount prerollEvent_;   // 渲染线程每轮预滚后通知，IO 线程在上面等就绪
+    int64_t prepareStartUs_{0};   // prepareAsync 时刻（axStampNowUs），起播 TTFF 的起点
+    static constexpr int64_t kPrerollMaxWaitUs = 1'000'000;   // 慢源不因预滚拖住 prepared
+
+    // seek 请求（seekTo 写，IO 线程取走最新的一个）
+    std::mutex seekMtx_;
+    std::condition_variable seekCv_;
+    int64_t seekReqMs_{-1};   // -1 = 无待处理请求
+    SeekMode seekReqMode_{SeekMode::Accurate};
+    int64_t seekReqUs_{0};    // 最新请求的发起时刻（axStampNowUs）
+    int seekCoalesced_{0};    // 被覆盖而未执行的请求数（日志）
+    std::atomic<bool> scrubbing_{false};   // 最近一次 seek 请求是 Scrub（只解关键帧、静音还开着）
+    std::mutex seekExecMtx_;  // 执行 seek 与“完成后重播”互斥
+
     // 准备完成同步
     std::atomic<bool> prepared_{false};
     std::mutex prepMtx_;
@@ -111,9 +169,10 @@ private:
     std::unique_ptr<AXDemuxer> demux_;
     std::unique_ptr<AXDecoder> aDec_;
     std::unique_ptr<AXDecoder> vDec_;
-    std::unique_ptr<AXVideoRenderer> vRen_;
+    std::unique_ptr<AXVideoSink> vRen_;
     std::unique_ptr<AXAudioRenderer> aRen_;
     std::unique_ptr<AXClock> clock_;
+    AXTelemetry telemetry_;
 
     // 队列
     std::unique_ptr<PacketQueue> aPktQ_;
@@ -121,14 +180,15 @@ private:
     std::unique_ptr<FrameQueue>  aFrmQ_;
     std::unique_ptr<FrameQueue>  vFrmQ_;
 
-    // 队列容量缓存（BoundedQueue 无 capacity()，用我们构造时的参数保存）
-    int aPktCap_{0};
-    int vPktCap_{0};
-    int aFrmCap_{0};
-    int vFrmCap_{0};
+    // 包队列水位（默认 15MB / 10s，与 ffplay 的 MAX_QUEUE_SIZE、MIN_FRAMES 同量级）
+    std::atomic<int64_t> bufMaxBytes_{15 * 1024 * 1024};
+    std::atomic<int64_t> bufMaxDurationUs_{10 * 1000000LL};
+    static constexpr int kBufMinPackets = 25;
 
     // 渲染
     ANativeWindow *window_{nullptr};
+    AXAudioSinkFactory audioSinkFactory_;
+    AXVideoSinkFactory videoSinkFactory_;
 
     // 全局 JavaVM
     static JavaVM *sVm;
@@ -9,28 +9,31 @@
 #include <atomic>
 #include <type_traits>
 #include <chrono>
-#include <android/log.h>
+#include <memory>
+#include <thread>
 
 #define AX_LOG_TAG "AXQueues"
 #include "AXLog.h"
+#include "AXEventCount.h"
+#include "AXAvPool.h"
 
 extern "C" {
-#include <libavcodec/avcodec.h>   // av_packet_free
-#include <libavutil/frame.h>      // av_frame_free
+#include <libavcodec/avcodec.h>
+#include <libavutil/frame.h>
 }
 
-// ---------- 类型专用释放器（C++11 兼容） ----------
+// ---------- 类型专用释放器（C++11 兼容；AV 对象还回 AXAvPool） ----------
 template<typename T>
 struct AvItemReleaser { static inline void free(T&) {} };
 
 template<> struct AvItemReleaser<AVPacket*> {
-    static inline void free(AVPacket*& p){ if (p) av_packet_free(&p); }
+    static inline void free(AVPacket*& p){ if (p) axPacketFree(&p); }
 };
 template<> struct AvItemReleaser<AVFrame*> {
-    static inline void free(AVFrame*& f){ if (f) av_frame_free(&f); }
+    static inline void free(AVFrame*& f){ if (f) axFrameFree(&f); }
 };
 
-// ---------- 有界线程安全队列 ----------
+// ---------- 有界线程安全队列（通用 MPMC，互斥量 + 条件变量） ----------
 template <typename T>
 class BoundedQueue {
 public:
@@ -128,7 +131,365 @@ private:
     std::atomic<bool> aborted_{false};
 };
 
-using PacketQueue = BoundedQueue<AVPacket*>;
-using FrameQueue  = BoundedQueue<AVFrame*>;
+// ---------- 队列计量（默认不计量，只按条数限容） ----------
+template <typename T>
+struct NullQueueMeter {
+    void onPush(const T&) {}
+    void onPop(const T&) {}
+    bool full(size_t /*count*/) const { return false; }
+};
+
+// ---------- 单生产者/单消费者无锁环形队列 ----------
+// 与 BoundedQueue 接口一致（push/pop/tryPop/flush/abort），但：
+// - 固定容量、预分配槽位，头尾索引各占一条 cache line，避免伪共享
+// - 快路径只有 acquire/release 原子操作，不加锁、不 notify_all
+// - 仅在“满/空”时通过 AXEventCount（futex）停车，对端推进后精确唤醒
+// 约束：同一时刻只能有一个生产者线程 push、一个消费者线程 pop/tryPop；
+// flush()/clear() 允许由第三方线程（如 seek 调用方）发起，它们会短暂占用消费者令牌。
+// Meter：可选的计量策略（字节数/时长水位），full() 为真时生产者同样会被阻塞。
+template <typename T, typename Meter = NullQueueMeter<T>>
+class SpscQueue {
+public:
+    explicit SpscQueue(size_t cap) : cap_(cap ? cap : 1), wakeBatch_(cap_ >= 8 ? cap_ / 4 : 1) {
+        size_t slots = 1;
+        while (slots < cap_) slots <<= 1;
+        mask_ = slots - 1;
+        buf_.reset(new T[slots]());
+    }
+    ~SpscQueue() {
+        abort();
+        clear();
+    }
+
+    // 让所有阻塞的 push()/pop() 立即返回 false
+    void abort() {
+        aborted_.store(true, std::memory_order_release);
+        notEmpty_.notifyAll();
+        notFull_.notifyAll();
+    }
+
+    bool isAborted() const { return aborted_.load(std::memory_order_acquire); }
+
+    // 清空并释放内部对象（不会改变 aborted_ 状态，也不唤醒）
+    void clear() {
+        ConsumerToken tk(this);
+        drainLocked_();
+    }
+
+    // 丢弃元素并唤醒被“满”阻塞的生产者（用于 seek 等快速清队）
+    void flush() {
+        {
+            ConsumerToken tk(this);
+            drainLocked_();
+        }
+        notFull_.notifyAll();
+    }
+
+    // 阻塞入队；若 aborted 返回 false（仅生产者线程调用）
+    bool push(T item) {
+        const size_t t = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            if (aborted_.load(std::memory_order_acquire)) return false;
+            if (t - headCache_ < cap_ && !meter_.full(t - headCache_)) break;
+            headCache_ = head_.load(std::memory_order_acquire);
+            if (hasRoom_(t)) break;
+            if (spinUntil_([&] { return hasRoom_(t); }))
+                continue;
+
+            // 满：停车，等消费者腾出空位（或计量水位回落）
+            const uint32_t key = notFull_.prepareWait();
+            if (aborted_.load(std::memory_order_acquire) || hasRoom_(t)) {
+                notFull_.cancelWait();
+                continue;
+            }
+            notFull_.wait(key);
+        }
+        meter_.onPush(item);
+        buf_[t & mask_] = item;
+        tail_.store(t + 1, std::memory_order_release);
+        notEmpty_.notifyAll();   // 内含 seq_cst fence，与 armReadyNotify 配对
+        if (readyEc_ && readyArmed_.load(std::memory_order_relaxed) &&
+            readyArmed_.exchange(false, std::memory_order_acq_rel))
+            readyEc_->notifyAll();
+        return true;
+    }
+
+    // 阻塞出队；若 aborted 返回 false（仅消费者线程调用）
+    bool pop(T& out) {
+        return popImpl_(out, nullptr);
+    }
+
+    // 带超时的出队（常用于渲染/解码线程的柔性退出）
+    template<typename Rep, typename Period>
+    bool tryPop(T& out, const std::chrono::duration<Rep,Period>& timeout) {
+        const AXEventCount::Clock::time_point deadline = AXEventCount::Clock::now() +
+                std::chrono::duration_cast<AXEventCount::Clock::duration>(timeout);
+        return popImpl_(out, &deadline);
+    }
+
+    size_t size() const {
+        const size_t h = head_.load(std::memory_order_acquire);
+        const size_t t = tail_.load(std::memory_order_acquire);
+        const size_t n = t - h;
+        return n > cap_ ? cap_ : n;
+    }
+
+    bool empty() const { return size() == 0; }
+
+    size_t capacity() const { return cap_; }
+
+    // 外部就绪通知：消费者发现“没东西可取”时 armReadyNotify()，下一次 push 会唤醒 ec。
+    // 供同时等待多条队列/多种事件的线程使用；未武装时生产者只多一次 relaxed 读。
+    void setReadyNotifier(AXEventCount* ec) { readyEc_ = ec; }
+    void armReadyNotify() { readyArmed_.store(true, std::memory_order_seq_cst); }
+
+protected:
+    Meter& meter() { return meter_; }
+    const Meter& meter() const { return meter_; }
+
+private:
+    bool hasRoom_(size_t t) const {
+        const size_t n = t - head_.load(std::memory_order_acquire);
+        return n < cap_ && !meter_.full(n);
+    }
+
+    // 消费者令牌：正常情况下只有消费者线程自己持有（无竞争）；
+    // flush/clear 从其它线程调用时借用它，保证“单消费者”不变式
+    struct ConsumerToken {
+        explicit ConsumerToken(SpscQueue* q) : q_(q) {
+            while (q_->consumerBusy_.exchange(true, std::memory_order_acquire))
+                std::this_thread::yield();
+        }
+        ~ConsumerToken() { q_->consumerBusy_.store(false, std::memory_order_release); }
+        SpscQueue* q_;
+    };
+
+    bool tryTake_(T& out) {
+        ConsumerToken tk(this);
+        const size_t h = head_.load(std::memory_order_relaxed);
+        if (h == tailCache_) {
+            tailCache_ = tail_.load(std::memory_order_acquire);
+            if (h == tailCache_) return false;
+        }
+        out = buf_[h & mask_];
+        buf_[h & mask_] = T();
+        meter_.onPop(out);
+        head_.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    void drainLocked_() {
+        size_t h = head_.load(std::memory_order_relaxed);
+        const size_t t = tail_.load(std::memory_order_acquire);
+        while (h != t) {
+            T item = buf_[h & mask_];
+            buf_[h & mask_] = T();
+            ++h;
+            meter_.onPop(item);
+            AvItemReleaser<T>::free(item);
+        }
+        tailCache_ = t;
+        head_.store(h, std::memory_order_release);
+    }
+
+    // 对端通常正在运行：先短暂自旋，避免每个元素都走一次 futex
+    template <typename Pred>
+    bool spinUntil_(Pred ready) const {
+        const int budget = axSpinBudget();
+        for (int i = 0; i < budget; ++i) {
+            if (aborted_.load(std::memory_order_relaxed) || ready()) return true;
+            axCpuRelax();
+        }
+        return false;
+    }
+
+    // 攒够 wakeBatch_ 个空位再唤醒生产者，满队列时不会“取一个醒一次”
+    void wakeProducer_() {
+        const size_t n = tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_relaxed);
+        if (cap_ - (n > cap_ ? cap_ : n) >= wakeBatch_) notFull_.notifyAll();
+    }
+
+    bool popImpl_(T& out, const AXEventCount::Clock::time_point* deadline) {
+        for (;;) {
+            if (aborted_.load(std::memory_order_acquire)) return false;
+            if (tryTake_(out)) {
+                wakeProducer_();
+                return true;
+            }
+            if (spinUntil_([&] { return head_.load(std::memory_order_relaxed) !=
+                                        tail_.load(std::memory_order_acquire); }))
+                continue;
+
+            // 空：停车，等生产者写入
+            const uint32_t key = notEmpty_.prepareWait();
+            if (aborted_.load(std::memory_order_acquire) ||
+                head_.load(std::memory_order_relaxed) != tail_.load(std::memory_order_acquire)) {
+                notEmpty_.cancelWait();
+                continue;
+            }
+            if (!deadline) {
+                notEmpty_.wait(key);
+            } else if (!notEmpty_.waitUntil(key, *deadline)) {
+                // 超时：最后再看一眼，避免与入队擦肩而过
+                if (aborted_.load(std::memory_order_acquire) || !tryTake_(out)) return false;
+                wakeProducer_();
+                return true;
+            }
+        }
+    }
+
+    const size_t cap_;
+    const size_t wakeBatch_;
+    size_t mask_{0};
+    std::unique_ptr<T[]> buf_;
+    std::atomic<bool> aborted_{false};
+    Meter meter_;
+
+    // 消费者侧（head + 对 tail 的本地缓存）
+    alignas(64) std::atomic<size_t> head_{0};
+    size_t tailCache_{0};
+    std::atomic<bool> consumerBusy_{false};
+
+    // 生产者侧（tail + 对 head 的本地缓存）
+    alignas(64) std::atomic<size_t> tail_{0};
+    size_t headCache_{0};
+
+    alignas(64) AXEventCount notEmpty_;
+    alignas(64) AXEventCount notFull_;
+
+    AXEventCount* readyEc_{nullptr};
+    std::atomic<bool> readyArmed_{false};
+};
+
+// ---------- 包队列计量：字节数 + 缓冲时长（类似 ffplay 的 MAX_QUEUE_SIZE / MIN_FRAMES） ----------
+// onPush 在生产者线程、onPop 在消费者线程（或 flush 方）调用，计数器用原子量
+class PacketQueueMeter {
+public:
+    void setTimeBase(AVRational tb) { tb_ = tb; }
+
+    // maxBytes/maxDurationUs <= 0 表示不限；minPackets：时长水位只有在至少缓存这么多包后才生效
+    void setLimits(int64_t maxBytes, int64_t maxDurationUs, int minPackets) {
+        maxBytes_.store(maxBytes, std::memory_order_relaxed);
+        maxDurUs_.store(maxDurationUs, std::memory_order_relaxed);
+        minPackets_.store(minPackets, std::memory_order_relaxed);
+    }
+
+    void onPush(AVPacket* p) {
+        if (!p) return;
+        // 部分容器不给包时长：用相邻包 PTS 差补齐，保证 push/pop 两侧用同一个值
+        // （只接受 1 秒以内的间隔，seek 后的首包不会被算成一段超长时长）
+        if (p->duration <= 0 && p->pts != AV_NOPTS_VALUE && lastPts_ != AV_NOPTS_VALUE && p->pts > lastPts_
+            && av_rescale_q(p->pts - lastPts_, tb_, AVRational{1, 1000000}) <= 1000000)
+            p->duration = p->pts - lastPts_;
+        if (p->pts != AV_NOPTS_VALUE) lastPts_ = p->pts;
+        bytes_.fetch_add(costOf_(p), std::memory_order_relaxed);
+        durUs_.fetch_add(durationUsOf_(p), std::memory_order_relaxed);
+    }
+
+    void onPop(AVPacket* p) {
+        if (!p) return;
+        bytes_.fetch_sub(costOf_(p), std::memory_order_relaxed);
+        durUs_.fetch_sub(durationUsOf_(p), std::memory_order_relaxed);
+    }
+
+    bool full(size_t count) const {
+        const int64_t maxB = maxBytes_.load(std::memory_order_relaxed);
+        if (maxB > 0 && bytes_.load(std::memory_order_relaxed) >= maxB) return true;
+        const int64_t maxD = maxDurUs_.load(std::memory_order_relaxed);
+        return maxD > 0 && (int64_t) count >= minPackets_.load(std::memory_order_relaxed)
+               && durUs_.load(std::memory_order_relaxed) >= maxD;
+    }
+
+    int64_t bytes() const { return bytes_.load(std::memory_order_relaxed); }
+    int64_t durationUs() const {
+        const int64_t d = durUs_.load(std::memory_order_relaxed);
+        return d > 0 ? d : 0;
+    }
+
+private:
+    static int64_t costOf_(const AVPacket* p) { return (int64_t) p->size + (int64_t) sizeof(AVPacket); }
+    int64_t durationUsOf_(const AVPacket* p) const {
+        return p->duration > 0 ? av_rescale_q(p->duration, tb_, AVRational{1, 1000000}) : 0;
+    }
+
+    AVRational tb_{1, 1000};
+    int64_t lastPts_{AV_NOPTS_VALUE};   // 仅生产者线程访问
+    std::atomic<int64_t> bytes_{0};
+    std::atomic<int64_t> durUs_{0};
+    std::atomic<int64_t> maxBytes_{0};
+    std::atomic<int64_t> maxDurUs_{0};
+    std::atomic<int> minPackets_{0};
+};
+
+// 包序号（类似 ffplay 的 serial）：借用 AVPacket::opaque 存放，包还回池时随 unref 清零
+inline uint32_t axPacketSerial(const AVPacket* p) { return (uint32_t) (uintptr_t) p->opaque; }
+inline void axSetPacketSerial(AVPacket* p, uint32_t serial) { p->opaque = (void*) (uintptr_t) serial; }
+
+// 播放管线中四条队列都是“一个生产者线程 + 一个消费者线程”，统一使用 SPSC 环形队列。
+// 包队列额外按字节数/时长限容：高码率流不会囤积数百 MB，低码率音频也能缓存足够秒数。
+class PacketQueue : public SpscQueue<AVPacket*, PacketQueueMeter> {
+public:
+    explicit PacketQueue(size_t cap) : SpscQueue<AVPacket*, PacketQueueMeter>(cap) {}
+
+    // 每次 flush 序号 +1（先于清队）：生产者按读包时的序号给包打标，
+    // 消费者取到序号不等于当前值的包即为 flush 之前读出的旧包，直接丢弃
+    void flush() {
+        serial_.fetch_add(1, std::memory_order_acq_rel);
+        SpscQueue<AVPacket*, PacketQueueMeter>::flush();
+    }
+    uint32_t serial() const { return serial_.load(std::memory_order_acquire); }
+
+    // 必须在第一次 push 之前设置（时长按该时间基换算）
+    void setTimeBase(AVRational tb) { meter().setTimeBase(tb); }
+    void setLimits(int64_t maxBytes, int64_t maxDurationUs, int minPackets) {
+        meter().setLimits(maxBytes, maxDurationUs, minPackets);
+    }
+
+    // 当前缓存的负载字节数（含 AVPacket 结构体开销）与时长（微秒）
+    int64_t bytes() const { return meter().bytes(); }
+    int64_t durationUs() const { return meter().durationUs(); }
+
+private:
+    std::atomic<uint32_t> serial_{0};
+};
+
+// 帧序号：解码线程把产出该帧的包序号写进 AVFrame::opaque
+inline uint32_t axFrameSerial(const AVFrame* f) { return (uint32_t) (uintptr_t) f->opaque; }
+inline void axSetFrameSerial(AVFrame* f, uint32_t serial) { f->opaque = (void*) (uintptr_t) serial; }
+
+// 帧队列：设置了序号来源（对应的包队列）时，取帧自动丢掉序号已过期的帧——
+// 解码线程检查序号之后才发生 seek 的帧、阻塞在满队列里被 flush 放行的帧，都不会被呈现
+class FrameQueue : public SpscQueue<AVFrame*> {
+public:
+    explicit FrameQueue(size_t cap) : SpscQueue<AVFrame*>(cap) {}
+
+    // 须在消费者开始取帧之前设置；nullptr = 不过滤
+    void setSerialSource(const PacketQueue* q) { serialSrc_ = q; }
+
+    bool pop(AVFrame*& out) {
+        for (;;) {
+            if (!SpscQueue<AVFrame*>::pop(out)) return false;
+            if (!stale_(out)) return true;
+            axFrameFree(&out);
+        }
+    }
+
+    // 丢掉过期帧后按同样的超时继续等
+    template<typename Rep, typename Period>
+    bool tryPop(AVFrame*& out, const std::chrono::duration<Rep,Period>& timeout) {
+        for (;;) {
+            if (!SpscQueue<AVFrame*>::tryPop(out, timeout)) return false;
+            if (!stale_(out)) return true;
+            axFrameFree(&out);
+        }
+    }
+
+private:
+    bool stale_(const AVFrame* f) const {
+        return f && serialSrc_ && axFrameSerial(f) != serialSrc_->serial();
+    }
+
+    const PacketQueue* serialSrc_{nullptr};
+};
 
 #endif //AXPLAYERLIB_AXQUEUES_H
\ No newline at end of file
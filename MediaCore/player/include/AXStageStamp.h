@@ -0,0 +1,36 @@
+// AXPlayerLib/MediaCore/player/include/AXStageStamp.h
+#ifndef AXPLAYERLIB_AXSTAGESTAMP_H
+#define AXPLAYERLIB_AXSTAGESTAMP_H
+
+#pragma once
+#include <cstdint>
+#include <ctime>
+
+extern "C" {
+#include <libavutil/buffer.h>
+}
+
+/**
+ * 流水线分段时间戳（基准/诊断用，默认关闭）。
+ * demuxer 读到包时从缓冲池取一块挂到 pkt->opaque_ref 并写 readUs；
+ * 解码器打开了 AV_CODEC_FLAG_COPY_OPAQUE，FFmpeg 会把它带到输出帧的 frame->opaque_ref，
+ * 解码器出帧时补写 decodedUs；消费端（sink / axbench）据此算各段延迟。
+ * 未开启时包上没有 opaque_ref，各环节只多一次空指针判断。
+ */
+struct AXStageStamp {
+    int64_t readUs{-1};      // av_read_frame 返回
+    int64_t decodedUs{-1};   // avcodec_receive_frame 返回
+};
+
+// CLOCK_MONOTONIC 微秒
+static inline int64_t axStampNowUs() {
+    timespec ts{};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t) ts.tv_sec * 1000000LL + ts.tv_nsec / 1000;
+}
+
+static inline AXStageStamp *axStampOf(AVBufferRef *ref) {
+    return (ref && ref->size >= sizeof(AXStageStamp)) ? reinterpret_cast<AXStageStamp *>(ref->data) : nullptr;
+}
+
+#endif //AXPLAYERLIB_AXSTAGESTAMP_H
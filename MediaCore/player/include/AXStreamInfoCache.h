@@ -0,0 +1,38 @@
+// AXPlayerLib/MediaCore/player/include/AXStreamInfoCache.h
+#ifndef AXPLAYERLIB_AXSTREAMINFOCACHE_H
+#define AXPLAYERLIB_AXSTREAMINFOCACHE_H
+
+#pragma once
+#include <string>
+
+struct AVFormatContext;
+
+/**
+ * avformat_find_stream_info 结果的磁盘缓存：同一个源再次打开时直接回填编解码参数，跳过探测。
+ *   - 每个源一个小文本文件（<dir>/<url 哈希>.axsi），内含 URL 与源签名；
+ *   - 签名：本地文件为 大小 + mtime；其它协议为 avio_size（FFmpeg 的 http 协议不暴露 ETag），
+ *     拿不到大小的源（直播、管道）不缓存；
+ *   - 命中条件：签名一致，且 avformat_open_input 建出的流数、类型、codec_id 与缓存一致
+ *     （无头容器打开时还没建流的，自然不命中、回退完整探测）。
+ * 回填只补头里缺的字段（像素格式、色彩、帧率、extradata、时长等），容器已给出的不覆盖。
+ * 线程安全：无共享状态；写入先落临时文件再 rename，多个播放器并发写同一源也不会读到半个文件。
+ */
+class AXStreamInfoCache {
+public:
+    explicit AXStreamInfoCache(std::string dir) : dir_(std::move(dir)) {}
+
+    bool enabled() const { return !dir_.empty(); }
+
+    // 命中则回填 fmt 并返回 true；fmt 须是刚 avformat_open_input 的上下文
+    bool load(const std::string& url, AVFormatContext* fmt) const;
+
+    // 完整探测成功后调用
+    bool store(const std::string& url, const AVFormatContext* fmt) const;
+
+private:
+    std::string pathFor_(const std::string& url) const;
+
+    std::string dir_;
+};
+
+#endif //AXPLAYERLIB_AXSTREAMINFOCACHE_H
@@ -0,0 +1,122 @@
+// AXPlayerLib/MediaCore/player/include/AXTelemetry.h
+#ifndef AXPLAYERLIB_AXTELEMETRY_H
+#define AXPLAYERLIB_AXTELEMETRY_H
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+#include "AXStageStamp.h"   // axStampNowUs
+
+/**
+ * 无锁对数直方图（微秒）：每个 2 的幂区间再 4 等分，相对误差 < 25%，覆盖 0 ~ 2^27us（约 134s）。
+ * record 只做 2 次 relaxed fetch_add（+ 偶发的 max CAS），热路径每样本约几十纳秒；
+ * 读侧 snapshot 不加锁，可能与写入交错，单个样本的误差对统计没有影响。
+ */
+class AXHistogram {
+public:
+    static constexpr int kBuckets = 108;
+
+    struct Snapshot {
+        int64_t count{0};
+        int64_t sum{0};
+        int64_t max{0};
+        uint64_t buckets[kBuckets]{};
+
+        int64_t mean() const { return count > 0 ? sum / count : 0; }
+
+        // q ∈ [0,1]；返回所在桶的上界（不超过 max）
+        int64_t percentile(double q) const;
+    };
+
+    void record(int64_t v) {
+        if (v < 0) v = 0;
+        buckets_[bucketOf(v)].fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(v, std::memory_order_relaxed);
+        int64_t m = max_.load(std::memory_order_relaxed);
+        while (v > m && !max_.compare_exchange_weak(m, v, std::memory_order_relaxed)) {}
+    }
+
+    Snapshot snapshot() const;
+
+    void reset();
+
+    static int bucketOf(int64_t v);
+
+    static int64_t bucketUpper(int idx);
+
+private:
+    std::atomic<uint64_t> buckets_[kBuckets]{};
+    std::atomic<int64_t> sum_{0};
+    std::atomic<int64_t> max_{0};
+};
+
+/**
+ * 单个播放器实例的分段遥测：各组件持有裸指针（可为空 = 不采集），AXPlayer 持有本体。
+ * 直方图由产生事件的线程写入；gauge 由播放线程每轮刷新，读侧只读这里，不碰组件本身。
+ */
+struct AXTelemetry {
+    AXHistogram demuxReadUs;     // av_read_frame 耗时
+    AXHistogram videoDecodeUs;   // 每包 send_packet + receive_frame 耗时
+    AXHistogram audioDecodeUs;
+    AXHistogram presentLateUs;   // 呈现时帧 PTS 落后主时钟的量
+    AXHistogram presentEarlyUs;  // 呈现时帧 PTS 超前主时钟的量
+    AXHistogram uploadUs;        // 纹理上传（CPU 侧提交）
+    AXHistogram audioFifoUs;     // 每次喂料后的 PCM FIFO 深度
+    AXHistogram seekFirstFrameUs;   // 播放中 seek 请求到 seek 后首帧交给视频输出（TTFF）
+    AXHistogram firstFrameUs;       // prepareAsync 到首帧（起播海报）交给视频输出（起播 TTFF，每次 prepare 一个样本）
+
+    std::atomic<int64_t> framesPresented{0};
+    std::atomic<int64_t> framesDropped{0};     // 被同一 vsync 上的更新帧取代，或落后超过丢帧窗口
+    std::atomic<int64_t> audioUnderruns{0};
+
+    // gauge（播放线程刷新）
+    std::atomic<int64_t> audioFifoNowUs{0};
+    std::atomic<int64_t> aPktPackets{0}, aPktBytes{0}, aPktDurUs{0};
+    std::atomic<int64_t> vPktPackets{0}, vPktBytes{0}, vPktDurUs{0};
+    std::atomic<int64_t> aFrames{0}, vFrames{0};
+
+    void reset();
+};
+
+// 给上层的快照（纯值，可跨线程拷贝）
+struct AXHistogramStats {
+    int64_t count{0};
+    int64_t mean{0};
+    int64_t p50{0};
+    int64_t p90{0};
+    int64_t p99{0};
+    int64_t max{0};
+};
+
+struct AXPlayerStats {
+    AXHistogramStats demuxReadUs;
+    AXHistogramStats videoDecodeUs;
+    AXHistogramStats audioDecodeUs;
+    AXHistogramStats presentLateUs;
+    AXHistogramStats presentEarlyUs;
+    AXHistogramStats uploadUs;
+    AXHistogramStats audioFifoUs;
+    AXHistogramStats seekFirstFrameUs;
+    AXHistogramStats firstFrameUs;
+
+    int64_t framesPresented{0};
+    int64_t framesDropped{0};
+    int64_t audioUnderruns{0};
+
+    int64_t audioFifoNowUs{0};
+    int64_t aPktPackets{0}, aPktBytes{0}, aPktDurUs{0};
+    int64_t vPktPackets{0}, vPktBytes{0}, vPktDurUs{0};
+    int64_t aFrames{0}, vFrames{0};
+
+    static AXPlayerStats from(const AXTelemetry &t);
+
+    // 展平为 int64 数组（JNI getStatistics 用；顺序与 AXPlayerStatistics.java 一致）：
+    // 9 个直方图 × {count, mean, p50, p90, p99, max}，随后是计数器与 gauge（按上面声明顺序）
+    static constexpr int kHistFields = 6;
+    static constexpr int kFlatSize = 9 * kHistFields + 3 + 9;
+
+    int flatten(int64_t *out, int n) const;
+};
+
+#endif //AXPLAYERLIB_AXTELEMETRY_H
@@ -0,0 +1,73 @@
+// AXPlayerLib/MediaCore/player/include/AXThumbnailer.h
+#ifndef AXPLAYERLIB_AXTHUMBNAILER_H
+#define AXPLAYERLIB_AXTHUMBNAILER_H
+
+#pragma once
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+// 一个视频关键帧：PTS（微秒，与 seekTo 同一时间轴）与在文件中的字节偏移（未知为 -1）
+struct AXKeyframe {
+    int64_t ptsUs{0};
+    int64_t pos{-1};
+};
+
+// 一张缩略图：RGBA8888，行紧密排列（stride = width * 4）
+struct AXThumbnail {
+    int64_t targetUs{0};   // 请求的位置
+    int64_t ptsUs{-1};     // 实际解出的帧（关键帧模式下为目标之前最近的关键帧）；-1 = 失败
+    int width{0};
+    int height{0};
+    std::vector<uint8_t> rgba;
+};
+
+/**
+ * 缩略图/关键帧索引（与播放无关，不占播放器线程）：
+ *   - buildIndex：容器自带索引（MP4 stss/MKV Cues 等）直接读出；没有时只读视频包扫一遍（不解码）；
+ *   - extract：在时长上均匀取 N 个位置，每个位置 seek 到之前的关键帧，只解这一帧
+ *     （skip_frame = NONKEY、skip_loop_filter = ALL，单帧冲刷出帧），缩放到限定尺寸后转 RGBA。
+ *     多个工作线程各开一份 AXDemuxer + 解码器，按位置顺序分段（段内 seek 单调向后，IO 更顺）。
+ * 缩放优先 libyuv（I420 盒式滤波 + 按帧色彩矩阵转 RGBA），其余像素格式走 swscale。
+ * 非线程安全：同一实例不要并发调用；extract 内部自己开线程。
+ */
+class AXThumbnailer {
+public:
+    struct Options {
+        int count{10};           // 缩略图张数（均匀分布，取每段中点）
+        int maxWidth{160};       // 按显示宽高比缩放后不超过此尺寸（偶数）
+        int maxHeight{90};
+        int workers{0};          // 解码线程数，0 = min(CPU 核数, 4)
+        bool exact{false};       // true：解到目标位置那一帧（正常解码，不跳滤波，慢；对照用）
+    };
+
+    AXThumbnailer(std::string url, std::map<std::string, std::string> headers = {});
+
+    // 探测一次：视频流、时长、显示尺寸；失败（无视频流等）返回 false
+    bool open();
+
+    int64_t durationUs() const { return durationUs_; }
+    int width() const { return width_; }
+    int height() const { return height_; }
+
+    // 关键帧索引（按 PTS 升序）；fromContainer 返回是否直接用了容器索引（否则为扫包得到）
+    bool buildIndex(std::vector<AXKeyframe>& out, bool* fromContainer = nullptr);
+
+    // 均匀取 opts.count 张缩略图，out 与位置一一对应（失败的那张 ptsUs = -1、rgba 为空）；
+    // 全部失败返回 false
+    bool extract(const Options& opts, std::vector<AXThumbnail>& out);
+
+private:
+    void fitSize_(int maxW, int maxH, int& w, int& h) const;
+
+    std::string url_;
+    std::map<std::string, std::string> headers_;
+    bool opened_{false};
+    int64_t durationUs_{0};
+    int width_{0}, height_{0};
+    int sarNum_{1}, sarDen_{1};
+    std::vector<AXKeyframe> index_;   // buildIndex 的结果，extract 用来合并落在同一关键帧上的位置
+};
+
+#endif //AXPLAYERLIB_AXTHUMBNAILER_H
@@ -0,0 +1,110 @@
+// AXPlayerLib/MediaCore/player/include/AXTrace.h
+#ifndef AXPLAYERLIB_AXTRACE_H
+#define AXPLAYERLIB_AXTRACE_H
+
+#pragma once
+#include <cstdint>
+#include <memory>
+
+struct AXTraceRing;
+
+/**
+ * 流水线事件追踪（Chrome trace / Perfetto JSON）。
+ * 编译开关 AX_ENABLE_TRACE（CMake: -DAX_TRACE=ON）；关闭时下面的宏展开为空，AXTrace 只剩返回 false 的空壳。
+ * 打开后：
+ *   - AX_TRACE_SCOPE("name") 在作用域进出各取一次单调时钟，写入本线程的无锁环形缓冲（名字须是字符串字面量）；
+ *     未处于录制状态时只多一次 relaxed load；
+ *   - 每线程一个环（单写者），写满后覆盖最旧的事件；线程退出后缓冲保留到下一次 start；
+ *     环在线程首次写事件时分配并登记（要加锁）。实时线程（音频回调）用 createRing 在非实时路径上预先建好，
+ *     回调里只 attachRing 一次，再用 AX_TRACE_SCOPE_RING 写进这个环，不分配、不加锁；
+ *   - dump() 在任意线程把各环里 start 之后的事件导出为 JSON（ph:"X" 完整事件 + 线程名元数据），
+ *     可直接拖进 chrome://tracing 或 ui.perfetto.dev。
+ */
+#ifndef AX_ENABLE_TRACE
+#define AX_ENABLE_TRACE 0
+#endif
+
+#if AX_ENABLE_TRACE
+#include <atomic>
+
+class AXTrace {
+public:
+    // 开始录制：丢弃之前的事件，回收已退出线程的缓冲
+    static void start();
+
+    static void stop();
+
+    static bool isRecording() { return recording_.load(std::memory_order_relaxed); }
+
+    // 导出为 Chrome trace JSON；可在录制中调用（得到当前为止的快照）
+    static bool dump(const char *path);
+
+    // 当前线程在 trace 里的名字（建议线程入口调用一次；截断到 31 字节）
+    static void setThreadName(const char *name);
+
+    static int64_t nowNs();
+
+    static void record(const char *name, int64_t beginNs, int64_t endNs);
+
+    // 预先分配并登记一个环（非实时线程调用；调用方持有，期间 start 不会回收它）
+    static std::shared_ptr<AXTraceRing> createRing(const char *name);
+
+    // 在真正写事件的线程上调用一次：记下线程 id（一次 gettid，不分配、不加锁）
+    static void attachRing(AXTraceRing *ring);
+
+    static void recordTo(AXTraceRing *ring, const char *name, int64_t beginNs, int64_t endNs);
+
+private:
+    static std::atomic<bool> recording_;
+};
+
+class AXTraceScope {
+public:
+    explicit AXTraceScope(const char *name)
+            : name_(name), ring_(nullptr), beginNs_(AXTrace::isRecording() ? AXTrace::nowNs() : -1) {}
+
+    AXTraceScope(const char *name, AXTraceRing *ring)
+            : name_(name), ring_(ring), beginNs_(ring && AXTrace::isRecording() ? AXTrace::nowNs() : -1) {}
+
+    ~AXTraceScope() {
+        if (beginNs_ < 0) return;
+        if (ring_) AXTrace::recordTo(ring_, name_, beginNs_, AXTrace::nowNs());
+        else AXTrace::record(name_, beginNs_, AXTrace::nowNs());
+    }
+
+    AXTraceScope(const AXTraceScope &) = delete;
+    AXTraceScope &operator=(const AXTraceScope &) = delete;
+
+private:
+    const char *name_;
+    AXTraceRing *ring_;
+    int64_t beginNs_;
+};
+
+#define AX_TRACE_CAT_(a, b) a##b
+#define AX_TRACE_CAT(a, b) AX_TRACE_CAT_(a, b)
+#define AX_TRACE_SCOPE(name) AXTraceScope AX_TRACE_CAT(axTraceScope_, __LINE__)(name)
+#define AX_TRACE_THREAD(name) AXTrace::setThreadName(name)
+// 写进预先建好的环（ring 为空时不记）
+#define AX_TRACE_SCOPE_RING(name, ring) AXTraceScope AX_TRACE_CAT(axTraceScope_, __LINE__)(name, ring)
+
+#else
+
+class AXTrace {
+public:
+    static void start() {}
+    static void stop() {}
+    static bool isRecording() { return false; }
+    static bool dump(const char *) { return false; }
+    static void setThreadName(const char *) {}
+    static std::shared_ptr<AXTraceRing> createRing(const char *) { return nullptr; }
+    static void attachRing(AXTraceRing *) {}
+};
+
+#define AX_TRACE_SCOPE(name) ((void) 0)
+#define AX_TRACE_THREAD(name) ((void) 0)
+#define AX_TRACE_SCOPE_RING(name, ring) ((void) 0)
+
+#endif
+
+#endif //AXPLAYERLIB_AXTRACE_H
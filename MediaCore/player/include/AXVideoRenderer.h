@@ -2,57 +2,59 @@
 #define AXPLAYERLIB_AXVIDEORENDERER_H
 
 #pragma once
-#include "AXQueues.h"
-#include <android/native_window.h>
+#include "AXVideoSink.h"
+#include "AXYuvFormat.h"
+#include "AXColorMatrix.h"
 #include <mutex>
+#include <vector>
 #include <EGL/egl.h>
 #include <GLES3/gl3.h>
 
 #include "AXLog.h"
 #define AX_LOG_TAG "AXVideoRenderer"
 
-extern "C" {
-#include <libavutil/avutil.h>
-#include <libavutil/rational.h>
-#include <libavutil/frame.h>
-}
-
-class AXVideoRenderer {
+// Android 视频输出：EGL + GLES3 把 YUV（420/422/444 平面、NV12/NV21、10 位 P010/YUV4xxP10）画到 ANativeWindow
+class AXVideoRenderer : public AXVideoSink {
 public:
     AXVideoRenderer();
-    ~AXVideoRenderer();
+    ~AXVideoRenderer() override;
+
+    const char* name() const override { return "gles"; }
 
-    // 以当前 Surface 初始化渲染（可重复调用以切换窗口）
-    bool init(ANativeWindow* win, int w, int h, int sarNum, int sarDen);
+    PixFmtCheck renderableCheck() const override { return &axYuvRenderable; }
 
-    // 帧时间基（来自视频解码器的 time_base，必须设置）
-    void setTimeBase(AVRational tb) { tb_ = tb; }
+    // 以当前 Surface 初始化渲染（可重复调用以切换窗口；任意线程）。
+    // 只登记窗口，EGL/GL 资源由渲染线程在 drawLoopOnce 中创建
+    bool init(ANativeWindow* win, int w, int h, int sarNum, int sarDen) override;
 
-    void setFrameQueue(FrameQueue* fq) { fQ_ = fq; }
+    // 渲染线程退出前调用：把 context 从本线程解绑，之后 release() 可在其它线程执行
+    void detachThread() override;
 
-    // 由 AXPlayer 周期调用。根据主时钟选择渲染/丢弃
-    void drawLoopOnce(int64_t masterPtsUs);
+    // 由 AXPlayer 调用（视频线程）
+    int64_t drawLoopOnce(int64_t masterPtsUs) override;
 
     // 释放所有 GLES/EGL 资源与窗口引用
-    void release();
+    void release() override;
 
 private:
+    struct YuvProgram;
+
     bool ensureEGL_();
+    void releaseCurrent_();
     void destroyEGL_();
     bool ensureGLObjects_();
     void destroyGLObjects_();
 
-    void drawFrame_(AVFrame* frm);
+    bool ensureProgram_(AXYuvKind kind);
+    bool ensureTextures_(const AVFrame* frm, const AXYuvFormat& yf);
+    void destroyUploadRing_();
+    void uploadPlanes_(const AVFrame* frm, const AXYuvFormat& yf);
+    void uploadPlanesDirect_(const AVFrame* frm, const AXYuvFormat& yf);
+    bool drawFrame_(AVFrame* frm);
+    void applyColorMatrix_(YuvProgram& prog, const AVFrame* frm, const AXYuvFormat& yf);
     void computeViewport_(int winW, int winH, int& vx, int& vy, int& vw, int& vh);
 
-    // 工具：把帧 pts(以 tb_) 转为 us；返回 <0 表示未知
-    static inline int64_t framePtsUs_(AVFrame* f, AVRational tb) {
-        if (!f || f->pts == AV_NOPTS_VALUE) return -1;
-        return av_rescale_q(f->pts, tb, AVRational{1,1000000});
-    }
-
 private:
-    FrameQueue*     fQ_{nullptr};
     ANativeWindow*  win_{nullptr};
     std::mutex      wMtx_;
     // EGL/GLES 资源
@@ -62,22 +64,44 @@ private:
     EGLConfig  config_{nullptr};
 
     int videoW_{0}, videoH_{0}, sarNum_{1}, sarDen_{1};
-    AVRational tb_{1,1000}; // 帧时间基，默认毫秒
 
-    // GL program & textures
-    GLuint prog_{0};
+    // 每种 YUV 布局一个 program，首次遇到该布局时编译
+    struct YuvProgram {
+        GLuint id{0};
+        GLint uSwapUV{-1};
+        GLint uScale{-1};
+        GLint uColorMat{-1};
+        GLint uColorOff{-1};
+        uint32_t colorKey{0};   // 已上传矩阵的 axColorMatrixKey，0 = 尚未上传
+    };
+    YuvProgram progs_[(int)AXYuvKind::Count];
+
+    // 平面纹理：交错布局只用 texY_/texU_（UV 在 texU_ 的 rg）
     GLuint texY_{0}, texU_{0}, texV_{0};
     GLuint vao_{0}, vbo_{0};
-
-    // attribute/uniform 位置
+    // 纹理为 glTexStorage2D 不可变存储，仅在帧尺寸或像素格式变化时重建
+    int texW_{0}, texH_{0}, texFmt_{-1};
+    int unsupportedFmt_{-1};   // 上次告警过的不支持格式，避免每帧刷日志
+    uint32_t colorKey_{0};     // 上次打日志的矩阵参数
+
+    // 上传环：每槽一个 PIXEL_UNPACK_BUFFER（Y|U|V 按解码器原始 linesize 依次存放）+ 上次使用它的 fence。
+    // 三槽轮转：CPU 填第 N 帧时，GPU 还可以在读第 N-1、N-2 帧的 PBO
+    static constexpr int kUploadSlots = 3;
+    struct UploadSlot {
+        GLuint pbo{0};
+        GLsync fence{nullptr};
+        GLsizeiptr bytes{0};   // 当前分配大小，按需增长
+    };
+    UploadSlot slots_[kUploadSlots];
+    int slotIdx_{0};
+    // 负 linesize（倒序行）无法用 GL_UNPACK_ROW_LENGTH 表达，直接上传时先重排到这里
+    std::vector<uint8_t> repack_;
+
+    // attribute 位置
     GLint aPosLoc_{-1}, aTexLoc_{-1};
-    GLint uTexY_{-1}, uTexU_{-1}, uTexV_{-1};
 
     // 记录上一次绘制的窗口尺寸，便于 viewport 计算
     int lastWinW_{0}, lastWinH_{0};
-
-    // 待渲染帧（节流：只保留一帧）
-    AVFrame* pending_{nullptr};
 };
 
 #endif //AXPLAYERLIB_AXVIDEORENDERER_H
\ No newline at end of file
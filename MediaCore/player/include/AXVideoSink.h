@@ -0,0 +1,136 @@
+// AXPlayerLib/MediaCore/player/include/AXVideoSink.h
+#ifndef AXPLAYERLIB_AXVIDEOSINK_H
+#define AXPLAYERLIB_AXVIDEOSINK_H
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include "AXPlatform.h"
+#include "AXQueues.h"
+#include "AXTelemetry.h"
+#include "AXFrameScheduler.h"
+
+extern "C" {
+#include <libavutil/avutil.h>
+#include <libavutil/rational.h>
+#include <libavutil/frame.h>
+}
+
+/**
+ * 视频输出抽象：由视频线程周期调用 drawLoopOnce，按主时钟从 FrameQueue 取帧呈现。
+ * 实现：AXVideoRenderer（Android，EGL/GLES）、AXFrameDumpSink（主机，逐帧哈希/落盘 YUV）。
+ * 选帧策略在基类 takeDueFrame_ 里（AXFrameScheduler：按预测的 vsync 对准 PTS，过期帧一次丢完），各实现共用；
+ * 有真实交换时刻的实现在每次呈现后调用 onPresented_ 喂给调度器。
+ */
+class AXVideoSink {
+public:
+    virtual ~AXVideoSink();
+
+    virtual const char *name() const = 0;
+
+    // 以当前 Surface 初始化（可重复调用以切换窗口；任意线程）。无窗口的实现忽略 win
+    virtual bool init(ANativeWindow *win, int w, int h, int sarNum, int sarDen) = 0;
+
+    // 是否要等 Surface 才能 init（离屏实现在 prepare 时直接 init）
+    virtual bool needsWindow() const { return true; }
+
+    // 本输出能直接呈现的像素格式判定；其余格式由视频解码线程先转成 I420。nullptr = 全部直通
+    using PixFmtCheck = bool (*)(int pixFmt);
+
+    virtual PixFmtCheck renderableCheck() const { return nullptr; }
+
+    // 帧时间基（来自视频解码器的 time_base，必须设置）
+    void setTimeBase(AVRational tb) { tb_ = tb; }
+
+    void setFrameQueue(FrameQueue *fq) { fQ_ = fq; }
+
+    // 遥测（可为空）：丢帧、呈现偏差、纹理上传耗时
+    void setTelemetry(AXTelemetry *t) { tel_ = t; }
+
+    // 播放倍速（任意线程）：调度窗口按媒体时间 = 墙钟 × 倍速缩放
+    void setSpeed(float speed) { speed_.store(speed > 0.f ? speed : 1.f, std::memory_order_relaxed); }
+
+    // seek 后调用（任意线程）：视频线程下次取帧前丢掉手上的旧帧，并断开帧间隔估计。
+    // seekReqUs >= 0（axStampNowUs 时刻）时，把此后首帧交出的耗时记入 seekFirstFrameUs；
+    // showFirst：此后第一帧不看主时钟直接呈现（拖动预览，暂停中也由视频线程呈现）
+    void flush(int64_t seekReqUs = -1, bool showFirst = false) {
+        seekReqUs_.store(seekReqUs, std::memory_order_relaxed);
+        previewReq_.store(showFirst, std::memory_order_relaxed);
+        flushReq_.store(true, std::memory_order_release);
+    }
+
+    // 起播海报（prepare 阶段、start 之前调用）：此后第一帧不看主时钟直接呈现（暂停中也由视频线程呈现，
+    // 没有 Surface 时等 Surface 到了再上屏），并把从 fromUs（axStampNowUs 时刻）到交出该帧的耗时记入 firstFrameUs
+    void showPoster(int64_t fromUs) {
+        ttffFromUs_.store(fromUs, std::memory_order_relaxed);
+        flush(-1, true);
+    }
+
+    // 还有一帧预览等着呈现（暂停中的视频线程据此决定是否调用 drawLoopOnce）
+    bool previewPending() const {
+        return previewReq_.load(std::memory_order_acquire) || previewArmed_.load(std::memory_order_acquire);
+    }
+
+    // 根据主时钟选择渲染/丢弃（不阻塞等帧）
+    // 返回：>=0 表示下一帧还需多少媒体时长（微秒）才到显示窗口；
+    //      kNoFrame 表示手上没有待显示帧（等帧队列就绪）
+    static constexpr int64_t kNoFrame = -1;
+
+    virtual int64_t drawLoopOnce(int64_t masterPtsUs) = 0;
+
+    // 视频线程退出前调用：解绑线程相关资源（如 EGL context）
+    virtual void detachThread() {}
+
+    // 释放所有资源与窗口引用
+    virtual void release() = 0;
+
+    int64_t framesPresented() const { return presented_.load(std::memory_order_relaxed); }
+
+    int64_t framesDropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+protected:
+    // 丢掉所有已过期的帧，返回此刻该显示的一帧（所有权交给调用方，用完 axFrameFree）；
+    // 返回 nullptr 时 waitUs 为下一帧还需等待的媒体时长，或 kNoFrame
+    AVFrame *takeDueFrame_(int64_t masterPtsUs, int64_t &waitUs);
+
+    void dropPending_();
+
+    // 非阻塞取一帧并登记给调度器
+    bool popFrame_(AVFrame *&out);
+
+    // 一次交换完成（单调时钟微秒）；只应在交换会按 vsync 节拍返回的实现里调用
+    void onPresented_(int64_t swapDoneUs) { sched_.onPresented(swapDoneUs); }
+
+    // 工具：把帧 pts(以 tb_) 转为 us；返回 <0 表示未知
+    static inline int64_t framePtsUs_(const AVFrame *f, AVRational tb) {
+        if (!f || f->pts == AV_NOPTS_VALUE) return -1;
+        return av_rescale_q(f->pts, tb, AVRational{1, 1000000});
+    }
+
+    FrameQueue *fQ_{nullptr};
+    AXTelemetry *tel_{nullptr};
+    AVRational tb_{1, 1000}; // 帧时间基，默认毫秒
+
+    // 待渲染帧与预取的下一帧（判断当前帧是否已被取代）
+    AVFrame *pending_{nullptr};
+    AVFrame *next_{nullptr};
+
+    AXFrameScheduler sched_;   // 仅视频线程
+    std::atomic<float> speed_{1.f};
+    std::atomic<bool> flushReq_{false};
+    std::atomic<int64_t> seekReqUs_{-1};
+    std::atomic<bool> previewReq_{false};     // 随 flush 提交
+    std::atomic<bool> previewArmed_{false};   // flush 已处理、预览帧尚未呈现（视频线程写）
+    int64_t firstFrameFromUs_{-1};   // 等待 seek 后首帧的起点（仅视频线程）
+    std::atomic<int64_t> ttffFromUs_{-1};   // 等待起播首帧的起点（showPoster 写，视频线程交出首帧时取走）
+
+    std::atomic<int64_t> presented_{0};
+    std::atomic<int64_t> dropped_{0};
+};
+
+using AXVideoSinkFactory = std::function<std::unique_ptr<AXVideoSink>()>;
+
+#endif //AXPLAYERLIB_AXVIDEOSINK_H
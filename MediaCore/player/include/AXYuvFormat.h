@@ -0,0 +1,100 @@
+// AXPlayerLib/MediaCore/player/include/AXYuvFormat.h
+#ifndef AXPLAYERLIB_AXYUVFORMAT_H
+#define AXPLAYERLIB_AXYUVFORMAT_H
+
+#pragma once
+#include <cstdint>
+
+extern "C" {
+#include <libavutil/pixfmt.h>
+}
+
+/**
+ * 渲染端可直接采样的 YUV 内存布局（不经 CPU 转换）。
+ * 按“平面数 × 采样位宽”分成 4 类着色器，色度下采样比例只影响纹理尺寸，不影响着色器。
+ */
+enum class AXYuvKind : int {
+    Planar8 = 0,   // Y/U/V 三平面，8 位（420P / 422P / 444P 及 J 变体）
+    Semi8,         // Y + 交错 UV，8 位（NV12 / NV21）
+    Planar16,      // Y/U/V 三平面，16 位容器（YUV4xxP10LE：低 10 位有效）
+    Semi16,        // Y + 交错 UV，16 位容器（P010LE：高 10 位有效）
+    Count
+};
+
+struct AXYuvFormat {
+    AXYuvKind kind{AXYuvKind::Planar8};
+    int planes{3};
+    int chromaShiftX{1};   // 色度宽 = ceil(w / 2^shift)
+    int chromaShiftY{1};
+    int bytesPerSample{1};
+    bool swapUV{false};    // NV21：交错平面是 VU 顺序
+    float sampleScale{1.f};   // 16 位整数样本 → [0,1] 的比例；8 位归一化纹理为 1
+    int bitDepth{8};          // 归一化后样本的有效位深（决定有限范围的零点/跨度）
+    bool jpegRange{false};    // YUVJ 格式：未标注 color_range 时按全范围
+
+    bool semiPlanar() const { return planes == 2; }
+
+    int planeWidth(int p, int w) const { return p == 0 ? w : -((-w) >> chromaShiftX); }
+
+    int planeHeight(int p, int h) const { return p == 0 ? h : -((-h) >> chromaShiftY); }
+
+    // 每个像素的分量数：交错色度平面为 2
+    int components(int p) const { return (semiPlanar() && p == 1) ? 2 : 1; }
+
+    int bytesPerPixel(int p) const { return components(p) * bytesPerSample; }
+};
+
+// 渲染器原生支持的像素格式；返回 false 表示需要先转换
+static inline bool axYuvFormatOf(int pixFmt, AXYuvFormat &out) {
+    AXYuvFormat f;
+    switch (pixFmt) {
+        case AV_PIX_FMT_YUV420P:
+        case AV_PIX_FMT_YUVJ420P:
+            f.jpegRange = pixFmt == AV_PIX_FMT_YUVJ420P;
+            break;
+        case AV_PIX_FMT_YUV422P:
+        case AV_PIX_FMT_YUVJ422P:
+            f.chromaShiftY = 0;
+            f.jpegRange = pixFmt == AV_PIX_FMT_YUVJ422P;
+            break;
+        case AV_PIX_FMT_YUV444P:
+        case AV_PIX_FMT_YUVJ444P:
+            f.chromaShiftX = f.chromaShiftY = 0;
+            f.jpegRange = pixFmt == AV_PIX_FMT_YUVJ444P;
+            break;
+        case AV_PIX_FMT_NV12:
+        case AV_PIX_FMT_NV21:
+            f.kind = AXYuvKind::Semi8;
+            f.planes = 2;
+            f.swapUV = pixFmt == AV_PIX_FMT_NV21;
+            break;
+        case AV_PIX_FMT_YUV420P10LE:
+        case AV_PIX_FMT_YUV422P10LE:
+        case AV_PIX_FMT_YUV444P10LE:
+            f.kind = AXYuvKind::Planar16;
+            f.bytesPerSample = 2;
+            f.sampleScale = 1.f / 1023.f;
+            f.bitDepth = 10;
+            if (pixFmt == AV_PIX_FMT_YUV422P10LE) f.chromaShiftY = 0;
+            if (pixFmt == AV_PIX_FMT_YUV444P10LE) f.chromaShiftX = f.chromaShiftY = 0;
+            break;
+        case AV_PIX_FMT_P010LE:
+            f.kind = AXYuvKind::Semi16;
+            f.planes = 2;
+            f.bytesPerSample = 2;
+            f.sampleScale = 1.f / (1023.f * 64.f);   // 10 位样本左移 6 位存放
+            f.bitDepth = 10;
+            break;
+        default:
+            return false;
+    }
+    out = f;
+    return true;
+}
+
+static inline bool axYuvRenderable(int pixFmt) {
+    AXYuvFormat f;
+    return axYuvFormatOf(pixFmt, f);
+}
+
+#endif //AXPLAYERLIB_AXYUVFORMAT_H
@@ -14,6 +14,7 @@ extern "C" {
 }
 
 #include "AXPlayer.h" // C++内核头（相对路径按仓库结构）
+#include "AXTrace.h"
 
 // ================= 日志 =================
 #define LOG_TAG "AXMediaPlayerJNI"
@@ -46,9 +47,10 @@ extern "C" {
 #define JSIG_nativePrepareAsync          "(J)V"
 #define JSIG_nativeStart                 "(J)V"
 #define JSIG_nativePause                 "(J)V"
-#define JSIG_nativeSeekTo                "(JJ)V"
+#define JSIG_nativeSeekTo                "(JJI)V"
 #define JSIG_nativeIsPlaying             "(J)Z"
 #define JSIG_nativeSetSpeed              "(JF)V"
+#define JSIG_nativeSetOpenOptions        "(JJJZLjava/lang/String;)V"
 #define JSIG_nativeGetCurrentPosition    "(J)J"
 #define JSIG_nativeGetDuration           "(J)J"
 #define JSIG_nativeSetVolume             "(JFF)V"
@@ -58,6 +60,9 @@ extern "C" {
 #define JSIG_nativeGetVideoSarDen        "(J)I"
 #define JSIG_nativeGetAudioSessionId     "(J)I"
 #define JSIG_nativeSetSurface            "(JLandroid/view/Surface;)V"
+#define JSIG_nativeGetStatistics         "(J)[J"
+#define JSIG_nativeTraceStart            "()Z"
+#define JSIG_nativeTraceStop             "(Ljava/lang/String;)Z"
 #define JSIG_nativeRelease               "(J)V"
 
 // ================= VM/引用缓存 =================
@@ -356,10 +361,27 @@ static void nativePause(JNIEnv*, jclass, jlong ctx) {
     h->player->pause();
 }
 
-static void nativeSeekTo(JNIEnv*, jclass, jlong ctx, jlong msec) {
+// mode 与 IAXPlayer.SEEK_* 对应：0..3 即 android.media.MediaPlayer 的取值，SEEK_SCRUB 为本库扩展
+static constexpr jint kSeekScrub = 0x100;
+
+static AXPlayer::SeekMode seekModeOf(jint mode) {
+    switch (mode) {
+        case 0:  // SEEK_PREVIOUS_SYNC
+        case 1:  // SEEK_NEXT_SYNC：按前一关键帧处理
+            return AXPlayer::SeekMode::Fast;
+        case 2:  // SEEK_CLOSEST_SYNC：最近的关键帧，之后正常播放
+            return AXPlayer::SeekMode::NearestKey;
+        case kSeekScrub:  // 拖动预览
+            return AXPlayer::SeekMode::Scrub;
+        default: // SEEK_CLOSEST
+            return AXPlayer::SeekMode::Accurate;
+    }
+}
+
+static void nativeSeekTo(JNIEnv*, jclass, jlong ctx, jlong msec, jint mode) {
     NativeHolder* h = reinterpret_cast<NativeHolder*>(ctx);
     if (!h) return;
-    h->player->seekTo((int64_t)msec);
+    h->player->seekTo((int64_t)msec, seekModeOf(mode));
 }
 
 static jboolean nativeIsPlaying(JNIEnv*, jclass, jlong ctx) {
@@ -374,6 +396,24 @@ static void nativeSetSpeed(JNIEnv*, jclass, jlong ctx, jfloat speed) {
     h->player->setSpeed((float)speed);
 }
 
+static void nativeSetOpenOptions(JNIEnv* env, jclass, jlong ctx, jlong probeSize,
+                                 jlong analyzeDurationMs, jboolean fastOpen, jstring jcacheDir) {
+    NativeHolder* h = reinterpret_cast<NativeHolder*>(ctx);
+    if (!h) return;
+    AXOpenOptions o;
+    o.probeSize = (int64_t)probeSize;
+    o.analyzeDurationUs = (int64_t)analyzeDurationMs * 1000;
+    o.fastOpen = fastOpen == JNI_TRUE;
+    if (jcacheDir) {
+        const char* dir = env->GetStringUTFChars(jcacheDir, nullptr);
+        if (dir) {
+            o.cacheDir = dir;
+            env->ReleaseStringUTFChars(jcacheDir, dir);
+        }
+    }
+    h->player->setOpenOptions(o);
+}
+
 static jlong nativeGetCurrentPosition(JNIEnv*, jclass, jlong ctx) {
     NativeHolder* h = reinterpret_cast<NativeHolder*>(ctx);
     if (!h) return 0;
@@ -422,6 +462,35 @@ static jint nativeGetAudioSessionId(JNIEnv*, jclass, jlong ctx) {
     return (jint)h->player->getAudioSessionId();
 }
 
+// 展平的遥测快照，字段顺序见 AXPlayerStats::flatten / AXPlayerStatistics.java
+static jlongArray nativeGetStatistics(JNIEnv* env, jclass, jlong ctx) {
+    NativeHolder* h = reinterpret_cast<NativeHolder*>(ctx);
+    if (!h || !h->player) return nullptr;
+    int64_t buf[AXPlayerStats::kFlatSize];
+    const int n = h->player->getStatistics().flatten(buf, AXPlayerStats::kFlatSize);
+    jlongArray arr = env->NewLongArray(n);
+    if (!arr) return nullptr;
+    env->SetLongArrayRegion(arr, 0, n, reinterpret_cast<const jlong*>(buf));
+    return arr;
+}
+
+// 进程级事件追踪（AX_TRACE=ON 编译时有效；否则返回 false）
+static jboolean nativeTraceStart(JNIEnv*, jclass) {
+    if (!AX_ENABLE_TRACE) return JNI_FALSE;
+    AXTrace::start();
+    return JNI_TRUE;
+}
+
+static jboolean nativeTraceStop(JNIEnv* env, jclass, jstring jpath) {
+    AXTrace::stop();
+    if (!jpath) return JNI_FALSE;
+    const char* path = env->GetStringUTFChars(jpath, nullptr);
+    if (!path) return JNI_FALSE;
+    const bool ok = AXTrace::dump(path);
+    env->ReleaseStringUTFChars(jpath, path);
+    return ok ? JNI_TRUE : JNI_FALSE;
+}
+
 static void nativeSetSurface(JNIEnv* env, jclass, jlong ctx, jobject surface) {
     NativeHolder* h = reinterpret_cast<NativeHolder*>(ctx);
     if (!h) return;
@@ -469,6 +538,7 @@ static JNINativeMethod g_methods[] = {
         {"nativeSeekTo",             JSIG_nativeSeekTo,             (void*)nativeSeekTo},
         {"nativeIsPlaying",          JSIG_nativeIsPlaying,          (void*)nativeIsPlaying},
         {"nativeSetSpeed",           JSIG_nativeSetSpeed,           (void*)nativeSetSpeed},
+        {"nativeSetOpenOptions",     JSIG_nativeSetOpenOptions,     (void*)nativeSetOpenOptions},
         {"nativeGetCurrentPosition", JSIG_nativeGetCurrentPosition, (void*)nativeGetCurrentPosition},
         {"nativeGetDuration",        JSIG_nativeGetDuration,        (void*)nativeGetDuration},
         {"nativeSetVolume",          JSIG_nativeSetVolume,          (void*)nativeSetVolume},
@@ -478,6 +548,9 @@ static JNINativeMethod g_methods[] = {
         {"nativeGetVideoSarDen",     JSIG_nativeGetVideoSarDen,     (void*)nativeGetVideoSarDen},
         {"nativeGetAudioSessionId",  JSIG_nativeGetAudioSessionId,  (void*)nativeGetAudioSessionId},
         {"nativeSetSurface",         JSIG_nativeSetSurface,         (void*)nativeSetSurface},
+        {"nativeGetStatistics",      JSIG_nativeGetStatistics,      (void*)nativeGetStatistics},
+        {"nativeTraceStart",         JSIG_nativeTraceStart,         (void*)nativeTraceStart},
+        {"nativeTraceStop",          JSIG_nativeTraceStop,          (void*)nativeTraceStop},
         {"nativeRelease",            JSIG_nativeRelease,            (void*)nativeRelease},
 };
 
@@ -150,7 +150,12 @@ public class AXMediaPlayer implements IAXPlayer, SurfaceHolder.Callback {
 
     @Override
     public void seekTo(long msec) {
-        nativeSeekTo(mNativeCtx, msec);
+        seekTo(msec, SEEK_CLOSEST);
+    }
+
+    @Override
+    public void seekTo(long msec, int mode) {
+        nativeSeekTo(mNativeCtx, msec, mode);
     }
 
     @Override
@@ -158,6 +163,19 @@ public class AXMediaPlayer implements IAXPlayer, SurfaceHolder.Callback {
         nativeSetSpeed(mNativeCtx, speed);
     }
 
+    /**
+     * 启动参数，须在 prepare() 之前调用。
+     *
+     * @param probeSizeBytes    探测最多读多少字节，<=0 用 FFmpeg 默认（5MB）
+     * @param analyzeDurationMs 探测最多分析多长媒体时间，<=0 用 FFmpeg 默认（5s）
+     * @param fastOpen          MP4/MKV 等容器头已给全编解码参数时跳过探测
+     * @param cacheDir          探测结果缓存目录（如 context.getCacheDir() 下的子目录，须已存在），null 不缓存；
+     *                          同一文件再次打开时直接回填，不再探测
+     */
+    public void setOpenOptions(long probeSizeBytes, long analyzeDurationMs, boolean fastOpen, String cacheDir) {
+        nativeSetOpenOptions(mNativeCtx, probeSizeBytes, analyzeDurationMs, fastOpen, cacheDir);
+    }
+
     @Override
     public long getCurrentPosition() {
         return nativeGetCurrentPosition(mNativeCtx);
@@ -188,6 +206,25 @@ public class AXMediaPlayer implements IAXPlayer, SurfaceHolder.Callback {
         return nativeGetAudioSessionId(mNativeCtx);
     }
 
+    @Override
+    public AXPlayerStatistics getStatistics() {
+        return new AXPlayerStatistics(nativeGetStatistics(mNativeCtx));
+    }
+
+    /**
+     * 开始录制进程内所有播放器的流水线事件（需 native 以 -DAX_TRACE=ON 编译，否则返回 false）。
+     */
+    public static boolean startTracing() {
+        return nativeTraceStart();
+    }
+
+    /**
+     * 停止录制并把事件写成 Chrome trace JSON（可在 ui.perfetto.dev / chrome://tracing 打开）。
+     */
+    public static boolean stopTracing(String path) {
+        return nativeTraceStop(path);
+    }
+
     // ======= Listeners setters =======
     @Override
     public void setOnPreparedListener(OnPreparedListener l) {
@@ -287,12 +324,15 @@ public class AXMediaPlayer implements IAXPlayer, SurfaceHolder.Callback {
 
     private static native void nativePause(long ctx);
 
-    private static native void nativeSeekTo(long ctx, long msec);
+    private static native void nativeSeekTo(long ctx, long msec, int mode);
 
     private static native boolean nativeIsPlaying(long ctx);
 
     private static native void nativeSetSpeed(long ctx, float speed);
 
+    private static native void nativeSetOpenOptions(long ctx, long probeSize, long analyzeDurationMs,
+                                                    boolean fastOpen, String cacheDir);
+
     private static native long nativeGetCurrentPosition(long ctx);
 
     private static native long nativeGetDuration(long ctx);
@@ -311,5 +351,11 @@ public class AXMediaPlayer implements IAXPlayer, SurfaceHolder.Callback {
 
     private static native void nativeSetSurface(long ctx, Surface surface);
 
+    private static native long[] nativeGetStatistics(long ctx);
+
+    private static native boolean nativeTraceStart();
+
+    private static native boolean nativeTraceStop(String path);
+
     private static native void nativeRelease(long ctx);
 }
\ No newline at end of file
@@ -0,0 +1,116 @@
+// 文件路径：app/src/main/java/com/axplayer/devlib/AXPlayerStatistics.java
+package com.axplayer.devlib;
+
+/**
+ * 播放流水线分段遥测快照（native AXPlayerStats::flatten 的 Java 视图）。
+ * 时间单位均为微秒；直方图统计为对数分桶近似值（误差 < 25%）。
+ */
+public final class AXPlayerStatistics {
+
+    /** 单个直方图的摘要 */
+    public static final class Histogram {
+        public final long count;
+        public final long mean;
+        public final long p50;
+        public final long p90;
+        public final long p99;
+        public final long max;
+
+        Histogram(long[] v, int off) {
+            count = v[off];
+            mean = v[off + 1];
+            p50 = v[off + 2];
+            p90 = v[off + 3];
+            p99 = v[off + 4];
+            max = v[off + 5];
+        }
+
+        @Override
+        public String toString() {
+            return "n=" + count + " mean=" + mean + " p50=" + p50 + " p90=" + p90 + " p99=" + p99 + " max=" + max;
+        }
+    }
+
+    // 与 native 展平顺序保持一致
+    private static final int HIST_FIELDS = 6;
+    private static final int HIST_COUNT = 9;
+    private static final int SCALAR_BASE = HIST_COUNT * HIST_FIELDS;
+    static final int FLAT_SIZE = SCALAR_BASE + 12;
+
+    public final Histogram demuxReadUs;
+    public final Histogram videoDecodeUs;
+    public final Histogram audioDecodeUs;
+    public final Histogram presentLateUs;
+    public final Histogram presentEarlyUs;
+    public final Histogram uploadUs;
+    public final Histogram audioFifoUs;
+    /** 播放中 seek 请求到 seek 后首帧交给视频输出的耗时 */
+    public final Histogram seekFirstFrameUs;
+    /** prepareAsync 到首帧（起播海报）交给视频输出的耗时，每次 prepare 一个样本 */
+    public final Histogram firstFrameUs;
+
+    public final long framesPresented;
+    public final long framesDropped;
+    public final long audioUnderruns;
+
+    public final long audioFifoNowUs;
+    public final long audioPacketQueuePackets;
+    public final long audioPacketQueueBytes;
+    public final long audioPacketQueueDurationUs;
+    public final long videoPacketQueuePackets;
+    public final long videoPacketQueueBytes;
+    public final long videoPacketQueueDurationUs;
+    public final long audioFrameQueueFrames;
+    public final long videoFrameQueueFrames;
+
+    AXPlayerStatistics(long[] flat) {
+        // native 未就绪（已 release 等）时返回全 0
+        long[] v = (flat != null && flat.length >= FLAT_SIZE) ? flat : new long[FLAT_SIZE];
+        demuxReadUs = new Histogram(v, 0);
+        videoDecodeUs = new Histogram(v, HIST_FIELDS);
+        audioDecodeUs = new Histogram(v, 2 * HIST_FIELDS);
+        presentLateUs = new Histogram(v, 3 * HIST_FIELDS);
+        presentEarlyUs = new Histogram(v, 4 * HIST_FIELDS);
+        uploadUs = new Histogram(v, 5 * HIST_FIELDS);
+        audioFifoUs = new Histogram(v, 6 * HIST_FIELDS);
+        seekFirstFrameUs = new Histogram(v, 7 * HIST_FIELDS);
+        firstFrameUs = new Histogram(v, 8 * HIST_FIELDS);
+
+        int i = SCALAR_BASE;
+        framesPresented = v[i++];
+        framesDropped = v[i++];
+        audioUnderruns = v[i++];
+        audioFifoNowUs = v[i++];
+        audioPacketQueuePackets = v[i++];
+        audioPacketQueueBytes = v[i++];
+        audioPacketQueueDurationUs = v[i++];
+        videoPacketQueuePackets = v[i++];
+        videoPacketQueueBytes = v[i++];
+        videoPacketQueueDurationUs = v[i++];
+        audioFrameQueueFrames = v[i++];
+        videoFrameQueueFrames = v[i];
+    }
+
+    @Override
+    public String toString() {
+        return "AXPlayerStatistics{"
+                + "demuxRead[" + demuxReadUs + "]"
+                + " videoDecode[" + videoDecodeUs + "]"
+                + " audioDecode[" + audioDecodeUs + "]"
+                + " presentLate[" + presentLateUs + "]"
+                + " presentEarly[" + presentEarlyUs + "]"
+                + " upload[" + uploadUs + "]"
+                + " audioFifo[" + audioFifoUs + "]"
+                + " seekFirstFrame[" + seekFirstFrameUs + "]"
+                + " firstFrame[" + firstFrameUs + "]"
+                + " presented=" + framesPresented
+                + " dropped=" + framesDropped
+                + " underruns=" + audioUnderruns
+                + " fifoNowUs=" + audioFifoNowUs
+                + " aPkt=" + audioPacketQueuePackets + "/" + audioPacketQueueBytes + "B/" + audioPacketQueueDurationUs + "us"
+                + " vPkt=" + videoPacketQueuePackets + "/" + videoPacketQueueBytes + "B/" + videoPacketQueueDurationUs + "us"
+                + " aFrm=" + audioFrameQueueFrames
+                + " vFrm=" + videoFrameQueueFrames
+                + "}";
+    }
+}
@@ -20,7 +20,19 @@ public interface IAXPlayer {
     int getVideoHeight();
     boolean isPlaying();
 
+    //seek方式（取值与 android.media.MediaPlayer 一致）：前一关键帧，快但首帧早于目标
+    int SEEK_PREVIOUS_SYNC = 0;
+    //seek方式：前后最近的关键帧，之后正常播放
+    int SEEK_CLOSEST_SYNC = 2;
+    //seek方式：从关键帧解码并丢弃目标前的帧，首帧即目标位置（默认）
+    int SEEK_CLOSEST = 3;
+    //seek方式（本库扩展，不在 MediaPlayer 取值范围内）：拖动预览，只解码离目标最近的关键帧并立即显示（暂停中也显示），声音静音；
+    //松手后再用 SEEK_CLOSEST 定位一次；拖动中直接 play() 也会在当前位置精确定位后恢复
+    int SEEK_SCRUB = 0x100;
+
+    //seek为异步：连续调用时只执行最后一次
     void seekTo(long msec);
+    void seekTo(long msec, int mode);
     void setSpeed(float speed);
 
     long getCurrentPosition();
@@ -34,6 +46,9 @@ public interface IAXPlayer {
 
     int getAudioSessionId();
 
+    //流水线分段遥测快照（解封装/解码/呈现/上传耗时分布、丢帧、欠载、队列深度）
+    AXPlayerStatistics getStatistics();
+
     //准备完毕,回调接口仅用于java层
     void setOnPreparedListener(OnPreparedListener listener);
     //播放结束,回调接口仅用于java层